@@ -55,6 +55,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
@@ -2375,7 +2376,6 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 {
 	object	*danger_weapon_objp;
 	ai_info	*aip;
-	ship_obj	*so;
 
 	// initialize eno struct
 	eval_nearest_objnum eno;
@@ -2390,12 +2390,16 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	eno.nearest_objnum = -1;
 	eno.check_danger_weapon_objnum = 0;
 
-	// go through the list of all ships and evaluate as potential targets
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		if (Objects[so->objnum].flags[Object::Object_Flags::Should_be_dead])
+	// go through the ships that can be in range and evaluate them as potential targets
+	// (fighters and bombers count at half their distance, so they can be twice as far away)
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::SHIPS, &Objects[objnum].pos, range * 2.0f, enemy_team_mask, candidates);
+
+	for (int candidate : candidates) {
+		if (Objects[candidate].flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
-		eno.trial_objp = &Objects[so->objnum];
+		eno.trial_objp = &Objects[candidate];
 		evaluate_object_as_nearest_objnum(&eno);
 	}
 
@@ -2444,15 +2448,17 @@ int find_nearby_threat(int objnum, int enemy_team_mask, float range, int *count)
 	int		nearest_objnum;
 	float		nearest_dist;
 	object	*objp;
-	ship_obj	*so;
 
 	nearest_objnum = -1;
 	nearest_dist = range;
 
 	*count = 0;
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		objp = &Objects[so->objnum];
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::SHIPS, &Objects[objnum].pos, range, enemy_team_mask, candidates);
+
+	for (int candidate : candidates) {
+		objp = &Objects[candidate];
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -2528,6 +2534,88 @@ int get_enemy_timestamp()
 	return (NUM_SKILL_LEVELS - Game_skill_level) * Random::next(500, 999);
 }
 
+// By ai_index, only ever valid for the frame they were thought in
+static SCP_vector<nearest_enemy_thought> Nearest_enemy_thoughts;
+
+/**
+ * Returns true if the enemy search of find_enemy() is likely to run for the ship this frame, the way ai_frame() calls it.
+ */
+bool ai_enemy_search_due(object *objp)
+{
+	auto shipp = &Ships[objp->instance];
+
+	if (shipp->ai_index < 0)
+		return false;
+
+	auto sip = &Ship_info[shipp->ship_info_index];
+	if (sip->class_type < 0 || !(Ship_types[sip->class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks]))
+		return false;
+
+	return timestamp_elapsed(Ai_info[shipp->ai_index].choose_enemy_timestamp) != 0;
+}
+
+/**
+ * Looks for the nearest enemy of the ship like ai_frame() does through find_enemy().  Doesn't change anything but
+ * its argument, so it is safe to call for several ships at once.
+ */
+void ai_think_nearest_enemy(object *objp, nearest_enemy_thought *thought)
+{
+	auto aip = &Ai_info[Ships[objp->instance].ai_index];
+
+	thought->ship_signature = objp->signature;
+	thought->enemy_team_mask = iff_get_attackee_mask(obj_team(objp));
+	thought->enemy_wing = aip->enemy_wing;
+	thought->range = MAX_ENEMY_DISTANCE;
+	thought->max_attackers = The_mission.ai_profile->max_attackers[Game_skill_level];
+
+	thought->nearest_objnum = get_nearest_objnum(OBJ_INDEX(objp), thought->enemy_team_mask, thought->enemy_wing, thought->range, thought->max_attackers, -1, -1);
+	thought->nearest_signature = (thought->nearest_objnum >= 0) ? Objects[thought->nearest_objnum].signature : -1;
+}
+
+/**
+ * Makes find_enemy() go with what ai_think_nearest_enemy() found for the rest of this frame.
+ */
+void ai_commit_nearest_enemy(object *objp, const nearest_enemy_thought *thought)
+{
+	auto ai_index = Ships[objp->instance].ai_index;
+
+	if (ai_index >= static_cast<int>(Nearest_enemy_thoughts.size()))
+		Nearest_enemy_thoughts.resize(ai_index + 1);
+
+	Nearest_enemy_thoughts[ai_index] = *thought;
+	Nearest_enemy_thoughts[ai_index].framecount = Framecount;
+}
+
+/**
+ * If the think phase already looked for the enemy get_nearest_objnum() is asked for, puts it in *nearest_objnum.
+ * Thoughts whose enemy has gone since are not used.
+ */
+static bool ai_thought_nearest_enemy(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int *nearest_objnum)
+{
+	auto ai_index = Ships[Objects[objnum].instance].ai_index;
+
+	if (ai_index >= static_cast<int>(Nearest_enemy_thoughts.size()))
+		return false;
+
+	auto thought = &Nearest_enemy_thoughts[ai_index];
+
+	if (thought->framecount != Framecount || thought->ship_signature != Objects[objnum].signature)
+		return false;
+
+	if (thought->enemy_team_mask != enemy_team_mask || thought->enemy_wing != enemy_wing || thought->range != range || thought->max_attackers != max_attackers)
+		return false;
+
+	if (thought->nearest_objnum >= 0) {
+		auto enemy_objp = &Objects[thought->nearest_objnum];
+
+		if (enemy_objp->signature != thought->nearest_signature || enemy_objp->flags[Object::Object_Flags::Should_be_dead])
+			return false;
+	}
+
+	*nearest_objnum = thought->nearest_objnum;
+	return true;
+}
+
 /**
  * Return objnum if enemy found, else return -1;
  *
@@ -2575,6 +2663,10 @@ int find_enemy(int objnum, float range, int max_attackers, int ship_info_index,
 			}
 		}
 
+		int nearest_objnum;
+		if (ship_info_index < 0 && class_type < 0 && ai_thought_nearest_enemy(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, &nearest_objnum))
+			return nearest_objnum;
+
 		return get_nearest_objnum(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, ship_info_index, class_type);
 	} else {
 		aip->target_objnum = -1;
@@ -4523,11 +4615,13 @@ void update_min_max(float val, float *min, float *max)
 int get_enemy_team_range(object *my_objp, float range, int enemy_team_mask, vec3d *min_vec, vec3d *max_vec)
 {
 	object	*objp;
-	ship_obj	*so;
 	int		count = 0;
 
-    for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
-        objp = &Objects[so->objnum];
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::SHIPS, &my_objp->pos, range, enemy_team_mask, candidates);
+
+    for (int candidate : candidates) {
+        objp = &Objects[candidate];
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -6444,13 +6538,15 @@ int ai_fire_primary_weapon(object *objp)
 // exit:		number of ships within threshold units of pos
 int num_nearby_fighters(int enemy_team_mask, const vec3d *pos, float threshold)
 {
-	ship_obj	*so;
 	object	*ship_objp;
 	int		count = 0;
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::SHIPS, pos, threshold, enemy_team_mask, candidates);
 
-		ship_objp = &Objects[so->objnum];
+	for (int candidate : candidates) {
+
+		ship_objp = &Objects[candidate];
 		if (ship_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -10599,15 +10695,19 @@ static object *ai_find_nearby_mine_threat(object *from_objp, object *against_obj
 // Returns 1 if a threat was found and targeted, otherwise 0.
 int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 {
-	missile_obj	*mo;
 	object		*bomb_objp, *closest_bomb_objp=NULL;
 	float			dist, dist_to_guarding_obj,closest_dist_to_guarding_obj=999999.0f;
 	weapon		*wp;
 	weapon_info	*wip;
 
-	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
-		bomb_objp = &Objects[mo->objnum];
+	float threshold = ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3);
+
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::MISSILES, &guarded_objp->pos, threshold, OBJ_GRID_ALL_TEAMS, candidates);
+
+	for (int candidate : candidates) {
+		Assert(candidate >= 0 && candidate < MAX_OBJECTS);
+		bomb_objp = &Objects[candidate];
 		if (bomb_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -10628,7 +10728,7 @@ int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 
 		dist = vm_vec_dist_quick(&bomb_objp->pos, &guarded_objp->pos);
 
-		if (dist < ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3)) {
+		if (dist < threshold) {
 			dist_to_guarding_obj = vm_vec_dist_quick(&bomb_objp->pos, &guarding_objp->pos);
 			if ( dist_to_guarding_obj < closest_dist_to_guarding_obj ) {
 				closest_dist_to_guarding_obj = dist_to_guarding_obj;
@@ -10659,13 +10759,18 @@ void ai_guard_find_nearby_ship(object *guarding_objp, object *guarded_objp)
 {
 	ship *guarding_shipp = &Ships[guarding_objp->instance];
 	ai_info	*guarding_aip = &Ai_info[guarding_shipp->ai_index];
-	ship_obj *so;
 	object *enemy_objp;
 	float dist;
 
-	for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so))
+	float near_threshold = ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3);
+	float far_threshold = ai_guard_threshold(guarded_objp, 3000.0f);
+
+	thread_local SCP_vector<int> candidates;
+	obj_grid_query(obj_grid_type::SHIPS, &guarded_objp->pos, MAX(near_threshold, far_threshold), iff_get_attackee_mask(guarding_shipp->team), candidates);
+
+	for (int candidate : candidates)
 	{
-		enemy_objp = &Objects[so->objnum];
+		enemy_objp = &Objects[candidate];
 		if (enemy_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 		if (enemy_objp->instance < 0)
@@ -10679,10 +10784,10 @@ void ai_guard_find_nearby_ship(object *guarding_objp, object *guarded_objp)
 			if (Ship_info[eshipp->ship_info_index].class_type >= 0 && (Ship_types[Ship_info[eshipp->ship_info_index].class_type].flags[Ship::Type_Info_Flags::AI_guards_attack]))
 			{
 				dist = vm_vec_dist_quick(&enemy_objp->pos, &guarded_objp->pos);
-				if (dist < ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3))
+				if (dist < near_threshold)
 				{
 					guard_object_was_hit(guarding_objp, enemy_objp);
-				} else if ((dist < ai_guard_threshold(guarded_objp, 3000.0f)) &&
+				} else if ((dist < far_threshold) &&
 						   (Ai_info[eshipp->ai_index].target_objnum == guarding_aip->guard_objnum))
 				{
 					guard_object_was_hit(guarding_objp, enemy_objp);
@@ -1283,14 +1283,14 @@ void ai_add_goal_sub_sexp( int sexp, ai_goal_type type, ai_info *aip, ai_goal *a
 	}
 
 	if ( priority_is_nan || priority_is_nan_forever ) {
-		Warning(LOCATION, "add-goal tried to add %s with a NaN priority; aborting...", Sexp_nodes[CAR(sexp)].text);
+		Warning(LOCATION, "add-goal tried to add %s with a NaN priority; aborting...", Sexp_node_data[CAR(sexp)].text);
 		ai_goal_reset(aigp);
 		return;
 	} else if ( aigp->priority > MAX_GOAL_PRIORITY ) {
-		nprintf (("AI", "bashing add-goal sexpression priority of goal %s from %d to %d.\n", Sexp_nodes[CAR(sexp)].text, aigp->priority, MAX_GOAL_PRIORITY));
+		nprintf (("AI", "bashing add-goal sexpression priority of goal %s from %d to %d.\n", Sexp_node_data[CAR(sexp)].text, aigp->priority, MAX_GOAL_PRIORITY));
 		aigp->priority = MAX_GOAL_PRIORITY;
 	} else if ( aigp->priority < MIN_GOAL_PRIORITY ) {
-		nprintf (("AI", "bashing add-goal sexpression priority of goal %s from %d to %d.\n", Sexp_nodes[CAR(sexp)].text, aigp->priority, MIN_GOAL_PRIORITY));
+		nprintf (("AI", "bashing add-goal sexpression priority of goal %s from %d to %d.\n", Sexp_node_data[CAR(sexp)].text, aigp->priority, MIN_GOAL_PRIORITY));
 		aigp->priority = MIN_GOAL_PRIORITY;
 	}
 
@@ -1396,17 +1396,17 @@ int ai_remove_goal_sexp_sub( int sexp, ai_goal* aigp, bool &remove_more )
 
 		if (_priority_is_nan || _priority_is_nan_forever)
 		{
-			Warning(LOCATION, "remove-goal tried to remove %s with a NaN priority; the priority will not be used for goal comparison", Sexp_nodes[CAR(sexp)].text);
+			Warning(LOCATION, "remove-goal tried to remove %s with a NaN priority; the priority will not be used for goal comparison", Sexp_node_data[CAR(sexp)].text);
 			_priority = -1;
 		}
 		else if (_priority > MAX_GOAL_PRIORITY)
 		{
-			nprintf(("AI", "bashing remove-goal sexpression priority of goal %s from %d to %d.\n", Sexp_nodes[CAR(sexp)].text, _priority, MAX_GOAL_PRIORITY));
+			nprintf(("AI", "bashing remove-goal sexpression priority of goal %s from %d to %d.\n", Sexp_node_data[CAR(sexp)].text, _priority, MAX_GOAL_PRIORITY));
 			_priority = MAX_GOAL_PRIORITY;
 		}
 		else if (_priority < MIN_GOAL_PRIORITY)
 		{
-			nprintf(("AI", "bashing remove-goal sexpression priority of goal %s from %d to %d.\n", Sexp_nodes[CAR(sexp)].text, _priority, MIN_GOAL_PRIORITY));
+			nprintf(("AI", "bashing remove-goal sexpression priority of goal %s from %d to %d.\n", Sexp_node_data[CAR(sexp)].text, _priority, MIN_GOAL_PRIORITY));
 			_priority = MIN_GOAL_PRIORITY;
 		}
 
@@ -1554,7 +1554,7 @@ int ai_remove_goal_sexp_sub( int sexp, ai_goal* aigp, bool &remove_more )
 			priority = eval_priority_et_seq(localnode);
 		}
 		else {
-			UNREACHABLE("Invalid SEXP-OP %s (number %d) for an AI goal!", Sexp_nodes[node].text, op);
+			UNREACHABLE("Invalid SEXP-OP %s (number %d) for an AI goal!", Sexp_node_data[node].text, op);
 		}
 		break;
 	};
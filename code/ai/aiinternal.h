@@ -34,4 +34,49 @@ bool check_los(int objnum, int target_objnum, float threshold, int primary_bank,
 //Does all the stuff needed to aim and fire a turret.
 void ai_turret_execute_behavior(const ship *shipp, ship_subsys *ss);
 
+// An object the turrets of a ship may target, with the checks that don't depend on the turret already done
+typedef struct turret_candidate {
+	int		objnum;
+	int		signature;
+	bool	targetable;		// object_is_targetable() from the turret's ship (ships only)
+	bool	stealth;		// is_object_stealth_ship() (ships only)
+} turret_candidate;
+
+//If cleared, every turret goes through the object lists on its own
+extern bool Turret_candidate_cache_enabled;
+
+//Returns true if any turret of the ship is going to look for a new target this frame.
+bool turret_targeting_due(object *parent_objp);
+
+//Gathers the objects the turrets of a ship may target, in obj_used_list order.  Only reads the game state, so it
+//may run on any thread.  The time taken in microseconds is added to *time.
+void turret_gather_candidates(object *parent_objp, SCP_vector<turret_candidate> &candidates, std::uint64_t *time);
+
+//Hands gathered candidates to the turrets of the ship for the rest of this frame.  Swaps them in, so candidates
+//comes back with the storage of the previous frame.  Main thread only.
+void turret_commit_candidates(object *parent_objp, SCP_vector<turret_candidate> &candidates, std::uint64_t time);
+
+// The nearest enemy the think phase found for a ship, along with what it looked for
+typedef struct nearest_enemy_thought {
+	int		framecount = -1;
+	int		ship_signature = -1;
+	int		enemy_team_mask = 0;
+	int		enemy_wing = -1;
+	float	range = 0.0f;
+	int		max_attackers = 0;
+	int		nearest_objnum = -1;
+	int		nearest_signature = -1;
+} nearest_enemy_thought;
+
+//Returns true if find_enemy() is likely to look for a new enemy for the ship this frame.
+bool ai_enemy_search_due(object *objp);
+
+//Looks for the nearest enemy of the ship the way find_enemy() does.  Only reads the game state, so it may run on
+//any thread.
+void ai_think_nearest_enemy(object *objp, nearest_enemy_thought *thought);
+
+//Makes find_enemy() use the enemy found by ai_think_nearest_enemy() for the rest of this frame, unless it has gone
+//since.  Main thread only.
+void ai_commit_nearest_enemy(object *objp, const nearest_enemy_thought *thought);
+
 #endif
@@ -0,0 +1,102 @@
+#include "ai/aithink.h"
+
+#include "ai/aiinternal.h"
+#include "debugconsole/console.h"
+#include "globalincs/linklist.h"
+#include "network/multi.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+#include "ship/awacs.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+
+bool Ai_threaded_think = true;
+DCF_BOOL(ai_threaded_think, Ai_threaded_think)
+
+MONITOR(NumAIThinks)
+
+namespace
+{
+
+struct ai_think_result {
+	int objnum;
+
+	bool gather_turret_candidates;
+	SCP_vector<turret_candidate> turret_candidates;
+	std::uint64_t turret_time;
+
+	bool find_nearest_enemy;
+	nearest_enemy_thought nearest_enemy;
+};
+
+// Kept between frames so the candidate lists keep their storage
+SCP_vector<ai_think_result> Ai_think_results;
+
+}
+
+void ai_think_all()
+{
+	// only the host runs the AI
+	if (MULTIPLAYER_CLIENT)
+		return;
+
+	// Targetability checks update the AWACS levels themselves if they are due right away, which must not happen on a
+	// worker, and so must building the ship grid the enemy search queries
+	awacs_process();
+	obj_grid_build(obj_grid_type::SHIPS);
+
+	// which ships think is decided up front, in list order, so the commits happen in list order as well
+	size_t count = 0;
+
+	for (auto so : list_range(&Ship_obj_list)) {
+		auto objp = &Objects[so->objnum];
+
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		bool gather_turret_candidates = Turret_candidate_cache_enabled && turret_targeting_due(objp);
+		bool find_nearest_enemy = ship_will_evaluate_ai(objp) && ai_enemy_search_due(objp);
+
+		if (!gather_turret_candidates && !find_nearest_enemy)
+			continue;
+
+		if (count == Ai_think_results.size())
+			Ai_think_results.emplace_back();
+
+		auto& result = Ai_think_results[count++];
+		result.objnum = so->objnum;
+		result.gather_turret_candidates = gather_turret_candidates;
+		result.find_nearest_enemy = find_nearest_enemy;
+	}
+
+	MONITOR_INC(NumAIThinks, static_cast<int>(count));
+
+	// the rest of the AI, including picking targets, firing and goals, runs from ship_process_pre() or
+	// ship_process_post() on the main thread, where it takes up what was thought here
+	ai_think_commit(count,
+		[](size_t i) {
+			auto& result = Ai_think_results[i];
+			auto objp = &Objects[result.objnum];
+
+			if (result.gather_turret_candidates) {
+				result.turret_time = 0;
+				turret_gather_candidates(objp, result.turret_candidates, &result.turret_time);
+			}
+
+			if (result.find_nearest_enemy) {
+				ai_think_nearest_enemy(objp, &result.nearest_enemy);
+			}
+		},
+		[](size_t i) {
+			auto& result = Ai_think_results[i];
+			auto objp = &Objects[result.objnum];
+
+			if (result.gather_turret_candidates) {
+				turret_commit_candidates(objp, result.turret_candidates, result.turret_time);
+			}
+
+			if (result.find_nearest_enemy) {
+				ai_commit_nearest_enemy(objp, &result.nearest_enemy);
+			}
+		});
+}
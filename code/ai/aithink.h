@@ -0,0 +1,45 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+#include "utils/threading.h"
+
+// The AI of a frame is split in two.  In the think phase each ship works out what it wants to do, reading nothing but
+// the world as it was at the start of the phase and writing nothing but its own result slot, so any number of ships
+// can think at once on the worker threads.  In the commit phase the results are applied one ship after the other on
+// the main thread, always in the same order, so that a frame plays out the same no matter how many threads did the
+// thinking.  That is what keeps missions deterministic and multiplayer hosts in sync with their clients.
+
+// If cleared, the think phase runs on the main thread only
+extern bool Ai_threaded_think;
+
+// How many ships a worker thinks for before it looks for more work
+const size_t AI_THINK_CHUNK_SIZE = 4;
+
+// Calls think(i) for every i in [0, count), possibly on several threads at once, then commit(i) in order on the
+// calling thread once all of the thinking is done.
+template <typename Think, typename Commit>
+void ai_think_commit(size_t count, Think&& think, Commit&& commit)
+{
+	if (count == 0)
+		return;
+
+	TRACE_SCOPE(tracing::AIThink);
+
+	if (Ai_threaded_think) {
+		threading::parallel_for(count, AI_THINK_CHUNK_SIZE, [&think](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				think(i);
+		}, &tracing::AIThinkJob);
+	} else {
+		for (size_t i = 0; i < count; i++)
+			think(i);
+	}
+
+	for (size_t i = 0; i < count; i++)
+		commit(i);
+}
+
+// Runs the think phase of every ship's AI and commits the results.  Called at the start of obj_move_all(), before
+// any object has moved, so that the snapshot the ships think about is the same for all of them.
+void ai_think_all();
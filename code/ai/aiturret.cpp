@@ -99,6 +99,27 @@ typedef struct eval_enemy_obj_struct {
 	int			nearest_objnum = -1;
 }	eval_enemy_obj_struct;
 
+// The candidates are gathered once per frame for every ship, and then shared by all of its turrets
+typedef struct turret_candidate_cache {
+	int		parent_signature = -1;
+	int		enemy_team_mask = 0;
+	int		framecount = -1;
+
+	SCP_vector<turret_candidate> candidates;		// in obj_used_list order
+
+	// for the turret_targeting debug command
+	int				num_builds = 0;
+	int				num_searches = 0;
+	std::uint64_t	build_time = 0;					// microseconds
+	std::uint64_t	search_time = 0;				// microseconds, including the builds
+} turret_candidate_cache;
+
+static turret_candidate_cache Turret_candidate_caches[MAX_SHIPS];
+
+// If cleared, every turret goes through the object lists on its own, as it used to
+bool Turret_candidate_cache_enabled = true;
+DCF_BOOL(turret_candidate_cache, Turret_candidate_cache_enabled)
+
 // the current world orientation of the turret matrix, corresponding to its fvec and uvec defined in the model
 // is NOT affected by the turret's current aiming
 void turret_instance_find_world_orient(matrix* out_mat, int model_instance_num, int submodel_num, const matrix* objorient)
@@ -491,8 +512,187 @@ int valid_turret_enemy(object *objp, object *turret_parent)
 	return 0;
 }
 
+/**
+ * Returns the candidate cache of a ship, cleared out if it last belonged to another ship.
+ */
+static turret_candidate_cache *turret_get_candidate_cache(const object *parent_objp)
+{
+	auto cache = &Turret_candidate_caches[parent_objp->instance];
+
+	if (cache->parent_signature != parent_objp->signature) {
+		*cache = turret_candidate_cache();
+		cache->parent_signature = parent_objp->signature;
+	}
+
+	return cache;
+}
+
+bool turret_should_pick_new_target(ship_subsys *turret);
+
+/**
+ * Returns true if any turret of the ship is going to look for a new target this frame.
+ */
+bool turret_targeting_due(object *parent_objp)
+{
+	auto parent_shipp = &Ships[parent_objp->instance];
+
+	for (auto ss = GET_FIRST(&parent_shipp->subsys_list); ss != END_OF_LIST(&parent_shipp->subsys_list); ss = GET_NEXT(ss)) {
+		if (ss->system_info->type != SUBSYSTEM_TURRET)
+			continue;
+
+		if (turret_should_pick_new_target(ss) && !ss->scripting_target_override && !(ss->flags[Ship::Subsystem_Flags::Forced_target]))
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * Gathers the objects the turrets of a ship may target.  Ships that no turret of the ship can reach are left out.
+ * Doesn't change anything but its arguments, so it is safe to call for several ships at once.
+ */
+void turret_gather_candidates(object *parent_objp, SCP_vector<turret_candidate> &candidates, std::uint64_t *time)
+{
+	auto parent_shipp = &Ships[parent_objp->instance];
+	int enemy_team_mask = iff_get_attackee_mask(obj_team(parent_objp));
+
+	auto start_time = timer_get_microseconds();
+
+	candidates.clear();
+
+	// no turret reaches further than its longest weapon, plus however far it is from the center of the ship
+	float max_range = 0.0f;
+	for (auto ss = GET_FIRST(&parent_shipp->subsys_list); ss != END_OF_LIST(&parent_shipp->subsys_list); ss = GET_NEXT(ss)) {
+		if (ss->system_info->type == SUBSYSTEM_TURRET) {
+			max_range = MAX(max_range, longest_turret_weapon_range(&ss->weapons));
+		}
+	}
+	max_range += parent_objp->radius;
+
+	for (auto objp : list_range(&obj_used_list)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		if (!valid_turret_enemy(objp, parent_objp))
+			continue;
+
+		turret_candidate candidate;
+		candidate.objnum = OBJ_INDEX(objp);
+		candidate.signature = objp->signature;
+		candidate.targetable = true;
+		candidate.stealth = false;
+
+		if (objp->type == OBJ_SHIP) {
+			if (!iff_matches_mask(Ships[objp->instance].team, enemy_team_mask))
+				continue;
+
+			if (vm_vec_dist(&objp->pos, &parent_objp->pos) - objp->radius > max_range)
+				continue;
+
+			candidate.targetable = object_is_targetable(objp, parent_shipp) != 0;
+			candidate.stealth = is_object_stealth_ship(objp) != 0;
+		}
+
+		candidates.push_back(candidate);
+	}
+
+	*time += timer_get_microseconds() - start_time;
+}
+
+/**
+ * Makes the candidates the ones the turrets of the ship choose from for the rest of this frame.
+ */
+void turret_commit_candidates(object *parent_objp, SCP_vector<turret_candidate> &candidates, std::uint64_t time)
+{
+	auto cache = turret_get_candidate_cache(parent_objp);
+
+	cache->framecount = Framecount;
+	cache->enemy_team_mask = iff_get_attackee_mask(obj_team(parent_objp));
+	cache->candidates.swap(candidates);
+
+	cache->num_builds++;
+	cache->build_time += time;
+}
+
+/**
+ * Returns the objects the turrets of a ship may target this frame, gathering them if that hasn't happened yet.
+ */
+static const turret_candidate_cache *turret_get_candidates(int turret_parent_objnum, int enemy_team_mask)
+{
+	object *parent_objp = &Objects[turret_parent_objnum];
+	auto cache = turret_get_candidate_cache(parent_objp);
+
+	if ((cache->framecount == Framecount) && (cache->enemy_team_mask == enemy_team_mask)) {
+		return cache;
+	}
+
+	// find_turret_enemy() always asks for the enemies of the ship's team, which is what gets gathered
+	Assertion(enemy_team_mask == iff_get_attackee_mask(obj_team(parent_objp)), "Turret candidates gathered for the wrong teams!");
+
+	std::uint64_t time = 0;
+	turret_gather_candidates(parent_objp, cache->candidates, &time);
+
+	cache->framecount = Framecount;
+	cache->enemy_team_mask = enemy_team_mask;
+	cache->num_builds++;
+	cache->build_time += time;
+
+	return cache;
+}
+
+DCF(turret_targeting, "Shows how much time the turrets of each ship spend looking for targets")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: turret_targeting [reset]\n");
+		dc_printf("\tShows how often and how long the turrets of each ship looked for targets, and how much of that\n");
+		dc_printf("\twas spent gathering the candidates the turrets of a ship share (see turret_candidate_cache).\n");
+		dc_printf("\treset  Clears the counters.\n");
+		return;
+	}
+
+	if (dc_optional_string("reset")) {
+		for (auto &cache : Turret_candidate_caches) {
+			cache.num_builds = cache.num_searches = 0;
+			cache.build_time = cache.search_time = 0;
+		}
+
+		dc_printf("Turret targeting counters cleared\n");
+		return;
+	}
+
+	dc_printf("%-32s %9s %7s %12s %12s %10s\n", "Ship", "Searches", "Builds", "Search (ms)", "Build (ms)", "Targets");
+
+	for (auto so : list_range(&Ship_obj_list)) {
+		auto objp = &Objects[so->objnum];
+		auto cache = turret_get_candidate_cache(objp);
+
+		if (cache->num_searches == 0)
+			continue;
+
+		dc_printf("%-32s %9d %7d %12.3f %12.3f %10d\n", Ships[objp->instance].ship_name, cache->num_searches, cache->num_builds,
+			cache->search_time / 1000.0, cache->build_time / 1000.0, static_cast<int>(cache->candidates.size()));
+	}
+}
+
+/**
+ * Looks up the candidate object of a cached list, or returns nullptr if it has gone since the list was made.
+ */
+static object *turret_candidate_object(const turret_candidate &candidate)
+{
+	object *objp = &Objects[candidate.objnum];
+
+	if ((objp->signature != candidate.signature) || objp->flags[Object::Object_Flags::Should_be_dead])
+		return nullptr;
+
+	return objp;
+}
+
 extern int Player_attacking_enabled;
-void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
+
+/**
+ * @param candidate	If the object came from turret_get_candidates(), the checks it has already been through
+ */
+void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo, const turret_candidate *candidate = nullptr)
 {
 	object	*turret_parent_obj = &Objects[eeo->turret_parent_objnum];
 	ship *shipp;
@@ -505,7 +705,7 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 		return;
 	}
 
-	if ( !valid_turret_enemy(objp, turret_parent_obj) ) {
+	if ( (candidate == nullptr) && !valid_turret_enemy(objp, turret_parent_obj) ) {
 		return;
 	}
 
@@ -520,7 +720,7 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 		ship_info* sip = &Ship_info[shipp->ship_info_index];
 
 		// check on enemy team
-		if ( !iff_matches_mask(shipp->team, eeo->enemy_team_mask) ) {
+		if ( (candidate == nullptr) && !iff_matches_mask(shipp->team, eeo->enemy_team_mask) ) {
 			return;
 		}
 
@@ -587,10 +787,12 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 		}
 
 		// check if valid target in nebula
-		if ( !object_is_targetable(objp, &Ships[Objects[eeo->turret_parent_objnum].instance]) ) {
+		bool targetable = (candidate != nullptr) ? candidate->targetable : (object_is_targetable(objp, &Ships[Objects[eeo->turret_parent_objnum].instance]) != 0);
+		if ( !targetable ) {
 			// BYPASS ocassionally for stealth
 			int try_anyway = FALSE;
-			if ( is_object_stealth_ship(objp) ) {
+			bool stealth = (candidate != nullptr) ? candidate->stealth : (is_object_stealth_ship(objp) != 0);
+			if ( stealth ) {
 				float turret_stealth_find_chance = 0.5f;
 				float speed_mod = -0.1f + vm_vec_mag_quick(&objp->phys_info.vel) / 70.0f;
 				if (frand() > (turret_stealth_find_chance + speed_mod)) {
@@ -822,6 +1024,9 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 	eeo.tvec = tvec;
 	eeo.turret_subsys = turret_subsys;
 
+	// the targets all turrets of this ship have to choose from
+	const turret_candidate_cache *cache = Turret_candidate_cache_enabled ? turret_get_candidates(turret_parent_objnum, enemy_team_mask) : nullptr;
+
 	// here goes the new targeting priority setting
 	int n_tgt_priorities;
 	int priority_weapon_idx = -1;
@@ -856,12 +1061,8 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 			int n_s_classes = (int)tt->ship_class.size();
 			int n_w_classes = (int)tt->weapon_class.size();
 			
-			bool found_something;
-			for (auto ptr: list_range(&obj_used_list)) {
-				if (ptr->flags[Object::Object_Flags::Should_be_dead])
-					continue;
-
-				found_something = false;
+			auto check_priority = [&](object *ptr, const turret_candidate *candidate) {
+				bool found_something = false;
 
 				if(tt->obj_type > -1 && (ptr->type == tt->obj_type)) {
 					found_something = true;
@@ -911,10 +1112,25 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 				if(!(found_something)) {
 					//we didnt find this object within this priority group
 					//skip to next without evaluating the object as target
-					continue;
+					return;
+				}
+
+				evaluate_obj_as_target(ptr, &eeo, candidate);
+			};
+
+			if (cache != nullptr) {
+				for (auto &candidate : cache->candidates) {
+					auto ptr = turret_candidate_object(candidate);
+					if (ptr != nullptr)
+						check_priority(ptr, &candidate);
 				}
+			} else {
+				for (auto ptr: list_range(&obj_used_list)) {
+					if (ptr->flags[Object::Object_Flags::Should_be_dead])
+						continue;
 
-				evaluate_obj_as_target(ptr, &eeo);
+					check_priority(ptr, nullptr);
+				}
 			}
 
 			//homing weapon entry...
@@ -983,16 +1199,29 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 					//don't fire anti capital ship turrets at bombs.
 					if ( !((aip->ai_profile_flags[AI::Profile_Flags::Huge_turret_weapons_ignore_bombs]) && big_only_flag) )
 					{
-						// Missile_obj_list
-						for( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-							auto objp = &Objects[mo->objnum];
-							if (objp->flags[Object::Object_Flags::Should_be_dead])
-								continue;
-
+						auto check_bomb = [&](object *objp, const turret_candidate *candidate) {
 							Assert(objp->type == OBJ_WEAPON);
 							if ((Weapon_info[Weapons[objp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Bomb]) || (Weapon_info[Weapons[objp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Turret_Interceptable]))
 							{
-								evaluate_obj_as_target(objp, &eeo);
+								evaluate_obj_as_target(objp, &eeo, candidate);
+							}
+						};
+
+						if (cache != nullptr) {
+							// the missiles of Missile_obj_list
+							for (auto &candidate : cache->candidates) {
+								auto objp = turret_candidate_object(candidate);
+								if ((objp != nullptr) && (objp->type == OBJ_WEAPON) && (Weapons[objp->instance].missile_list_index >= 0))
+									check_bomb(objp, &candidate);
+							}
+						} else {
+							// Missile_obj_list
+							for( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
+								auto objp = &Objects[mo->objnum];
+								if (objp->flags[Object::Object_Flags::Should_be_dead])
+									continue;
+
+								check_bomb(objp, nullptr);
 							}
 						}
 						// highest priority
@@ -1006,12 +1235,20 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 
 				case 1:
 					//Return if a ship is found
-					// Ship_used_list
-					for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-						auto objp = &Objects[so->objnum];
-						if (objp->flags[Object::Object_Flags::Should_be_dead])
-							continue;
-						evaluate_obj_as_target(objp, &eeo);
+					if (cache != nullptr) {
+						for (auto &candidate : cache->candidates) {
+							auto objp = turret_candidate_object(candidate);
+							if ((objp != nullptr) && (objp->type == OBJ_SHIP))
+								evaluate_obj_as_target(objp, &eeo, &candidate);
+						}
+					} else {
+						// Ship_used_list
+						for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+							auto objp = &Objects[so->objnum];
+							if (objp->flags[Object::Object_Flags::Should_be_dead])
+								continue;
+							evaluate_obj_as_target(objp, &eeo);
+						}
 					}
 
 					// next highest priority is attacking ship
@@ -1036,12 +1273,20 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 					// - AAA beams
                     
 					if ( !all_turret_weapons_have_flags(swp, tmp_flagset) ) {
-						// Asteroid_obj_list
-						for ( ao = GET_FIRST(&Asteroid_obj_list); ao != END_OF_LIST(&Asteroid_obj_list); ao = GET_NEXT(ao) ) {
-							auto objp = &Objects[ao->objnum];
-							if (objp->flags[Object::Object_Flags::Should_be_dead])
-								continue;
-							evaluate_obj_as_target(objp, &eeo);
+						if (cache != nullptr) {
+							for (auto &candidate : cache->candidates) {
+								auto objp = turret_candidate_object(candidate);
+								if ((objp != nullptr) && (objp->type == OBJ_ASTEROID))
+									evaluate_obj_as_target(objp, &eeo, &candidate);
+							}
+						} else {
+							// Asteroid_obj_list
+							for ( ao = GET_FIRST(&Asteroid_obj_list); ao != END_OF_LIST(&Asteroid_obj_list); ao = GET_NEXT(ao) ) {
+								auto objp = &Objects[ao->objnum];
+								if (objp->flags[Object::Object_Flags::Should_be_dead])
+									continue;
+								evaluate_obj_as_target(objp, &eeo);
+							}
 						}
 
 						if (eeo.nearest_objnum != -1) {
@@ -1154,7 +1399,14 @@ int find_turret_enemy(const ship_subsys *turret_subsys, int objnum, const vec3d
 		}
 	}
 
+	auto search_start = timer_get_microseconds();
+
 	enemy_objnum = get_nearest_turret_objnum(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, big_only_flag, small_only_flag, tagged_only_flag, beam_flag, flak_flag, laser_flag, missile_flag);
+
+	auto cache = turret_get_candidate_cache(&Objects[objnum]);
+	cache->num_searches++;
+	cache->search_time += timer_get_microseconds() - search_start;
+
 	if ( enemy_objnum >= 0 ) {
 		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Beam_protected]) && beam_flag) );
 		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Flak_protected]) && flak_flag) );
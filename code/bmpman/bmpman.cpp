@@ -17,6 +17,7 @@
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
 #include "bmpman/bm_internal.h"
+#include "cmdline/cmdline.h"
 #include "ddsutils/ddsutils.h"
 #include "debugconsole/console.h"
 #include "globalincs/systemvars.h"
@@ -34,11 +35,17 @@
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 #include "ktxutils/ktxutils.h"
+#include "utils/threading.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <climits>
+#include <condition_variable>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 // --------------------------------------------------------------------------------------------------------------------
 // Private macros.
@@ -51,6 +58,8 @@
 // Monitor variables
 MONITOR(NumBitmapPage)
 MONITOR(SizeBitmapPage)
+MONITOR(NumBitmapStreamsPending)
+MONITOR(NumBitmapStreamsCompleted)
 
 // --------------------------------------------------------------------------------------------------------------------
 // Definition of public variables (declared as extern in bmpman.h).
@@ -84,6 +93,21 @@ static bool bm_inited = false;
 static uint Bm_next_signature = 0x1234;
 static int Bm_low_mem = 0;
 
+/**
+ * The handles of all used slots by filename, without the extension and in lower case, so that finding an already
+ * loaded bitmap doesn't have to look at every slot.
+ *
+ * @details The handles of a name are kept sorted, so the first one passing the checks of bm_load_sub_fast() is the
+ * one a walk over the slots would have found. Released slots are taken out again, and since the lookup checks every
+ * candidate against its slot anyway an entry that went out of date some other way can't do any harm.
+ */
+static SCP_unordered_map<SCP_string, SCP_vector<int>> Bm_name_index;
+static int Bm_name_index_hits = 0;
+static int Bm_name_index_misses = 0;
+
+// How many images bm_page_in_stop() reads before uploading them, which bounds the memory of images waiting for upload
+static const size_t BM_PAGE_IN_BATCH_SIZE = 64;
+
 struct bm_lookup_cache_entry {
 	ubyte* data;
 	int width;
@@ -116,6 +140,47 @@ static bool bm_is_anim(bitmap_entry* entry)
 		(entry->type == BM_TYPE_PNG && entry->info.ani.apng.is_apng));
 }
 
+static SCP_string bm_name_index_key(const char* filename)
+{
+	// same part of the name strextcmp() compares
+	auto ext = strrchr(filename, '.');
+	SCP_string key(filename, (ext != nullptr) ? static_cast<size_t>(ext - filename) : strlen(filename));
+	SCP_tolower(key);
+
+	return key;
+}
+
+/**
+ * Adds a slot to the filename index, once its filename and handle are set
+ */
+static void bm_name_index_add(const bitmap_entry* entry)
+{
+	auto& handles = Bm_name_index[bm_name_index_key(entry->filename)];
+
+	auto it = std::lower_bound(handles.begin(), handles.end(), entry->handle);
+	if (it == handles.end() || *it != entry->handle)
+		handles.insert(it, entry->handle);
+}
+
+/**
+ * Takes a slot out of the filename index, before its filename or handle are changed
+ */
+static void bm_name_index_remove(const bitmap_entry* entry)
+{
+	auto index_it = Bm_name_index.find(bm_name_index_key(entry->filename));
+	if (index_it == Bm_name_index.end())
+		return;
+
+	auto& handles = index_it->second;
+
+	auto it = std::lower_bound(handles.begin(), handles.end(), entry->handle);
+	if (it != handles.end() && *it == entry->handle)
+		handles.erase(it);
+
+	if (handles.empty())
+		Bm_name_index.erase(index_it);
+}
+
 bitmap_slot* bm_get_slot(int handle, bool separate_ani_frames) {
 	Assertion(handle >= 0, "Invalid handle %d passed to bm_get_slot!", handle);
 
@@ -251,6 +316,84 @@ static int bm_load_sub_slow(const char *real_filename, const int num_ext, const
  */
 static int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type = CF_TYPE_ANY, bool animated_type = false);
 
+/**
+ * @brief An image file being read into the data of its slot
+ *
+ * @details Reading is split in three so that bm_page_in_stop() can read many images at once. bm_read_image_begin() and
+ * bm_read_image_end() do the bookkeeping and have to run on the main thread, bm_read_image() does the actual reading
+ * and touches nothing but the file and the data, so it can run on any thread.
+ */
+struct bm_image_read {
+	int handle = -1;
+	BM_TYPE type = BM_TYPE_NONE;			//!< of the file, which for EFF frames isn't the type of the slot
+	char filename[MAX_FILENAME_LEN];
+	int dir_type = CF_TYPE_ANY;
+	ubyte* data = nullptr;
+	int bpp = 0;
+	int error = 0;
+	image_read_messages messages;			//!< what the reader had to say, which only bm_read_image_end() reports
+};
+
+/**
+ * Whether the image of a slot can be read through bm_read_image()
+ */
+static bool bm_can_read_image(bitmap_entry* be);
+
+/**
+ * Frees the current data of a slot and allocates the data the image will be read into
+ *
+ * @returns false if the data couldn't be allocated, in which case there is nothing to read
+ */
+static bool bm_read_image_begin(int handle, bitmap_slot* bs, bm_image_read& read);
+
+/**
+ * Reads the image file into the data allocated by bm_read_image_begin()
+ */
+static void bm_read_image(bm_image_read& read);
+
+/**
+ * Hands the data that was read over to the slot, or frees it if the file couldn't be read, and reports what went wrong
+ */
+static void bm_read_image_end(bm_image_read& read);
+
+/**
+ * @brief An image being read by the streaming thread for bm_stream_texture()
+ *
+ * @details The main thread owns the jobs and hands them to the streaming thread through Bm_stream_queue. Until a job
+ * is done the streaming thread writes to its data, so the slot must not be touched before bm_stream_cancel() waited
+ * for it.
+ */
+struct bm_stream_job {
+	bm_image_read read;
+	std::atomic<bool> done{ false };
+};
+
+static std::thread Bm_stream_thread;
+static std::mutex Bm_stream_mutex;
+static std::condition_variable Bm_stream_cond;
+static SCP_deque<bm_stream_job*> Bm_stream_queue;	// guarded by Bm_stream_mutex
+static bool Bm_stream_quit = false;					// guarded by Bm_stream_mutex
+
+// The jobs of all slots waiting for their image, by handle. Only ever used by the main thread.
+static SCP_unordered_map<int, std::unique_ptr<bm_stream_job>> Bm_stream_jobs;
+static int Bm_streams_completed = 0;
+
+/**
+ * Waits for the image a slot is streaming, if any, and hands the data over to the slot so it can be freed like any
+ * other data. Images the streaming thread didn't get to yet aren't read at all.
+ */
+static void bm_stream_cancel(int handle);
+
+/**
+ * Finishes all streaming jobs and stops the streaming thread
+ */
+static void bm_stream_close();
+
+/**
+ * Reads the images of the jobs in Bm_stream_queue until bm_stream_close() tells it to stop
+ */
+static void bm_stream_thread_main();
+
 /**
  * @brief Finds a start handle to a block of contiguous bitmap slots
  *
@@ -474,6 +617,10 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 
 	if (dc_optional_string_either("status", "--status") || dc_optional_string_either("?", "--?")) {
 		dc_printf("Total RAM usage: " SIZE_T_ARG " bytes\n", bm_texture_ram);
+		dc_printf("Already loaded lookups: %d found, %d not found\n", Bm_name_index_hits, Bm_name_index_misses);
+		if (Cmdline_stream_textures) {
+			dc_printf("Streamed images: " SIZE_T_ARG " pending, %d completed\n", Bm_stream_jobs.size(), Bm_streams_completed);
+		}
 
 		if (Bm_max_ram > 1024 * 1024) {
 			dc_printf("\tMax RAM allowed: %.1f MB\n", i2fl(Bm_max_ram) / (1024.0f*1024.0f));
@@ -525,8 +672,34 @@ DCF(bmpslots, "Writes bitmap slot info to fs2_open.log") {
 
 // --------------------------------------------------------------------------------------------------------------------
 // Definition of all functions, in alphabetical order
+bool bm_can_read_image(bitmap_entry* be) {
+	// animations read all of their frames at once
+	if (bm_is_anim(be))
+		return false;
+
+	switch (be->type) {
+	case BM_TYPE_PNG:
+	case BM_TYPE_JPG:
+	case BM_TYPE_DDS:
+	case BM_TYPE_DXT1:
+	case BM_TYPE_DXT3:
+	case BM_TYPE_DXT5:
+	case BM_TYPE_BC7:
+	case BM_TYPE_CUBEMAP_DDS:
+	case BM_TYPE_CUBEMAP_DXT1:
+	case BM_TYPE_CUBEMAP_DXT3:
+	case BM_TYPE_CUBEMAP_DXT5:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
 void bm_close() {
 	if (bm_inited) {
+		bm_stream_close();
+
 		for (auto& block : bm_blocks) {
 			for (auto& slot : block) {
 				bm_free_data(&slot);            // clears flags, bbp, data, etc
@@ -539,6 +712,7 @@ void bm_close() {
 			}
 		}
 		bm_blocks.clear();
+		Bm_name_index.clear();
 		bm_inited = false;
 	}
 }
@@ -590,6 +764,8 @@ int bm_create(int bpp, int w, int h, void *data, int flags) {
 	entry->handle = n;
 	entry->mem_taken = (w * h * (bpp >> 3));
 
+	bm_name_index_add(entry);
+
 	entry->load_count++;
 
 	bm_update_memory_used(n, (int)entry->mem_taken);
@@ -643,6 +819,8 @@ int bm_create_3d(int bpp, int w, int h, int d, void* data) {
 	entry->handle = n;
 	entry->mem_taken = (w * h * d * (bpp >> 3));
 
+	bm_name_index_add(entry);
+
 	entry->load_count++;
 
 	bm_update_memory_used(n, (int)entry->mem_taken);
@@ -686,6 +864,10 @@ void bm_free_data(bitmap_slot* bs, bool release)
 	auto be = &bs->entry;
 	bmp = &be->bm;
 
+	if (!Bm_stream_jobs.empty()) {
+		bm_stream_cancel(be->handle);
+	}
+
 	gr_bm_free_data(bs, release);
 
 	// If there isn't a bitmap in this structure, don't
@@ -744,6 +926,10 @@ void bm_free_data_fast(int handle)
 	be = bm_get_entry(handle);
 	bmp = &be->bm;
 
+	if (!Bm_stream_jobs.empty()) {
+		bm_stream_cancel(handle);
+	}
+
 	// If there isn't a bitmap in this structure, don't
 	// do anything but clear out the bitmap info
 	if (be->type == BM_TYPE_NONE)
@@ -1033,6 +1219,11 @@ void bm_init() {
 	// Allocate one block by default
 	allocate_new_block();
 
+	if (Cmdline_stream_textures) {
+		Bm_stream_quit = false;
+		Bm_stream_thread = std::thread(bm_stream_thread_main);
+	}
+
 	bm_inited = true;
 }
 
@@ -1338,6 +1529,8 @@ int bm_load(const char *real_filename, int dir_type) {
 	entry->dir_type = dir_type;
 	entry->handle = handle;
 
+	bm_name_index_add(entry);
+
 	entry->load_count++;
 
 	if (img_cfp != nullptr)
@@ -1846,6 +2039,8 @@ int bm_load_animation(const char *real_filename, int *nframes, int *fps, int *ke
 			}
 		}
 
+		bm_name_index_add(entry);
+
 		entry->info.ani.apng.frame_delay = 0.0f;
 		if (type == BM_TYPE_PNG) {
 			entry->info.ani.apng.is_apng = true;
@@ -1939,9 +2134,11 @@ int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type, bool
 	if (Bm_ignore_duplicates)
 		return 0;
 
-	for (auto& block : bm_blocks) {
-		for (auto& slot : block) {
-			auto& entry = slot.entry;
+	auto index_it = Bm_name_index.find(bm_name_index_key(real_filename));
+
+	if (index_it != Bm_name_index.end()) {
+		for (int candidate : index_it->second) {
+			auto& entry = bm_get_slot(candidate, true)->entry;
 			if (entry.type == BM_TYPE_NONE)
 				continue;
 
@@ -1958,12 +2155,14 @@ int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type, bool
 			if (!strextcmp(real_filename, entry.filename)) {
 				entry.load_count++;
 				*handle = entry.handle;
+				Bm_name_index_hits++;
 				return 1;
 			}
 		}
 	}
 
 	// not found to be loaded already
+	Bm_name_index_misses++;
 	return 0;
 }
 
@@ -2262,114 +2461,25 @@ void bm_lock_apng(int /*handle*/, bitmap_slot *bs, bitmap *bmp, int bpp, uint /*
 
 
 void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*flags*/) {
-	ubyte *data = NULL;
-	int error;
-	ubyte dds_bpp = 0;
-	char filename[MAX_FILENAME_LEN];
-
-	auto be = &bs->entry;
-
-	// free any existing data
-	bm_free_data(bs);
-
-	Assert(be->mem_taken > 0);
-	Assert(&be->bm == bmp);
-
-	data = (ubyte*)bm_malloc(handle, be->mem_taken);
-
-	if (data == NULL)
-		return;
-
-	memset(data, 0, be->mem_taken);
-
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
-
-	error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+	Assert(&bs->entry.bm == bmp);
 
-#if BYTE_ORDER == BIG_ENDIAN
-	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
-	if ((be->comp_type == BM_TYPE_DDS) || (be->comp_type == BM_TYPE_CUBEMAP_DDS)) {
-		size_t i = 0;
+	bm_image_read read;
 
-		if (dds_bpp == 32) {
-			unsigned int *swap_tmp;
-
-			for (i = 0; i < be->mem_taken; i += 4) {
-				swap_tmp = (unsigned int *)(data + i);
-				*swap_tmp = INTEL_INT(*swap_tmp);
-			}
-		} else if (dds_bpp == 16) {
-			unsigned short *swap_tmp;
-
-			for (i = 0; i < be->mem_taken; i += 2) {
-				swap_tmp = (unsigned short *)(data + i);
-				*swap_tmp = INTEL_SHORT(*swap_tmp);
-			}
-		}
+	if (bm_read_image_begin(handle, bs, read)) {
+		bm_read_image(read);
+		bm_read_image_end(read);
 	}
-#endif
-
-	bmp->bpp = dds_bpp;
-	bmp->data = (ptr_u)data;
-	bmp->flags = 0;
-
-	if (error != DDS_ERROR_NONE) {
-		bm_free_data(bs);
-		return;
-	}
-
-#ifdef BMPMAN_NDEBUG
-	Assert(be->data_size > 0);
-#endif
 }
 
-void bm_lock_jpg(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint /*flags*/) {
-	ubyte *data = NULL;
-	int d_size = 0;
-	int jpg_error = JPEG_ERROR_INVALID;
-	char filename[MAX_FILENAME_LEN];
-
-	auto be = &bs->entry;
-
-	// Unload any existing data
-	bm_free_data(bs);
-
-	// JPEG actually only support 24 bits per pixel so we enforce that here
-	bpp = 24;
-
-	d_size = (bpp >> 3);
-
-	// allocate bitmap data
-	Assert(be->mem_taken > 0);
-	data = (ubyte*)bm_malloc(handle, be->mem_taken);
-
-	if (data == NULL)
-		return;
-
-	memset(data, 0, be->mem_taken);
-
-	bmp->bpp = bpp;
-	bmp->data = (ptr_u)data;
-	bmp->palette = NULL;
+void bm_lock_jpg(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*flags*/) {
+	Assert(&bs->entry.bm == bmp);
 
-	Assert(&be->bm == bmp);
+	bm_image_read read;
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
-
-	jpg_error = jpeg_read_bitmap(filename, data, NULL, d_size, be->dir_type);
-
-	if (jpg_error != JPEG_ERROR_NONE) {
-		bm_free_data(bs);
-		return;
+	if (bm_read_image_begin(handle, bs, read)) {
+		bm_read_image(read);
+		bm_read_image_end(read);
 	}
-
-#ifdef BMPMAN_NDEBUG
-	Assert(be->data_size > 0);
-#endif
 }
 
 void bm_lock_pcx(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint flags) {
@@ -2418,48 +2528,14 @@ void bm_lock_pcx(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint flags)
 }
 
 void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*flags*/) {
-	ubyte *data = NULL;
-	//assume 32 bit - libpng should expand everything
-	int d_size;
-	int png_error = PNG_ERROR_INVALID;
-	char filename[MAX_FILENAME_LEN];
-
-	auto be = &bs->entry;
-
-	// Unload any existing data
-	bm_free_data(bs);
-
-	// allocate bitmap data
-	Assert(bmp->w * bmp->h > 0);
-
-	//if it's not 32-bit, we expand when we read it
-	bmp->bpp = 32;
-	d_size = bmp->bpp >> 3;
-	//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
-	data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
-	if (data == NULL)
-		return;
-	memset(data, 0, bmp->w * bmp->h * d_size);
-	bmp->data = (ptr_u)data;
-	bmp->palette = NULL;
-
-	Assert(&be->bm == bmp);
+	Assert(&bs->entry.bm == bmp);
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+	bm_image_read read;
 
-	//bmp->bpp gets set correctly in here after reading into memory
-	png_error = png_read_bitmap(filename, data, &bmp->bpp, d_size, be->dir_type);
-
-	if (png_error != PNG_ERROR_NONE) {
-		bm_free_data(bs);
-		return;
+	if (bm_read_image_begin(handle, bs, read)) {
+		bm_read_image(read);
+		bm_read_image_end(read);
 	}
-
-#ifdef BMPMAN_NDEBUG
-	Assert(be->data_size > 0);
-#endif
 }
 
 void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint flags) {
@@ -2622,6 +2698,8 @@ int bm_make_render_target(int width, int height, int flags) {
 
 	entry->handle = n;
 
+	bm_name_index_add(entry);
+
 	if (entry->mem_taken) {
 		entry->bm.data = (ptr_u)bm_malloc(n, entry->mem_taken);
 	}
@@ -2660,6 +2738,36 @@ void bm_page_in_aabitmap(int handle, int nframes) {
 	}
 }
 
+/**
+ * Reads the images of the given handles that can be read on the worker threads, so that locking them for the upload
+ * finds them in memory already
+ */
+static void bm_page_in_read_images(const int* handles, size_t count, SCP_vector<bm_image_read>& reads) {
+	TRACE_SCOPE(tracing::PageInDecode);
+
+	reads.clear();
+
+	for (size_t i = 0; i < count; i++) {
+		auto bs = bm_get_slot(handles[i], true);
+
+		if ((bs->entry.bm.data != 0) || !bm_can_read_image(&bs->entry))
+			continue;
+
+		reads.emplace_back();
+
+		if (!bm_read_image_begin(handles[i], bs, reads.back()))
+			reads.pop_back();
+	}
+
+	threading::parallel_for(reads.size(), 1, [&reads](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+			bm_read_image(reads[i]);
+	}, &tracing::PageInDecodeBitmap);
+
+	for (auto& read : reads)
+		bm_read_image_end(read);
+}
+
 void bm_page_in_start() {
 	Bm_paging = 1;
 
@@ -2690,9 +2798,7 @@ void bm_page_in_stop() {
 	nprintf(("BmpInfo", "BMPMAN: Loading all used bitmaps.\n"));
 
 	// Load all the ones that are supposed to be loaded for this level.
-	int n = 0;
-
-	int bm_preloading = 1;
+	SCP_vector<int> page_in;
 
 	for (auto& block : bm_blocks) {
 		for (auto& slot : block) {
@@ -2701,39 +2807,69 @@ void bm_page_in_stop() {
 			if ((entry.type != BM_TYPE_NONE) && (entry.type != BM_TYPE_RENDER_TARGET_DYNAMIC)
 				&& (entry.type != BM_TYPE_RENDER_TARGET_STATIC)) {
 				if (entry.preloaded) {
-					TRACE_SCOPE(tracing::PageInSingleBitmap);
-					if (bm_preloading) {
-						if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
-							mprintf(("Out of VRAM.  Done preloading.\n"));
-							bm_preloading = 0;
-						}
-					} else {
-						bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
-						if (entry.ref_count >= 1) {
-							bm_unlock(entry.handle);
-						}
-					}
+					page_in.push_back(entry.handle);
+				} else {
+					bm_unload_fast(entry.handle);
+				}
+			}
+		}
+	}
+
+	int n = 0;
+
+	int bm_preloading = 1;
+
+	SCP_vector<bm_image_read> reads;
+
+	for (size_t batch = 0; batch < page_in.size(); batch += BM_PAGE_IN_BATCH_SIZE) {
+		auto batch_size = std::min(BM_PAGE_IN_BATCH_SIZE, page_in.size() - batch);
+
+		// Reading the files is what takes the time, and short of textures still in video memory from before every image
+		// gets read below anyway, for the upload or for the lock. So the whole batch is read on the worker threads
+		// first, which leaves only the uploads for this one.
+		bm_page_in_read_images(&page_in[batch], batch_size, reads);
+		size_t next_read = 0;
+
+		for (size_t i = batch; i < batch + batch_size; i++) {
+			auto& entry = *bm_get_entry(page_in[i]);
+
+			bool was_read = (next_read < reads.size()) && (reads[next_read].handle == entry.handle);
+			if (was_read) {
+				next_read++;
+			}
+
+			TRACE_SCOPE(tracing::PageInSingleBitmap);
+			if (bm_preloading) {
+				if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
+					mprintf(("Out of VRAM.  Done preloading.\n"));
+					bm_preloading = 0;
+				} else if (was_read && (entry.bm.data != 0) && (entry.ref_count == 0)) {
+					// the texture was uploaded already, so what was read above isn't needed
+					bm_unload_fast(entry.handle);
+				}
+			} else {
+				bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
+				if (entry.ref_count >= 1) {
+					bm_unlock(entry.handle);
+				}
+			}
 
-					n++;
+			n++;
 
-					multi_send_anti_timeout_ping();
+			multi_send_anti_timeout_ping();
 
-					if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
+			if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
 #ifndef NDEBUG
-						memset(busy_text, 0, sizeof(busy_text));
+				memset(busy_text, 0, sizeof(busy_text));
 
-						strcat_s(busy_text, "** BmpMan: ");
-						strcat_s(busy_text, entry.filename);
-						strcat_s(busy_text, " **");
+				strcat_s(busy_text, "** BmpMan: ");
+				strcat_s(busy_text, entry.filename);
+				strcat_s(busy_text, " **");
 
-						game_busy(busy_text);
+				game_busy(busy_text);
 #else
-						game_busy();
+				game_busy();
 #endif
-					}
-				} else {
-					bm_unload_fast(entry.handle);
-				}
 			}
 		}
 	}
@@ -2917,6 +3053,138 @@ void bm_print_bitmaps() {
 #endif
 }
 
+void bm_read_image(bm_image_read& read) {
+	switch (read.type) {
+	case BM_TYPE_PNG:
+		// read.bpp gets set correctly in here after reading into memory
+		read.error = png_read_bitmap(read.filename, read.data, &read.bpp, read.bpp >> 3, read.dir_type, &read.messages);
+		break;
+
+	case BM_TYPE_JPG:
+		read.error = jpeg_read_bitmap(read.filename, read.data, nullptr, read.bpp >> 3, read.dir_type, &read.messages);
+		break;
+
+	default: {
+		ubyte dds_bpp = 0;
+		read.error = dds_read_bitmap(read.filename, read.data, &dds_bpp, read.dir_type, &read.messages);
+		read.bpp = dds_bpp;
+		break;
+	}
+	}
+}
+
+bool bm_read_image_begin(int handle, bitmap_slot* bs, bm_image_read& read) {
+	auto be = &bs->entry;
+	auto bmp = &be->bm;
+
+	// Unload any existing data
+	bm_free_data(bs);
+
+	read.handle = handle;
+	read.dir_type = be->dir_type;
+
+	// make sure we are using the correct filename and type in the case of an EFF
+	if (be->type == BM_TYPE_EFF) {
+		read.type = be->info.ani.eff.type;
+		strcpy_s(read.filename, be->info.ani.eff.filename);
+	} else {
+		read.type = be->type;
+		strcpy_s(read.filename, be->filename);
+	}
+
+	size_t size;
+
+	if (read.type == BM_TYPE_PNG) {
+		Assert(bmp->w * bmp->h > 0);
+
+		// if it's not 32-bit, libpng expands it when reading it
+		// we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
+		read.bpp = 32;
+		size = static_cast<size_t>(bmp->w * bmp->h * (read.bpp >> 3));
+	} else {
+		Assert(be->mem_taken > 0);
+
+		// JPEG actually only support 24 bits per pixel so we enforce that here, DDS tells us once it's read
+		read.bpp = (read.type == BM_TYPE_JPG) ? 24 : 0;
+		size = be->mem_taken;
+	}
+
+	read.data = (ubyte*)bm_malloc(handle, size);
+
+	if (read.data == nullptr)
+		return false;
+
+	memset(read.data, 0, size);
+
+	return true;
+}
+
+void bm_read_image_end(bm_image_read& read) {
+	auto bs = bm_get_slot(read.handle, true);
+	auto be = &bs->entry;
+	auto bmp = &be->bm;
+
+#if BYTE_ORDER == BIG_ENDIAN
+	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
+	if ((be->comp_type == BM_TYPE_DDS) || (be->comp_type == BM_TYPE_CUBEMAP_DDS)) {
+		size_t i = 0;
+
+		if (read.bpp == 32) {
+			unsigned int *swap_tmp;
+
+			for (i = 0; i < be->mem_taken; i += 4) {
+				swap_tmp = (unsigned int *)(read.data + i);
+				*swap_tmp = INTEL_INT(*swap_tmp);
+			}
+		} else if (read.bpp == 16) {
+			unsigned short *swap_tmp;
+
+			for (i = 0; i < be->mem_taken; i += 2) {
+				swap_tmp = (unsigned short *)(read.data + i);
+				*swap_tmp = INTEL_SHORT(*swap_tmp);
+			}
+		}
+	}
+#endif
+
+	bmp->bpp = read.bpp;
+	bmp->data = (ptr_u)read.data;
+	bmp->palette = nullptr;
+
+	if ((read.type != BM_TYPE_PNG) && (read.type != BM_TYPE_JPG))
+		bmp->flags = 0;
+
+	// the readers leave reporting to us, since they may have run on another thread
+	for (auto& message : read.messages) {
+		switch (message.level) {
+		case image_read_message::severity::Filtered:
+			nprintf((message.log_filter, "%s", message.text.c_str()));
+			break;
+		case image_read_message::severity::Log:
+			mprintf(("%s", message.text.c_str()));
+			break;
+		case image_read_message::severity::DebugWarning:
+#ifndef NDEBUG
+			Warning(LOCATION, "%s", message.text.c_str());
+#endif
+			break;
+		case image_read_message::severity::Error:
+			Error(LOCATION, "%s", message.text.c_str());
+			break;
+		}
+	}
+
+	// all the readers use 0 for no error
+	if (read.error != 0) {
+		bm_free_data(bs);
+		return;
+	}
+
+#ifdef BMPMAN_NDEBUG
+	Assert(be->data_size > 0);
+#endif
+}
+
 int bm_release(int handle, int clear_render_targets) {
 	Assert(handle >= 0);
 
@@ -2970,6 +3238,7 @@ int bm_release(int handle, int clear_render_targets) {
 		for (i = 0; i < total; i++) {
 			auto entry = bm_get_entry(first + i);
 
+			bm_name_index_remove(entry);
 			memset(entry, 0, sizeof(bitmap_entry));
 
 			entry->type = BM_TYPE_NONE;
@@ -2995,7 +3264,7 @@ int bm_release(int handle, int clear_render_targets) {
 
 		bm_free_data(slot, true);		// clears flags, bbp, data, etc
 
-
+		bm_name_index_remove(entry);
 		memset(entry, 0, sizeof(bitmap_entry));
 
 		entry->type = BM_TYPE_NONE;
@@ -3058,7 +3327,10 @@ int bm_reload(int bitmap_handle, const char* filename) {
 		return -1;
 	}
 
+	bm_name_index_remove(entry);
 	strcpy_s(entry->filename, filename);
+	bm_name_index_add(entry);
+
 	return bitmap_handle;
 }
 
@@ -3202,6 +3474,120 @@ bool bm_set_render_target(int handle, int face) {
 	return false;
 }
 
+void bm_stream_cancel(int handle) {
+	auto it = Bm_stream_jobs.find(handle);
+
+	if (it == Bm_stream_jobs.end())
+		return;
+
+	auto job = std::move(it->second);
+	Bm_stream_jobs.erase(it);
+
+	{
+		std::unique_lock<std::mutex> lock(Bm_stream_mutex);
+
+		auto queued = std::find(Bm_stream_queue.begin(), Bm_stream_queue.end(), job.get());
+
+		if (queued != Bm_stream_queue.end()) {
+			// nothing was read yet, so bm_read_image_end() frees the data right away
+			Bm_stream_queue.erase(queued);
+			job->read.error = -1;
+		} else {
+			Bm_stream_cond.wait(lock, [&job]() { return job->done.load(); });
+		}
+	}
+
+	MONITOR_INC(NumBitmapStreamsPending, -1);
+
+	bm_read_image_end(job->read);
+}
+
+void bm_stream_close() {
+	if (!Bm_stream_thread.joinable())
+		return;
+
+	while (!Bm_stream_jobs.empty()) {
+		bm_stream_cancel(Bm_stream_jobs.begin()->first);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Bm_stream_mutex);
+		Bm_stream_quit = true;
+	}
+	Bm_stream_cond.notify_all();
+
+	Bm_stream_thread.join();
+}
+
+bool bm_stream_texture(int handle) {
+	Assertion(bm_inited, "bmpman must be initialized before this function can be called!");
+
+	auto it = Bm_stream_jobs.find(handle);
+
+	if (it != Bm_stream_jobs.end()) {
+		if (!it->second->done)
+			return false;
+
+		auto job = std::move(it->second);
+		Bm_stream_jobs.erase(it);
+
+		MONITOR_INC(NumBitmapStreamsPending, -1);
+		MONITOR_INC(NumBitmapStreamsCompleted, 1);
+		Bm_streams_completed++;
+
+		bm_read_image_end(job->read);
+		return true;
+	}
+
+	// while paging in, the level is loading anyway and everything is read right away
+	if (!Bm_stream_thread.joinable() || Bm_paging)
+		return true;
+
+	auto bs = bm_get_slot(handle);
+	auto be = &bs->entry;
+
+	if ((be->bm.data != 0) || !bm_can_read_image(be))
+		return true;
+
+	std::unique_ptr<bm_stream_job> job(new bm_stream_job());
+
+	if (!bm_read_image_begin(handle, bs, job->read))
+		return true;
+
+	{
+		std::lock_guard<std::mutex> lock(Bm_stream_mutex);
+		Bm_stream_queue.push_back(job.get());
+	}
+	Bm_stream_cond.notify_all();
+
+	Bm_stream_jobs.emplace(handle, std::move(job));
+
+	MONITOR_INC(NumBitmapStreamsPending, 1);
+
+	return false;
+}
+
+void bm_stream_thread_main() {
+	std::unique_lock<std::mutex> lock(Bm_stream_mutex);
+
+	for (;;) {
+		Bm_stream_cond.wait(lock, []() { return Bm_stream_quit || !Bm_stream_queue.empty(); });
+
+		if (Bm_stream_quit)
+			return;
+
+		auto job = Bm_stream_queue.front();
+		Bm_stream_queue.pop_front();
+
+		lock.unlock();
+		bm_read_image(job->read);
+		lock.lock();
+
+		job->done = true;
+		Bm_stream_cond.notify_all();
+	}
+}
+
 int bm_unload(int handle, int clear_render_targets, bool nodebug) {
 	bitmap_entry *be;
 	bitmap *bmp;
@@ -276,6 +276,20 @@ int bm_unload(int handle, int clear_render_targets = 0, bool nodebug = false);
  */
 int bm_unload_fast(int handle, int clear_render_targets = 0);
 
+/**
+ * @brief Makes sure the image of a bitmap is in memory, reading it on the streaming thread if texture streaming is on
+ *
+ * @details With -stream_textures the first call for an image that isn't in memory yet starts reading it in the
+ *   background and returns false, as do all calls until it has been read. The renderer is expected to draw something
+ *   else meanwhile and ask again later. Animations and formats that can only be read on the main thread are left to
+ *   bm_lock(), as is everything while paging in.
+ *
+ * @param handle The bitmap handle
+ *
+ * @returns true if bm_lock() can be called without waiting for the file, false if the image is still being read
+ */
+bool bm_stream_texture(int handle);
+
 /**
  * @brief Frees both a bitmap's data and it's associated slot.
  *
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/**
+ * @brief Something an image reader had to say while reading a file
+ *
+ * The readers can run on worker threads, where they must not show dialogs or write to the log, so they collect these
+ * and leave them to be reported on the main thread, with the severity the reader would have used itself.
+ */
+struct image_read_message {
+	enum class severity {
+		Filtered,       //!< to the log under the debug filter in log_filter, like nprintf()
+		Log,            //!< to the log, like mprintf()
+		DebugWarning,   //!< a Warning() in debug builds, dropped in release builds
+		Error,          //!< a fatal Error()
+	};
+
+	severity level;
+	const char* log_filter; //!< for Filtered messages only, must be a string literal
+	SCP_string text;
+};
+
+typedef SCP_vector<image_read_message> image_read_messages;
@@ -35,6 +35,7 @@
 
 
 #include <limits>
+#include <mutex>
 
 char Cfile_root_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
 char Cfile_user_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
@@ -96,6 +97,9 @@ static SCP_vector<SCP_string> Cfile_stack;
 
 std::array<CFILE, MAX_CFILE_BLOCKS> Cfile_block_list;
 
+// Taking and giving back blocks is all that files opened on different threads share
+static std::mutex Cfile_block_mutex;
+
 static const char *Cfile_cdrom_dir = NULL;
 
 //
@@ -814,6 +818,8 @@ static int cfget_cfile_block()
 	int i;
 	CFILE* cfile;
 
+	std::unique_lock<std::mutex> lock(Cfile_block_mutex);
+
 	for ( i = 0; i < MAX_CFILE_BLOCKS; i++ ) {
 		cfile = &Cfile_block_list[i];
 		if (cfile->type == CFILE_BLOCK_UNUSED) {
@@ -825,6 +831,8 @@ static int cfget_cfile_block()
 		}
 	}
 
+	lock.unlock();
+
 	// If we've reached this point, a free Cfile_block could not be found
 	nprintf(("Warning","A free Cfile_block could not be found.\n"));
 
@@ -857,6 +865,8 @@ int cfclose( CFILE * cfile )
 		// VP  do nothing
 	}
 	cf_clear_compression_info(cfile);
+
+	std::lock_guard<std::mutex> lock(Cfile_block_mutex);
 	cfile->type = CFILE_BLOCK_UNUSED;
 	return result;
 }
@@ -116,6 +116,38 @@ typedef struct cf_file_block {
 static uint Num_files = 0;
 static SCP_vector<std::unique_ptr<cf_file_block>> File_blocks;
 
+// case-insensitive hashing/compare for the file index, matches the stricmp() rules used for lookups
+struct cf_file_index_hash {
+	size_t operator()(const SCP_string &name) const {
+		// FNV-1a
+		size_t hash = 2166136261u;
+
+		for (auto c : name) {
+			if ( (c >= 'A') && (c <= 'Z') ) {
+				c += 'a' - 'A';
+			}
+
+			hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+		}
+
+		return hash;
+	}
+};
+
+struct cf_file_index_equal_to {
+	bool operator()(const SCP_string &a, const SCP_string &b) const {
+		return (a.length() == b.length()) && !stricmp(a.c_str(), b.c_str());
+	}
+};
+
+// Index of the file list keyed by name_ext.  Each entry holds the indices of all files with
+// that name in the order they were added, which is root precedence order, so walking an entry
+// front to back gives the same result as a linear scan over the whole file list.
+static SCP_unordered_map<SCP_string, SCP_vector<uint>, cf_file_index_hash, cf_file_index_equal_to> File_index;
+
+// set to bypass File_index and do a full scan instead (for testing/benchmarking)
+bool Cf_disable_file_index = false;
+
 // Return a pointer to to file 'index'.
 cf_file *cf_get_file(int index)
 {
@@ -149,6 +181,28 @@ cf_file *cf_create_file()
 	return &File_blocks[block]->files[offset];
 }
 
+// Add the most recently created file to the lookup index.  Must be called once name_ext is set.
+static void cf_index_last_file()
+{
+	Assertion(Num_files > 0, "No file available to index!");
+
+	const uint index = Num_files - 1;
+
+	File_index[cf_get_file(index)->name_ext].push_back(index);
+}
+
+// Returns the indices of all files named 'name_ext', in file list order, or nullptr if there are none
+static const SCP_vector<uint> *cf_get_indexed_files(const SCP_string &name_ext)
+{
+	auto it = File_index.find(name_ext);
+
+	if (it == File_index.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
 extern int cfile_inited;
 
 // Create a new root and return a pointer to it.  The structure is assumed unitialized.
@@ -795,7 +849,13 @@ static void check_file_shadows(const int root_index __UNUSED, const int pathtype
 	newfile += cf_get_root_pathtype(root, pathtype) + DIR_SEPARATOR_CHAR;
 	newfile += sub_path + (real_name ? real_name : name);
 
-	for (uint i = 0; i < Num_files; ++i) {
+	const auto indexed = cf_get_indexed_files(name);
+
+	if (indexed == nullptr) {
+		return;
+	}
+
+	for (auto i : *indexed) {
 		const auto f = cf_get_file(i);
 		const auto r = cf_get_root(f->root_index);
 
@@ -923,6 +983,8 @@ void cf_search_root_path(int root_index)
 			cfile->real_name = search_path + DIR_SEPARATOR_STR + file.sub_path + orig_name;
 			cfile->sub_path = file.sub_path;
 
+			cf_index_last_file();
+
 			++num_files;
 		}
 	}
@@ -965,6 +1027,8 @@ static int cf_add_pack_files(const int root_index, SCP_vector<_file_list_t> &fil
 		pf->size = static_cast<int>(file.size);
 		pf->pack_offset = file.offset;			// Mark as a packed file
 		pf->sub_path = file.sub_path;
+
+		cf_index_last_file();
 	}
 
 	return static_cast<int>(files.size());
@@ -1138,6 +1202,8 @@ void cf_search_memory_root(int root_index) {
 		file->size = (int)default_file.size;
 		file->data = default_file.data;
 
+		cf_index_last_file();
+
 		num_files++;
 	}
 
@@ -1149,6 +1215,7 @@ void cf_build_file_list()
 	int i;
 
 	Num_files = 0;
+	File_index.clear();
 
 	// For each root, find all files...
 	for (i=0; i<Num_roots; i++ )	{
@@ -1208,6 +1275,8 @@ void cf_free_secondary_filelist()
 	// Free the file blocks
 	File_blocks.clear();
 	Num_files = 0;
+
+	File_index.clear();
 }
 
 static bool is_absolute_path(const char *path)
@@ -1379,9 +1448,18 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, uint32_t
 		filename.erase(0, seperator+1);
 	}
 
+	// only files with a matching name need to be checked, and the index has those in precedence order
+	const SCP_vector<uint> *indexed = nullptr;
+	uint num_candidates = Num_files;
+
+	if ( !Cf_disable_file_index ) {
+		indexed = cf_get_indexed_files(filename);
+		num_candidates = indexed ? static_cast<uint>(indexed->size()) : 0;
+	}
+
 	// Search the pak files and CD-ROM.
-	for (ui = 0; ui < Num_files; ui++ )	{
-		cf_file *f = cf_get_file(ui);
+	for (ui = 0; ui < num_candidates; ui++ )	{
+		cf_file *f = cf_get_file(indexed ? (*indexed)[ui] : ui);
 
 		// only search paths we're supposed to...
 		if ( (pathtype != CF_TYPE_ANY) && (pathtype != f->pathtype_index) )
@@ -1402,7 +1480,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, uint32_t
 		}
 
 		// file either not localized or localized version not found
-		if ( !stricmp(filename.c_str(), f->name_ext.c_str()) ) {
+		if ( indexed || !stricmp(filename.c_str(), f->name_ext.c_str()) ) {
 			CFileLocation res(true);
 			res.size = static_cast<size_t>(f->size);
 			res.offset = (size_t)f->pack_offset;
@@ -1440,7 +1518,6 @@ extern char *stristr(char *str, const char *substr);
  * Searches for a file.
  *
  * @note Follows all rules and precedence and searches CD's and pack files. Searches all locations in order for first filename using filter list.
- * @note This function is exponentially slow, so don't use it unless truely needed
  *
  * @param filename      Filename & extension
  * @param ext_num       Number of extensions to look for
@@ -1569,9 +1646,29 @@ CFileLocationExt cf_find_file_location_ext(const char *filename, const int ext_n
 
 	file_list_index.reserve( MIN(ext_num * 4, (int)Num_files) );
 
+	// gather every file named like one of our extensions from the index, in file list order, so
+	// that the scan below only has to look at real candidates
+	SCP_vector<uint> indexed;
+	uint num_candidates = Num_files;
+
+	if ( !Cf_disable_file_index ) {
+		for (cur_ext = 0; cur_ext < ext_num; cur_ext++) {
+			auto ext_files = cf_get_indexed_files(filespec + ext_list[cur_ext]);
+
+			if (ext_files) {
+				indexed.insert(indexed.end(), ext_files->begin(), ext_files->end());
+			}
+		}
+
+		std::sort(indexed.begin(), indexed.end());
+		indexed.erase(std::unique(indexed.begin(), indexed.end()), indexed.end());
+
+		num_candidates = static_cast<uint>(indexed.size());
+	}
+
 	// next, run though and pick out base matches
-	for (ui = 0; ui < Num_files; ui++) {
-		cf_file *f = cf_get_file(ui);
+	for (ui = 0; ui < num_candidates; ui++) {
+		cf_file *f = cf_get_file(Cf_disable_file_index ? ui : indexed[ui]);
 
 		// ... only search paths that we're supposed to
 		if ( (num_search_dirs == 1) && (pathtype != f->pathtype_index) )
@@ -122,6 +122,9 @@ extern bool Cmdline_no_geo_sdr_effects;
 extern bool Cmdline_set_cpu_affinity;
 extern bool Cmdline_nograb;
 extern bool Cmdline_noshadercache;
+extern bool Cmdline_nobspcache;
+extern bool Cmdline_novolumetricscache;
+extern bool Cmdline_stream_textures;
 extern bool Cmdline_prefer_ipv4;
 extern bool Cmdline_prefer_ipv6;
 extern bool Cmdline_dump_packet_type;
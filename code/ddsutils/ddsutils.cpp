@@ -3,6 +3,7 @@
 #include "cfile/cfile.h"
 #include "graphics/2d.h"
 #include "osapi/osregistry.h"
+#include "parse/parselo.h"
 #ifdef USE_OPENGL_ES
 #include "graphics/opengl/es_compatibility.h"
 #endif
@@ -403,11 +404,12 @@ Done:
 	return retval;
 }
 
-static void (*decompress_dds)(const void *in, void *out, int pitch) = nullptr;
-static uint32_t BLOCK_SIZE = 0;
+// per thread, since bmpman decodes several images at once while paging in
+static thread_local void (*decompress_dds)(const void *in, void *out, int pitch) = nullptr;
+static thread_local uint32_t BLOCK_SIZE = 0;
 
 //reads pixel info from a dds file
-int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
+int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type, image_read_messages *messages)
 {
 	int retval;
 	size_t size = 0;
@@ -485,8 +487,17 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 				BLOCK_SIZE = BCDEC_BC2_BLOCK_SIZE;
 				break;
 			default:
-				Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", dds_header.ddspf.dwFourCC);
-				break;
+				if (messages == nullptr) {
+					Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", dds_header.ddspf.dwFourCC);
+				} else {
+					SCP_string text;
+					sprintf(text, "Invalid FourCC (%d) for DDS decompression of %s!", dds_header.ddspf.dwFourCC, real_name);
+					messages->push_back({image_read_message::severity::Error, nullptr, std::move(text)});
+				}
+
+				vm_free(comp_data);
+				cfclose(cfp);
+				return DDS_ERROR_UNSUPPORTED;
 		}
 
 		for (int f = 0; f < num_faces; ++f) {
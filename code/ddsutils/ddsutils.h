@@ -6,6 +6,7 @@
 
 #include "globalincs/pstypes.h"
 #include "cfile/cfile.h"
+#include "bmpman/image_read_message.h"
 
 
 #define DDS_ERROR_NONE					0		// everything went fine
@@ -304,7 +305,8 @@ int dds_read_header(const char *filename, CFILE *img_cfp = NULL, int *width = 0,
 
 //reads bitmap
 //size of the data it stored in size
-int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp = NULL, int cf_type = CF_TYPE_ANY);
+//if messages is given, errors are left there instead of being reported, so this can run on any thread
+int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp = NULL, int cf_type = CF_TYPE_ANY, image_read_messages *messages = nullptr);
 
 // Decompress just the top mip of a 2D FOURCC-compressed DDS (DXT1/3/5, BC7)
 // to 32-bpp BGRA, regardless of what the renderer's compression support is.
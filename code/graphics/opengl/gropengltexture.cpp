@@ -48,6 +48,9 @@ GLenum GL_texture_addressing = GL_REPEAT;
 bool GL_rendering_to_texture = false;
 GLint GL_max_renderbuffer_size = 0;
 
+// What textures are drawn with while bmpman streams their image in
+static GLuint GL_stream_placeholder_texture = 0;
+
 extern int GLOWMAP;
 extern int SPECMAP;
 extern int ENVMAP;
@@ -246,6 +249,12 @@ void opengl_tcache_shutdown()
 
 	opengl_tcache_flush();
 
+	if (GL_stream_placeholder_texture != 0) {
+		GL_state.Texture.Delete(GL_stream_placeholder_texture);
+		glDeleteTextures(1, &GL_stream_placeholder_texture);
+		GL_stream_placeholder_texture = 0;
+	}
+
 	GL_textures_in_frame = 0;
 }
 
@@ -1151,6 +1160,30 @@ int opengl_create_texture(int bitmap_handle, int bitmap_type, tcache_slot_opengl
 // WARNING:  Needs to match what is in bm_internal.h!!!!!
 #define RENDER_TARGET_DYNAMIC	17
 
+static void opengl_tcache_set_stream_placeholder(int tex_unit)
+{
+	if (GL_stream_placeholder_texture == 0) {
+		// mid grey at half alpha, which also makes a flat normal map
+		const GLubyte texel[4] = { 128, 128, 128, 128 };
+
+		glGenTextures(1, &GL_stream_placeholder_texture);
+
+		GL_state.Texture.SetActiveUnit(tex_unit);
+		GL_state.Texture.SetTarget(GL_TEXTURE_2D_ARRAY);
+		GL_state.Texture.Enable(GL_stream_placeholder_texture);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 1, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+
+		opengl_set_object_label(GL_TEXTURE, GL_stream_placeholder_texture, "Texture streaming placeholder");
+	}
+
+	GL_state.Texture.Enable(tex_unit, GL_TEXTURE_2D_ARRAY, GL_stream_placeholder_texture);
+}
+
 int gr_opengl_tcache_set_internal(int bitmap_handle, int bitmap_type, float *u_scale, float *v_scale, uint32_t *array_index, int tex_unit = 0)
 {
 	int ret_val = 1;
@@ -1166,6 +1199,17 @@ int gr_opengl_tcache_set_internal(int bitmap_handle, int bitmap_type, float *u_s
 
 	if (!bm_is_render_target(bitmap_handle) && t->bitmap_handle < 0)
 	{
+		// don't wait for an image that is still being streamed in, it gets uploaded once it is there
+		if (((bitmap_type == TCACHE_TYPE_NORMAL) || (bitmap_type == TCACHE_TYPE_COMPRESSED)) && !bm_stream_texture(bitmap_handle)) {
+			*u_scale = 1.0f;
+			*v_scale = 1.0f;
+			*array_index = 0;
+
+			opengl_tcache_set_stream_placeholder(tex_unit);
+
+			return 1;
+		}
+
 		GL_state.Texture.SetActiveUnit(tex_unit);
 
 		ret_val = opengl_create_texture( bitmap_handle, bitmap_type, t );
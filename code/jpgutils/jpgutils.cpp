@@ -17,6 +17,7 @@
 #include "cfile/cfile.h"
 #include "bmpman/bmpman.h"
 #include "graphics/2d.h"
+#include "parse/parselo.h"
 
 #undef LOCAL // fix for the jpeg header, pstypes.h has defined these macros
 
@@ -45,12 +46,17 @@ typedef struct {
 } cfile_source_mgr;
 
 typedef cfile_source_mgr *cfile_src_ptr;
-struct jpeg_decompress_struct jpeg_info;
-struct jpeg_error_mgr jpeg_err;
+
+// per thread, since bmpman decodes several images at once while paging in
+thread_local struct jpeg_decompress_struct jpeg_info;
+thread_local struct jpeg_error_mgr jpeg_err;
 
 #define INPUT_BUF_SIZE  4096	// choose an efficiently read'able size
 
-static int jpeg_error_code;
+static thread_local int jpeg_error_code;
+
+// where jpeg_read_bitmap() was asked to leave messages, if anywhere
+static thread_local image_read_messages *jpeg_messages = nullptr;
 
 // set current error
 #define Jpeg_Set_Error(x)	{ jpeg_error_code = x; }
@@ -84,6 +90,13 @@ void jpg_output_message(j_common_ptr cinfo)
 	// Create the message 
 	(*cinfo->err->format_message) (cinfo, buffer);
 
+	if (jpeg_messages != nullptr) {
+		SCP_string text;
+		sprintf(text, "%s %s", "JPEG Error:", buffer);
+		jpeg_messages->push_back({image_read_message::severity::DebugWarning, nullptr, std::move(text)});
+		return;
+	}
+
 	// don't actually output anything unless we are a debug build, let bmpman
 	// give any errors instead for release builds
 #ifndef NDEBUG
@@ -165,7 +178,7 @@ int jpeg_read_header(const char *real_filename, CFILE *img_cfp, int *w, int *h,
 //
 // returns - true if succesful, false otherwise
 //
-int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*palette*/, int dest_size, int cf_type)
+int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*palette*/, int dest_size, int cf_type, image_read_messages *messages)
 {
 	char filename[MAX_FILENAME_LEN];
 	CFILE *img_cfp = NULL;
@@ -184,6 +197,7 @@ int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*pal
 
 	// set the basic error code
 	Jpeg_Set_Error(JPEG_ERROR_NONE);
+	jpeg_messages = messages;
 
 	// initialize error message handler
 	jpeg_info.err = jpeg_std_error(&jpeg_err);
@@ -250,9 +264,16 @@ int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*pal
 		jpeg_destroy_decompress(&jpeg_info);
 	}
 	catch (const std::exception &e) {
-		mprintf(("jpgutils: error code %d (%s) while reading %s\n", jpeg_error_code, e.what(), real_filename));
+		if (messages != nullptr) {
+			SCP_string text;
+			sprintf(text, "jpgutils: error code %d (%s) while reading %s\n", jpeg_error_code, e.what(), real_filename);
+			messages->push_back({image_read_message::severity::Log, nullptr, std::move(text)});
+		} else {
+			mprintf(("jpgutils: error code %d (%s) while reading %s\n", jpeg_error_code, e.what(), real_filename));
+		}
 	}
 
+	jpeg_messages = nullptr;
 	cfclose(img_cfp);
 
 
@@ -14,6 +14,7 @@
 
 #include "globalincs/pstypes.h"
 #include "cfile/cfile.h"
+#include "bmpman/image_read_message.h"
 
 
 #define JPEG_ERROR_INVALID			-1
@@ -22,7 +23,8 @@
 
 // reading
 extern int jpeg_read_header(const char *real_filename, CFILE *img_cfp = NULL, int *w = 0, int *h = 0, int *bpp = 0, ubyte *palette = NULL);
-extern int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte *palette, int dest_size, int cf_type = CF_TYPE_ANY);
+// if messages is given, errors are left there instead of being reported, so this can run on any thread
+extern int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte *palette, int dest_size, int cf_type = CF_TYPE_ANY, image_read_messages *messages = nullptr);
 
 
 #endif // _JPEGUTILS_H
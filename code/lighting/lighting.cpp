@@ -21,6 +21,10 @@
 #include "model/modelrender.h"
 #include "render/3d.h"
 #include "options/Option.h"
+#include "tracing/Monitor.h"
+
+#include <algorithm>
+#include <cmath>
 
 
 SCP_vector<light> Lights;
@@ -44,6 +48,17 @@ int Num_lights = 0;
 
 lighting_mode Lighting_mode = lighting_mode::NORMAL;
 
+bool Light_grid_enabled = true;
+DCF_BOOL(light_grid, Light_grid_enabled)
+
+MONITOR(NumLightFilterTests)
+
+// Weapon and explosion lights reach a few hundred meters, so most of them fit in a cell
+static const float LIGHT_GRID_CELL_SIZE = 500.0f;
+
+// With fewer lights than this, testing them all is as quick as building the grid
+static const size_t LIGHT_GRID_MIN_LIGHTS = 64;
+
 DCF(light,"Changes lighting parameters")
 {
 	SCP_string arg_str;
@@ -591,59 +606,181 @@ void scene_lights::addLight(const light *light_ptr)
 	Assert(light_ptr != NULL);
 
 	AllLights.push_back(*light_ptr);
+	GridValid = false;
 
 	if ( light_ptr->type == Light_Type::Directional ) {
 		StaticLightIndices.push_back(AllLights.size() - 1);
 	}
 }
 
+// Whether a light can reach a sphere, for the lights which aren't applied to everything
+static bool light_reaches_sphere(const light& l, const vec3d *pos, float rad)
+{
+	switch ( l.type ) {
+		case Light_Type::Point: {
+			vec3d to_light;
+			float dist_squared, max_dist_squared;
+			vm_vec_sub( &to_light, &l.vec, pos );
+			dist_squared = vm_vec_mag_squared(&to_light);
+
+			max_dist_squared = l.radb+rad;
+			max_dist_squared *= max_dist_squared;
+
+			return dist_squared < max_dist_squared;
+		}
+		case Light_Type::Tube: {
+			vec3d nearest;
+			float dist_squared, max_dist_squared;
+			vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
+
+			max_dist_squared = l.radb+rad;
+			max_dist_squared *= max_dist_squared;
+
+			return dist_squared < max_dist_squared;
+		}
+
+		default:
+			return false;
+	}
+}
+
+static int light_grid_cell(float coord)
+{
+	return static_cast<int>(floorf(coord / LIGHT_GRID_CELL_SIZE));
+}
+
+static uint light_grid_hash(int x, int y, int z)
+{
+	return (static_cast<uint>(x) * 73856093u) ^ (static_cast<uint>(y) * 19349663u) ^ (static_cast<uint>(z) * 83492791u);
+}
+
+void scene_lights::buildLightGrid()
+{
+	GridUnbinnedLights.clear();
+	GridBucketEntries.clear();
+	GridMaxReach = 0.0f;
+
+	for ( size_t i = 0; i < AllLights.size(); ++i ) {
+		auto& l = AllLights[i];
+
+		if ( l.type == Light_Type::Tube || (l.type == Light_Type::Point && l.radb > LIGHT_GRID_CELL_SIZE) ) {
+			// tube lights are tested against their whole line, which no cell can hold
+			GridUnbinnedLights.push_back(i);
+		} else if ( l.type == Light_Type::Point ) {
+			light_grid_entry entry;
+			entry.light_index = i;
+			for ( int k = 0; k < 3; ++k ) {
+				entry.cell[k] = light_grid_cell(l.vec.a1d[k]);
+			}
+
+			GridBucketEntries.push_back(entry);
+			GridMaxReach = MAX(GridMaxReach, l.radb);
+		}
+	}
+
+	uint num_buckets = 1;
+	while ( num_buckets < GridBucketEntries.size() * 2 ) {
+		num_buckets <<= 1;
+	}
+	GridBucketMask = num_buckets - 1;
+
+	auto bucket_of = [this](const light_grid_entry& entry) {
+		return light_grid_hash(entry.cell[0], entry.cell[1], entry.cell[2]) & GridBucketMask;
+	};
+
+	// counting sort of the entries by bucket, keeping light order within a bucket
+	GridBucketStart.assign(num_buckets + 1, 0);
+	for ( auto& entry : GridBucketEntries ) {
+		GridBucketStart[bucket_of(entry) + 1]++;
+	}
+	for ( uint b = 0; b < num_buckets; ++b ) {
+		GridBucketStart[b + 1] += GridBucketStart[b];
+	}
+
+	SCP_vector<light_grid_entry> sorted(GridBucketEntries.size());
+	SCP_vector<int> fill(GridBucketStart.begin(), GridBucketStart.end() - 1);
+	for ( auto& entry : GridBucketEntries ) {
+		sorted[fill[bucket_of(entry)]++] = entry;
+	}
+	GridBucketEntries = std::move(sorted);
+
+	GridValid = true;
+}
+
 void scene_lights::setLightFilter(const vec3d *pos, float rad)
 {
-	size_t i = 0;
 	// clear out current filtered lights
 	FilteredLights.clear();
 
-	for ( auto& l : AllLights ) {
-		switch ( l.type ) {
-			case Light_Type::Directional:
-				++i;
-				continue;
-			case Light_Type::Point: {
-				vec3d to_light;
-				float dist_squared, max_dist_squared;
-				vm_vec_sub( &to_light, &l.vec, pos );
-				dist_squared = vm_vec_mag_squared(&to_light);
+	auto test_all = [&]() {
+		for ( size_t i = 0; i < AllLights.size(); ++i ) {
+			if ( light_reaches_sphere(AllLights[i], pos, rad) ) {
+				FilteredLights.push_back(i);
+			}
+		}
 
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
+		MONITOR_INC(NumLightFilterTests, static_cast<int>(AllLights.size()));
+	};
 
-				if ( dist_squared < max_dist_squared )	{
-					FilteredLights.push_back(i);
-				}
-			}
-			break;
-			case Light_Type::Tube: {
-				vec3d nearest;
-				float dist_squared, max_dist_squared;
-				vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
+	if ( !Light_grid_enabled || AllLights.size() < LIGHT_GRID_MIN_LIGHTS ) {
+		test_all();
+		return;
+	}
+
+	if ( !GridValid ) {
+		buildLightGrid();
+	}
+
+	float extent = rad + GridMaxReach;
+	float cells_per_axis = 2.0f * extent / LIGHT_GRID_CELL_SIZE + 2.0f;
+
+	// a sphere covering more cells than there are lights is quicker to test against all of them
+	if ( cells_per_axis * cells_per_axis * cells_per_axis > static_cast<float>(GridBucketEntries.size()) ) {
+		test_all();
+		return;
+	}
+
+	int num_tests = 0;
+
+	int lo[3], hi[3];
+	for ( int k = 0; k < 3; ++k ) {
+		lo[k] = light_grid_cell(pos->a1d[k] - extent);
+		hi[k] = light_grid_cell(pos->a1d[k] + extent);
+	}
+
+	for ( int x = lo[0]; x <= hi[0]; ++x ) {
+		for ( int y = lo[1]; y <= hi[1]; ++y ) {
+			for ( int z = lo[2]; z <= hi[2]; ++z ) {
+				uint bucket = light_grid_hash(x, y, z) & GridBucketMask;
 
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
+				for ( int i = GridBucketStart[bucket]; i < GridBucketStart[bucket + 1]; ++i ) {
+					auto& entry = GridBucketEntries[i];
 
-				if ( dist_squared < max_dist_squared ) {
-					FilteredLights.push_back(i);
+					// other cells can share the bucket
+					if ( entry.cell[0] != x || entry.cell[1] != y || entry.cell[2] != z ) {
+						continue;
+					}
+
+					++num_tests;
+					if ( light_reaches_sphere(AllLights[entry.light_index], pos, rad) ) {
+						FilteredLights.push_back(entry.light_index);
+					}
 				}
 			}
-			break;
-
-			case Light_Type::Cone:
-				break;
+		}
+	}
 
-			default:
-				break;
+	for ( auto i : GridUnbinnedLights ) {
+		++num_tests;
+		if ( light_reaches_sphere(AllLights[i], pos, rad) ) {
+			FilteredLights.push_back(i);
 		}
-		++i;
 	}
+
+	// same order as testing them all
+	std::sort(FilteredLights.begin(), FilteredLights.end());
+
+	MONITOR_INC(NumLightFilterTests, num_tests);
 }
 
 light_indexing_info scene_lights::bufferLights()
@@ -660,6 +797,18 @@ light_indexing_info scene_lights::bufferLights()
 		return light_info;
 	}
 
+	size_t hash = FilteredLights.size();
+	for ( auto light_index : FilteredLights ) {
+		hash ^= light_index + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+
+	// objects lit by the same lights, like the submodels of a ship, share one copy of them
+	auto existing = BufferedLightSets.find(hash);
+	if ( existing != BufferedLightSets.end() && existing->second.num_lights == FilteredLights.size()
+		&& std::equal(FilteredLights.begin(), FilteredLights.end(), BufferedLights.begin() + existing->second.index_start) ) {
+		return existing->second;
+	}
+
 	light_info.index_start = BufferedLights.size();
 	
 	for ( i = 0; i < FilteredLights.size(); ++i ) {
@@ -668,6 +817,8 @@ light_indexing_info scene_lights::bufferLights()
 
 	light_info.num_lights = FilteredLights.size();
 
+	BufferedLightSets[hash] = light_info;
+
 	return light_info;
 }
 
@@ -68,6 +68,15 @@ struct light_indexing_info
 	size_t num_lights;
 };
 
+// If cleared, scene_lights::setLightFilter() tests every light instead of looking them up in the light grid
+extern bool Light_grid_enabled;
+
+struct light_grid_entry
+{
+	size_t light_index;
+	int cell[3];
+};
+
 class scene_lights
 {
 	SCP_vector<light> AllLights;
@@ -78,15 +87,30 @@ class scene_lights
 
 	SCP_vector<size_t> BufferedLights;
 
+	// filtered sets already in BufferedLights, by their hash, so objects lit by the same lights share them
+	SCP_unordered_map<size_t, light_indexing_info> BufferedLightSets;
+
+	// Point lights binned by the cell of their position, built on the first filter after lights were added.  Tube
+	// lights and point lights reaching further than a cell are in GridUnbinnedLights and checked every time.
+	bool GridValid;
+	SCP_vector<size_t> GridUnbinnedLights;
+	SCP_vector<int> GridBucketStart;
+	SCP_vector<light_grid_entry> GridBucketEntries;
+	uint GridBucketMask;
+	float GridMaxReach;
+
 	size_t current_light_index;
 	size_t current_num_lights;
+
+	void buildLightGrid();
 public:
-	scene_lights()
+	scene_lights() : GridValid(false), GridBucketMask(0), GridMaxReach(0.0f)
 	{
 		resetLightState();
 	}
 	void addLight(const light *light_ptr);
 	void setLightFilter(const vec3d *pos, float rad);
+	const SCP_vector<size_t>& getFilteredLights() const { return FilteredLights; }
 	bool setLights(const light_indexing_info *info);
 	void resetLightState();
 	light_indexing_info bufferLights();
@@ -204,71 +204,6 @@ matrix vm_matrix_new(vec3d rvec, vec3d uvec, vec3d fvec)
 	return m;
 }
 
-//adds two vectors, fills in dest, returns ptr to dest
-//ok for dest to equal either source, but should use vm_vec_add2() if so
-//dest = src0 + src1
-void vm_vec_add(vec3d *dest, const vec3d *src0, const vec3d *src1)
-{
-	dest->xyz.x = src0->xyz.x + src1->xyz.x;
-	dest->xyz.y = src0->xyz.y + src1->xyz.y;
-	dest->xyz.z = src0->xyz.z + src1->xyz.z;
-}
-
-//Component-wise multiplication of two vectors
-void vm_vec_cmult(vec3d* dest, const vec3d* src0, const vec3d* src1) {
-	dest->xyz.x = src0->xyz.x * src1->xyz.x;
-	dest->xyz.y = src0->xyz.y * src1->xyz.y;
-	dest->xyz.z = src0->xyz.z * src1->xyz.z;
-}
-void vm_vec_cmult2(vec3d* dest, const vec3d* src) {
-	dest->xyz.x *= src->xyz.x;
-	dest->xyz.y *= src->xyz.y;
-	dest->xyz.z *= src->xyz.z;
-}
-
-//Component-wise division of two vectors
-void vm_vec_cdiv(vec3d* dest, const vec3d* src0, const vec3d* src1) {
-	dest->xyz.x = src0->xyz.x / src1->xyz.x;
-	dest->xyz.y = src0->xyz.y / src1->xyz.y;
-	dest->xyz.z = src0->xyz.z / src1->xyz.z;
-}
-void vm_vec_cdiv2(vec3d* dest, const vec3d* src) {
-	dest->xyz.x /= src->xyz.x;
-	dest->xyz.y /= src->xyz.y;
-	dest->xyz.z /= src->xyz.z;
-}
-
-//subs two vectors, fills in dest, returns ptr to dest
-//ok for dest to equal either source, but should use vm_vec_sub2() if so
-//dest = src0 - src1
-void vm_vec_sub(vec3d *dest, const vec3d *src0, const vec3d *src1)
-{
-	dest->xyz.x = src0->xyz.x - src1->xyz.x;
-	dest->xyz.y = src0->xyz.y - src1->xyz.y;
-	dest->xyz.z = src0->xyz.z - src1->xyz.z;
-}
-
-
-//adds one vector to another. returns ptr to dest
-//dest can equal source
-//dest += src
-void vm_vec_add2(vec3d *dest, const vec3d *src)
-{
-	dest->xyz.x += src->xyz.x;
-	dest->xyz.y += src->xyz.y;
-	dest->xyz.z += src->xyz.z;
-}
-
-//subs one vector from another, returns ptr to dest
-//dest can equal source
-//dest -= src
-void vm_vec_sub2(vec3d *dest, const vec3d *src)
-{
-	dest->xyz.x -= src->xyz.x;
-	dest->xyz.y -= src->xyz.y;
-	dest->xyz.z -= src->xyz.z;
-}
-
 //averages n vectors. returns ptr to dest
 //dest can equal any vector in src[]
 //dest = sum(src[]) / n
@@ -339,70 +274,6 @@ vec3d *vm_vec_avg4(vec3d *dest, const vec3d *src0, const vec3d *src1, const vec3
 }
 
 
-//scales a vector in place.
-//dest *= s
-void vm_vec_scale(vec3d *dest, float s)
-{
-	dest->xyz.x = dest->xyz.x * s;
-	dest->xyz.y = dest->xyz.y * s;
-	dest->xyz.z = dest->xyz.z * s;
-}
-
-//scales a 4-component vector in place.
-// dest *= s
-void vm_vec_scale(vec4 *dest, float s)
-{
-	dest->xyzw.x = dest->xyzw.x * s;
-	dest->xyzw.y = dest->xyzw.y * s;
-	dest->xyzw.z = dest->xyzw.z * s;
-	dest->xyzw.w = dest->xyzw.w * s;
-}
-
-//scales and copies a vector.
-// dest = src * s
-void vm_vec_copy_scale(vec3d *dest, const vec3d *src, float s)
-{
-	dest->xyz.x = src->xyz.x*s;
-	dest->xyz.y = src->xyz.y*s;
-	dest->xyz.z = src->xyz.z*s;
-}
-
-//scales a vector, adds it to another, and stores in a 3rd vector
-//dest = src1 + k * src2
-void vm_vec_scale_add(vec3d *dest, const vec3d *src1, const vec3d *src2, float k)
-{
-	dest->xyz.x = src1->xyz.x + src2->xyz.x*k;
-	dest->xyz.y = src1->xyz.y + src2->xyz.y*k;
-	dest->xyz.z = src1->xyz.z + src2->xyz.z*k;
-}
-
-//scales a vector, subtracts it from another, and stores in a 3rd vector
-//dest = src1 - (k * src2)
-void vm_vec_scale_sub(vec3d *dest, const vec3d *src1, const vec3d *src2, float k)
-{
-	dest->xyz.x = src1->xyz.x - src2->xyz.x*k;
-	dest->xyz.y = src1->xyz.y - src2->xyz.y*k;
-	dest->xyz.z = src1->xyz.z - src2->xyz.z*k;
-}
-
-//scales a vector and adds it to another
-//dest += k * src
-void vm_vec_scale_add2(vec3d *dest, const vec3d *src, float k)
-{
-	dest->xyz.x += src->xyz.x*k;
-	dest->xyz.y += src->xyz.y*k;
-	dest->xyz.z += src->xyz.z*k;
-}
-
-//scales a vector and subtracts it from another
-//dest -= k * src
-void vm_vec_scale_sub2(vec3d *dest, const vec3d *src, float k)
-{
-	dest->xyz.x -= src->xyz.x*k;
-	dest->xyz.y -= src->xyz.y*k;
-	dest->xyz.z -= src->xyz.z*k;
-}
-
 //scales a vector in place, taking n/d for scale.
 //dest *= n/d
 void vm_vec_scale2(vec3d *dest, float n, float d)
@@ -424,64 +295,6 @@ void vm_vec_linear_interpolate(vec3d* dest, const vec3d* src0, const vec3d* src1
 	dest->xyz.z = ((src1->xyz.z - src0->xyz.z) * k) + src0->xyz.z;
 }
 
-//returns dot product of 2 vectors
-float vm_vec_dot(const vec3d *v0, const vec3d *v1)
-{
-	return (v1->xyz.x*v0->xyz.x)+(v1->xyz.y*v0->xyz.y)+(v1->xyz.z*v0->xyz.z);
-}
-
-
-//returns dot product of <x,y,z> and vector
-float vm_vec_dot3(float x, float y, float z, const vec3d *v)
-{
-	return (x*v->xyz.x)+(y*v->xyz.y)+(z*v->xyz.z);
-}
-
-//returns magnitude of a vector
-float vm_vec_mag(const vec3d *v)
-{
-	float mag1;
-
-	mag1 = (v->xyz.x * v->xyz.x) + (v->xyz.y * v->xyz.y) + (v->xyz.z * v->xyz.z);
-
-	if (mag1 <= 0.0f) {
-		return 0.0f;
-	}
-
-	return fl_sqrt(mag1);
-}
-
-//returns squared magnitude of a vector, useful if you want to compare distances
-float vm_vec_mag_squared(const vec3d *v)
-{
-	return ((v->xyz.x * v->xyz.x) + (v->xyz.y * v->xyz.y) + (v->xyz.z * v->xyz.z));
-}
-
-//returns the square of the difference between v0 and v1 (the distance, squared)
-//just like vm_vec_mag_squared, but the distance between two points instead.
-float vm_vec_dist_squared(const vec3d *v0, const vec3d *v1)
-{
-	float dx, dy, dz;
-
-	dx = v0->xyz.x - v1->xyz.x;
-	dy = v0->xyz.y - v1->xyz.y;
-	dz = v0->xyz.z - v1->xyz.z;
-	return dx*dx + dy*dy + dz*dz;
-}
-
-//computes the distance between two points. (does sub and mag)
-float vm_vec_dist(const vec3d *v0, const vec3d *v1)
-{
-	float t1;
-	vec3d t;
-
-	vm_vec_sub(&t,v0,v1);
-
-	t1 = vm_vec_mag(&t);
-
-	return t1;
-}
-
 bool vm_vec_is_normalized(const vec3d *v)
 {
 	// By the standards of FSO, it is sufficient to check that the magnitude is close to 1.
@@ -597,20 +410,6 @@ vec3d *vm_vec_normal(vec3d *dest, const vec3d *p0, const vec3d *p1, const vec3d
 }
 
 
-//computes cross product of two vectors.
-//Note: this magnitude of the resultant vector is the
-//product of the magnitudes of the two source vectors.  This means it is
-//quite easy for this routine to overflow and underflow.  Be careful that
-//your inputs are ok.
-vec3d *vm_vec_cross(vec3d *dest, const vec3d *src0, const vec3d *src1)
-{
-	dest->xyz.x = (src0->xyz.y * src1->xyz.z) - (src0->xyz.z * src1->xyz.y);
-	dest->xyz.y = (src0->xyz.z * src1->xyz.x) - (src0->xyz.x * src1->xyz.z);
-	dest->xyz.z = (src0->xyz.x * src1->xyz.y) - (src0->xyz.y * src1->xyz.x);
-
-	return dest;
-}
-
 int vm_test_parallel(const vec3d *src0, const vec3d *src1)
 {
 	vec3d partial1;
@@ -1055,26 +854,6 @@ matrix* vm_vector_2_matrix_uvec(matrix* m, const vec3d* fvec, const vec3d* uvec,
 }
 
 
-// rotates a vector through a matrix, writes to *dest and returns the pointer
-// if m is a rotation matrix it will preserve the length of *src, so normalised vectors will remain normalised
-vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m)
-{
-	*dest = (*m) * (*src);
-
-	return dest;
-}
-
-// like vm_vec_rotate, but uses the transpose matrix instead. for rotations, this is an inverse.
-vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m)
-{
-	matrix mt;
-
-	vm_copy_transpose(&mt, m);
-	*dest = mt * (*src);
-
-	return dest;
-}
-
 //transpose a matrix in place. returns ptr to matrix
 matrix *vm_transpose(matrix *m)
 {
@@ -1087,37 +866,6 @@ matrix *vm_transpose(matrix *m)
 	return m;
 }
 
-//copy and transpose a matrix. returns ptr to matrix
-//dest CANNOT equal source. use vm_transpose() if this is the case
-matrix *vm_copy_transpose(matrix *dest, const matrix *src)
-{
-	Assert(dest != src);
-
-	dest->vec.rvec.xyz.x = src->vec.rvec.xyz.x;
-	dest->vec.rvec.xyz.y = src->vec.uvec.xyz.x;
-	dest->vec.rvec.xyz.z = src->vec.fvec.xyz.x;
-
-	dest->vec.uvec.xyz.x = src->vec.rvec.xyz.y; //-V537
-	dest->vec.uvec.xyz.y = src->vec.uvec.xyz.y;
-	dest->vec.uvec.xyz.z = src->vec.fvec.xyz.y; //-V537
-
-	dest->vec.fvec.xyz.x = src->vec.rvec.xyz.z;
-	dest->vec.fvec.xyz.y = src->vec.uvec.xyz.z; //-V537
-	dest->vec.fvec.xyz.z = src->vec.fvec.xyz.z;
-
-
-	return dest;
-}
-
-// Old matrix multiplication routine. Note that the order of multiplication is inverted
-// compared to the mathematical standard: formally, this calculates src1 * src0
-matrix *vm_matrix_x_matrix(matrix *dest, const matrix *src0, const matrix *src1)
-{
-	*dest = (*src1) * (*src0);
-
-	return dest;
-}
-
 //extract angles from a matrix
 angles *vm_extract_angles_matrix(angles *a, const matrix *m)
 {
@@ -3032,6 +2780,35 @@ void vm_vec_transform(vec3d *dest, const vec3d *src, const matrix4 *m, bool pos)
 	dest->xyz.y = temp_dest.xyzw.y;
 	dest->xyz.z = temp_dest.xyzw.z;
 }
+
+// Copies the matrix into locals first, since the compiler can't otherwise tell that writing dest leaves it alone, and
+// reads each point into locals before writing it, so that dest may be src.  With that the loops vectorise, and they
+// do the same operations in the same order as vm_vec_unrotate().
+void vm_vec_unrotate_n(vec3d *dest, const vec3d *src, size_t count, const matrix *m, const vec3d *offset)
+{
+	const matrix mat = *m;
+
+	if (offset == nullptr) {
+		for (size_t i = 0; i < count; i++) {
+			const float x = src[i].xyz.x, y = src[i].xyz.y, z = src[i].xyz.z;
+
+			dest[i].xyz.x = (x * mat.vec.rvec.xyz.x) + (y * mat.vec.uvec.xyz.x) + (z * mat.vec.fvec.xyz.x);
+			dest[i].xyz.y = (x * mat.vec.rvec.xyz.y) + (y * mat.vec.uvec.xyz.y) + (z * mat.vec.fvec.xyz.y);
+			dest[i].xyz.z = (x * mat.vec.rvec.xyz.z) + (y * mat.vec.uvec.xyz.z) + (z * mat.vec.fvec.xyz.z);
+		}
+	} else {
+		const vec3d off = *offset;
+
+		for (size_t i = 0; i < count; i++) {
+			const float x = src[i].xyz.x, y = src[i].xyz.y, z = src[i].xyz.z;
+
+			dest[i].xyz.x = ((x * mat.vec.rvec.xyz.x) + (y * mat.vec.uvec.xyz.x) + (z * mat.vec.fvec.xyz.x)) + off.xyz.x;
+			dest[i].xyz.y = ((x * mat.vec.rvec.xyz.y) + (y * mat.vec.uvec.xyz.y) + (z * mat.vec.fvec.xyz.y)) + off.xyz.y;
+			dest[i].xyz.z = ((x * mat.vec.rvec.xyz.z) + (y * mat.vec.uvec.xyz.z) + (z * mat.vec.fvec.xyz.z)) + off.xyz.z;
+		}
+	}
+}
+
 vec3d vm_vec4_to_vec3(const vec4& vec) {
 	vec3d out;
 
@@ -113,34 +113,88 @@ typedef struct plane {
 
 //Functions in library
 
+// The basic operations below are defined here rather than in vecmat.cpp so that they get inlined wherever they are
+// used.  They are plain scalar code on purpose: once inlined, the compiler vectorises them at least as well as
+// hand written SSE does on three component vectors.
+
 //adds two vectors, fills in dest, returns ptr to dest
 //ok for dest to equal either source, but should use vm_vec_add2() if so
-void vm_vec_add(vec3d *dest, const vec3d *src0, const vec3d *src1);
+//dest = src0 + src1
+inline void vm_vec_add(vec3d *dest, const vec3d *src0, const vec3d *src1)
+{
+	dest->xyz.x = src0->xyz.x + src1->xyz.x;
+	dest->xyz.y = src0->xyz.y + src1->xyz.y;
+	dest->xyz.z = src0->xyz.z + src1->xyz.z;
+}
 
 //Component-wise multiplication of two vectors
-void vm_vec_cmult(vec3d* dest, const vec3d* src0, const vec3d* src1);
-void vm_vec_cmult2(vec3d* dest, const vec3d* src);
+inline void vm_vec_cmult(vec3d* dest, const vec3d* src0, const vec3d* src1)
+{
+	dest->xyz.x = src0->xyz.x * src1->xyz.x;
+	dest->xyz.y = src0->xyz.y * src1->xyz.y;
+	dest->xyz.z = src0->xyz.z * src1->xyz.z;
+}
+inline void vm_vec_cmult2(vec3d* dest, const vec3d* src)
+{
+	dest->xyz.x *= src->xyz.x;
+	dest->xyz.y *= src->xyz.y;
+	dest->xyz.z *= src->xyz.z;
+}
 
 //Component-wise division of two vectors
-void vm_vec_cdiv(vec3d* dest, const vec3d* src0, const vec3d* src1);
-void vm_vec_cdiv2(vec3d* dest, const vec3d* src);
+inline void vm_vec_cdiv(vec3d* dest, const vec3d* src0, const vec3d* src1)
+{
+	dest->xyz.x = src0->xyz.x / src1->xyz.x;
+	dest->xyz.y = src0->xyz.y / src1->xyz.y;
+	dest->xyz.z = src0->xyz.z / src1->xyz.z;
+}
+inline void vm_vec_cdiv2(vec3d* dest, const vec3d* src)
+{
+	dest->xyz.x /= src->xyz.x;
+	dest->xyz.y /= src->xyz.y;
+	dest->xyz.z /= src->xyz.z;
+}
 
 //adds src onto dest vector, returns ptr to dest
-void vm_vec_add2(vec3d *dest, const vec3d *src);
+//dest can equal source
+//dest += src
+inline void vm_vec_add2(vec3d *dest, const vec3d *src)
+{
+	dest->xyz.x += src->xyz.x;
+	dest->xyz.y += src->xyz.y;
+	dest->xyz.z += src->xyz.z;
+}
 
 
 //scales a vector and subs from to another
 //dest -= k * src
-void vm_vec_scale_sub2(vec3d *dest, const vec3d *src, float k);
+inline void vm_vec_scale_sub2(vec3d *dest, const vec3d *src, float k)
+{
+	dest->xyz.x -= src->xyz.x*k;
+	dest->xyz.y -= src->xyz.y*k;
+	dest->xyz.z -= src->xyz.z*k;
+}
 
 //subs two vectors, fills in dest, returns ptr to dest
 //ok for dest to equal either source, but should use vm_vec_sub2() if so
-void vm_vec_sub(vec3d *dest, const vec3d *src0, const vec3d *src1);
+//dest = src0 - src1
+inline void vm_vec_sub(vec3d *dest, const vec3d *src0, const vec3d *src1)
+{
+	dest->xyz.x = src0->xyz.x - src1->xyz.x;
+	dest->xyz.y = src0->xyz.y - src1->xyz.y;
+	dest->xyz.z = src0->xyz.z - src1->xyz.z;
+}
 
 
 //subs one vector from another, returns ptr to dest
 //dest can equal source
-void vm_vec_sub2(vec3d *dest, const vec3d *src);
+//dest -= src
+inline void vm_vec_sub2(vec3d *dest, const vec3d *src)
+{
+	dest->xyz.x -= src->xyz.x;
+	dest->xyz.y -= src->xyz.y;
+	dest->xyz.z -= src->xyz.z;
+}
 
 //averages n vectors
 vec3d *vm_vec_avg_n(vec3d *dest, int n, const vec3d src[]);
@@ -161,23 +215,58 @@ vec3d *vm_vec_avg3(vec3d *dest, const vec3d *src0, const vec3d *src1, const vec3
 vec3d *vm_vec_avg4(vec3d *dest, const vec3d *src0, const vec3d *src1, const vec3d *src2, const vec3d *src3);
 
 //scales a vector in place.  returns ptr to vector
-void vm_vec_scale(vec3d *dest, float s);
+//dest *= s
+inline void vm_vec_scale(vec3d *dest, float s)
+{
+	dest->xyz.x = dest->xyz.x * s;
+	dest->xyz.y = dest->xyz.y * s;
+	dest->xyz.z = dest->xyz.z * s;
+}
 
 //scales a 4-component vector in place. returns ptr to vector
-void vm_vec_scale(vec4 *dest, float s);
+inline void vm_vec_scale(vec4 *dest, float s)
+{
+	dest->xyzw.x = dest->xyzw.x * s;
+	dest->xyzw.y = dest->xyzw.y * s;
+	dest->xyzw.z = dest->xyzw.z * s;
+	dest->xyzw.w = dest->xyzw.w * s;
+}
 
 //scales and copies a vector.  returns ptr to dest
-void vm_vec_copy_scale(vec3d *dest, const vec3d *src, float s);
+//dest = src * s
+inline void vm_vec_copy_scale(vec3d *dest, const vec3d *src, float s)
+{
+	dest->xyz.x = src->xyz.x*s;
+	dest->xyz.y = src->xyz.y*s;
+	dest->xyz.z = src->xyz.z*s;
+}
 
 //scales a vector, adds it to another, and stores in a 3rd vector
 //dest = src1 + k * src2
-void vm_vec_scale_add(vec3d *dest, const vec3d *src1, const vec3d *src2, float k);
+inline void vm_vec_scale_add(vec3d *dest, const vec3d *src1, const vec3d *src2, float k)
+{
+	dest->xyz.x = src1->xyz.x + src2->xyz.x*k;
+	dest->xyz.y = src1->xyz.y + src2->xyz.y*k;
+	dest->xyz.z = src1->xyz.z + src2->xyz.z*k;
+}
 
-void vm_vec_scale_sub(vec3d *dest, const vec3d *src1, const vec3d *src2, float k);
+//scales a vector, subtracts it from another, and stores in a 3rd vector
+//dest = src1 - (k * src2)
+inline void vm_vec_scale_sub(vec3d *dest, const vec3d *src1, const vec3d *src2, float k)
+{
+	dest->xyz.x = src1->xyz.x - src2->xyz.x*k;
+	dest->xyz.y = src1->xyz.y - src2->xyz.y*k;
+	dest->xyz.z = src1->xyz.z - src2->xyz.z*k;
+}
 
 //scales a vector and adds it to another
 //dest += k * src
-void vm_vec_scale_add2(vec3d *dest, const vec3d *src, float k);
+inline void vm_vec_scale_add2(vec3d *dest, const vec3d *src, float k)
+{
+	dest->xyz.x += src->xyz.x*k;
+	dest->xyz.y += src->xyz.y*k;
+	dest->xyz.z += src->xyz.z*k;
+}
 
 //scales a vector in place, taking n/d for scale.  returns ptr to vector
 //dest *= n/d
@@ -205,17 +294,43 @@ float vm_vec_projection_parallel (vec3d *component, const vec3d *src, const vec3
 // finds the projection of source vector onto a surface given by surface normal
 void vm_vec_projection_onto_plane (vec3d *projection, const vec3d *src, const vec3d *normal);
 
+// returns the square of the magnitude of a vector (useful if comparing distances)
+constexpr float vm_vec_mag_squared(const vec3d* v)
+{
+	return ((v->xyz.x * v->xyz.x) + (v->xyz.y * v->xyz.y) + (v->xyz.z * v->xyz.z));
+}
+
 //returns magnitude of a vector
-float vm_vec_mag(const vec3d *v);
+inline float vm_vec_mag(const vec3d *v)
+{
+	float mag1 = vm_vec_mag_squared(v);
 
-// returns the square of the magnitude of a vector (useful if comparing distances)
-float vm_vec_mag_squared(const vec3d* v);
+	if (mag1 <= 0.0f) {
+		return 0.0f;
+	}
+
+	return fl_sqrt(mag1);
+}
 
 // returns the square of the distance between two points (fast and exact)
-float vm_vec_dist_squared(const vec3d *v0, const vec3d *v1);
+constexpr float vm_vec_dist_squared(const vec3d *v0, const vec3d *v1)
+{
+	float dx = v0->xyz.x - v1->xyz.x;
+	float dy = v0->xyz.y - v1->xyz.y;
+	float dz = v0->xyz.z - v1->xyz.z;
+
+	return dx*dx + dy*dy + dz*dz;
+}
 
 //computes the distance between two points. (does sub and mag)
-float vm_vec_dist(const vec3d *v0, const vec3d *v1);
+inline float vm_vec_dist(const vec3d *v0, const vec3d *v1)
+{
+	vec3d t;
+
+	vm_vec_sub(&t, v0, v1);
+
+	return vm_vec_mag(&t);
+}
 
 // these are now deprecated because experimental testing on Discord has found
 // that they are actually *slower* than their counterparts
@@ -244,13 +359,31 @@ float vm_vec_normalize_safe(vec3d *v, bool fallbackToZeroVec = false);
 float vm_vec_normalized_dir(vec3d *dest,const vec3d *end, const vec3d *start);
 
 ////returns dot product of two vectors
-float vm_vec_dot(const vec3d *v0, const vec3d *v1);
+constexpr float vm_vec_dot(const vec3d *v0, const vec3d *v1)
+{
+	return (v1->xyz.x*v0->xyz.x)+(v1->xyz.y*v0->xyz.y)+(v1->xyz.z*v0->xyz.z);
+}
 
-float vm_vec_dot3(float x, float y, float z, vec3d *v);
+//returns dot product of <x,y,z> and vector
+constexpr float vm_vec_dot3(float x, float y, float z, const vec3d *v)
+{
+	return (x*v->xyz.x)+(y*v->xyz.y)+(z*v->xyz.z);
+}
 
 //computes cross product of two vectors. returns ptr to dest
 //dest CANNOT equal either source
-vec3d *vm_vec_cross(vec3d *dest, const vec3d *src0, const vec3d *src1);
+//Note: this magnitude of the resultant vector is the
+//product of the magnitudes of the two source vectors.  This means it is
+//quite easy for this routine to overflow and underflow.  Be careful that
+//your inputs are ok.
+inline vec3d *vm_vec_cross(vec3d *dest, const vec3d *src0, const vec3d *src1)
+{
+	dest->xyz.x = (src0->xyz.y * src1->xyz.z) - (src0->xyz.z * src1->xyz.y);
+	dest->xyz.y = (src0->xyz.z * src1->xyz.x) - (src0->xyz.x * src1->xyz.z);
+	dest->xyz.z = (src0->xyz.x * src1->xyz.y) - (src0->xyz.y * src1->xyz.x);
+
+	return dest;
+}
 
 /**
  * @brief Tests if the two vectors are parallel
@@ -344,7 +477,19 @@ matrix* vm_vector_2_matrix_uvec(matrix* m, const vec3d* fvec = nullptr, const ve
 matrix *vm_vector_2_matrix_norm(matrix *m, const vec3d *fvec, const vec3d *uvec = nullptr, const vec3d *rvec = nullptr);
 
 //rotates a vector through a matrix. returns ptr to dest vector
-vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m);
+// if m is a rotation matrix it will preserve the length of *src, so normalised vectors will remain normalised
+inline vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m)
+{
+	// src may be dest
+	vec3d out;
+
+	out.xyz.x = vm_vec_dot(&m->vec.rvec, src);
+	out.xyz.y = vm_vec_dot(&m->vec.uvec, src);
+	out.xyz.z = vm_vec_dot(&m->vec.fvec, src);
+
+	*dest = out;
+	return dest;
+}
 
 //rotates a vector through the transpose of the given matrix. 
 //returns ptr to dest vector
@@ -357,17 +502,53 @@ vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m);
 // THIS DOES NOT ACTUALLY TRANSPOSE THE SOURCE MATRIX!!! So if
 // you need it transposed later on, you should use the 
 // vm_vec_transpose() / vm_vec_rotate() technique.
-vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m);
+inline vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m)
+{
+	// src may be dest
+	vec3d out;
+
+	out.xyz.x = (src->xyz.x*m->vec.rvec.xyz.x)+(src->xyz.y*m->vec.uvec.xyz.x)+(src->xyz.z*m->vec.fvec.xyz.x);
+	out.xyz.y = (src->xyz.x*m->vec.rvec.xyz.y)+(src->xyz.y*m->vec.uvec.xyz.y)+(src->xyz.z*m->vec.fvec.xyz.y);
+	out.xyz.z = (src->xyz.x*m->vec.rvec.xyz.z)+(src->xyz.y*m->vec.uvec.xyz.z)+(src->xyz.z*m->vec.fvec.xyz.z);
+
+	*dest = out;
+	return dest;
+}
+
+// Array form of vm_vec_unrotate(), for when a whole batch of points goes through the same matrix.  Each point comes
+// out as it would from vm_vec_unrotate(), up to rounding, but the loop is left for the compiler to vectorise.  If
+// offset is given it is added to every point after unrotating it, which takes a batch of model space points to world
+// space.  dest may be src, but the arrays must not overlap otherwise.
+void vm_vec_unrotate_n(vec3d *dest, const vec3d *src, size_t count, const matrix *m, const vec3d *offset = nullptr);
 
 //transpose a matrix in place. returns ptr to matrix
 matrix *vm_transpose(matrix *m);
 
 //copy and transpose a matrix. returns ptr to matrix
 //dest CANNOT equal source. use vm_transpose() if this is the case
-matrix *vm_copy_transpose(matrix *dest, const matrix *src);
+inline matrix *vm_copy_transpose(matrix *dest, const matrix *src)
+{
+	Assert(dest != src);
+
+	dest->vec.rvec.xyz.x = src->vec.rvec.xyz.x;
+	dest->vec.rvec.xyz.y = src->vec.uvec.xyz.x;
+	dest->vec.rvec.xyz.z = src->vec.fvec.xyz.x;
+
+	dest->vec.uvec.xyz.x = src->vec.rvec.xyz.y; //-V537
+	dest->vec.uvec.xyz.y = src->vec.uvec.xyz.y;
+	dest->vec.uvec.xyz.z = src->vec.fvec.xyz.y; //-V537
+
+	dest->vec.fvec.xyz.x = src->vec.rvec.xyz.z;
+	dest->vec.fvec.xyz.y = src->vec.uvec.xyz.z; //-V537
+	dest->vec.fvec.xyz.z = src->vec.fvec.xyz.z;
+
+	return dest;
+}
 
 //mulitply 2 matrices, fill in dest.  returns ptr to dest
-matrix *vm_matrix_x_matrix(matrix *dest, const matrix *src0, const matrix *src1);
+// Note that the order of multiplication is inverted compared to the mathematical standard: formally, this
+// calculates src1 * src0.  Defined below, after the matrix operators.
+inline matrix *vm_matrix_x_matrix(matrix *dest, const matrix *src0, const matrix *src1);
 
 //extract angles from a matrix
 angles *vm_extract_angles_matrix(angles *a, const matrix *m);
@@ -790,6 +971,13 @@ inline matrix operator*(const matrix& A, const matrix& B)
 	return out;
 }
 
+inline matrix *vm_matrix_x_matrix(matrix *dest, const matrix *src0, const matrix *src1)
+{
+	*dest = (*src1) * (*src0);
+
+	return dest;
+}
+
 std::ostream& operator<<(std::ostream& os, const vec3d& vec);
 
 // Given a direction and a 'stretch amount', computes a matrix which can be used to
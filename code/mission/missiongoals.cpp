@@ -34,6 +34,7 @@
 #include "parse/sexp.h"
 #include "playerman/player.h"
 #include "scripting/global_hooks.h"
+#include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 #include "ui/ui.h"
 
@@ -180,6 +181,13 @@ SCP_vector<mission_event> Mission_events;
 SCP_vector<mission_goal> Mission_goals;		// structure for the goals of this mission
 static goal_text Goal_text;
 
+// Goals and events that came out false aren't evaluated again until something their formula reads has changed;
+// see sexp_get_dependencies()
+static bool Skip_unchanged_formulas = true;
+DCF_BOOL(skip_unchanged_formulas, Skip_unchanged_formulas)
+
+MONITOR(NumSkippedFormulaEvals)
+
 #define DIRECTIVE_SOUND_DELAY			500					// time directive success sound effect is delayed
 #define DIRECTIVE_SPECIAL_DELAY		7000					// mark special directives as true after 7 seconds
 
@@ -880,6 +888,8 @@ void mission_process_event( int event )
 
 	int result, sindex;
 	bool bump_timestamp = false; 
+	bool logged = false;
+	uint stamp = 0;
 	Log_event = false;
 
 	Directive_count = 0;
@@ -962,16 +972,20 @@ void mission_process_event( int event )
 	}
 
 	if (sindex >= 0) {
+		// taken before evaluating, so that anything the event itself changes gets it evaluated again
+		stamp = sexp_dependency_stamp(Mission_events[event].dependencies);
+
 		Assume_event_is_current = true;
 		if (Snapshot_all_events || Mission_events[event].mission_log_flags != 0) {
 			Log_event = true;
+			logged = true;
 			
 			Current_event_log_buffer = &Mission_events[event].event_log_buffer;
 			Current_event_log_variable_buffer = &Mission_events[event].event_log_variable_buffer;
 			Current_event_log_container_buffer = &Mission_events[event].event_log_container_buffer;
 			Current_event_log_argument_buffer = &Mission_events[event].event_log_argument_buffer;
 		}
-		result = eval_sexp(sindex);
+		result = eval_sexp_program(sindex);
 
 		// if the directive count is a special value, deal with that first.  Mark the event as a special
 		// event, and unmark it when the directive is true again.
@@ -1074,12 +1088,33 @@ void mission_process_event( int event )
 		}
 	}
 
+	// an event that came out false and is still waiting to become true comes out false again until its inputs change
+	if ((sindex >= 0) && !result && !logged && !Mission_events[event].timestamp.isValid() && !(Mission_events[event].flags & MEF_EVENT_IS_DONE)) {
+		Mission_events[event].dependency_stamp = stamp;
+	} else {
+		Mission_events[event].dependency_stamp = 0;
+	}
+
+	if ((store_flags != Mission_events[event].flags) || (store_result != Mission_events[event].result)) {
+		sexp_dependencies_changed(SEXP_DEP_GOALS_AND_EVENTS);
+	}
+
 	// see if anything has changed	
 	if(MULTIPLAYER_MASTER && ((store_flags != Mission_events[event].flags) || (store_result != Mission_events[event].result) || (store_count != Mission_events[event].count)) ){
 		send_event_update_packet(event);
 	}
 }
 
+// Whether a goal or event would come out false again, because nothing its formula reads has changed since it last did
+static bool mission_formula_unchanged(int dependencies, uint dependency_stamp)
+{
+	// clients get their results from the host, and a snapshot wants every event in the log
+	if (!Skip_unchanged_formulas || MULTIPLAYER_CLIENT || Snapshot_all_events || (dependency_stamp == 0))
+		return false;
+
+	return sexp_dependency_stamp(dependencies) == dependency_stamp;
+}
+
 // Maybe play a directive success sound... need to poll since the sound is delayed from when
 // the directive is actually satisfied.
 void mission_maybe_play_directive_success_sound()
@@ -1094,6 +1129,7 @@ void mission_maybe_play_directive_success_sound()
 void mission_eval_goals()
 {
 	int i, result;
+	int num_skipped = 0;
 
 	// before checking whether or not we should evaluate goals, we should run through the events and
 	// process any whose timestamp is valid and has expired.  This would catch repeating events only
@@ -1122,12 +1158,22 @@ void mission_eval_goals()
 		}
 
 		if (Mission_goals[i].satisfied == GOAL_INCOMPLETE) {
-			result = eval_sexp(Mission_goals[i].formula);
+			if (mission_formula_unchanged(Mission_goals[i].dependencies, Mission_goals[i].dependency_stamp)) {
+				num_skipped++;
+				continue;
+			}
+
+			uint stamp = sexp_dependency_stamp(Mission_goals[i].dependencies);
+			Mission_goals[i].dependency_stamp = 0;
+
+			result = eval_sexp_program(Mission_goals[i].formula);
 			if ( Sexp_nodes[Mission_goals[i].formula].value == SEXP_KNOWN_FALSE ) {
 				mission_goal_status_change( i, GOAL_FAILED );
 
 			} else if (result) {
 				mission_goal_status_change(i, GOAL_COMPLETE );
+			} else {
+				Mission_goals[i].dependency_stamp = stamp;
 			} // end if result
 
 		}	// end if goals[i].satsified != GOAL_COMPLETE
@@ -1140,12 +1186,19 @@ void mission_eval_goals()
 			// we will evaluate repeatable events at the top of the file so we can get
 			// the exact interval that the designer asked for.
 			if ( !Mission_events[i].timestamp.isValid() ){
+				if (mission_formula_unchanged(Mission_events[i].dependencies, Mission_events[i].dependency_stamp)) {
+					num_skipped++;
+					continue;
+				}
+
 				TRACE_SCOPE(tracing::NonrepeatingEvents);
 				mission_process_event( i );
 			}
 		}
 	}
 
+	MONITOR_INC(NumSkippedFormulaEvals, num_skipped);
+
 	// send and remaining sexp data to the clients
 	if (MULTIPLAYER_MASTER) {
 		Current_sexp_network_packet.sexp_flush_packet();
@@ -1292,6 +1345,8 @@ void mission_goal_fail_incomplete()
 			Mission_events[i].result = 0;
 		}
 	}
+
+	sexp_dependencies_changed(SEXP_DEP_GOALS_AND_EVENTS);
 }
 
 // small function used to mark all objectives as true.  Used as a debug function and as a way
@@ -1317,6 +1372,8 @@ void mission_goal_mark_events_complete()
 		e.result = 1;
 		e.flags |= MEF_EVENT_IS_DONE;	// in lieu of setting formula to -1
 	}
+
+	sexp_dependencies_changed(SEXP_DEP_GOALS_AND_EVENTS);
 }
 
 // some debug console functions to help list and change the status of mission goals
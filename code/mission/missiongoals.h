@@ -59,6 +59,8 @@ typedef struct mission_goal {
 	int  score = 0;                         // score for this goal
 	int  flags = 0;                         // MGF_
 	int  team = 0;                          // which team is this objective for (defaults to the first team)
+	int  dependencies = -1;                 // SEXP_DEP_* flags of what the formula reads
+	uint dependency_stamp = 0;              // sexp_dependency_stamp() of the last evaluation that can be skipped next time, or 0
 } mission_goal;
 extern SCP_vector<mission_goal> Mission_goals;	// structure for the goals of this mission
 
@@ -114,6 +116,8 @@ typedef struct mission_event {
 	TIMESTAMP satisfied_time = TIMESTAMP::invalid();    // this is used to temporarily mark the directive as satisfied when the event isn't (e.g. for a destroyed wave when there are more waves later)
 	TIMESTAMP born_on_date = TIMESTAMP::invalid();      // timestamp at which event was born
 	int team = -1;                                      // for multiplayer games
+	int dependencies = -1;                              // SEXP_DEP_* flags of what the formula reads
+	uint dependency_stamp = 0;                          // sexp_dependency_stamp() of the last evaluation that can be skipped next time, or 0
 
 	// event log stuff
 	int mission_log_flags = 0;                          // flags that are used to determing which events are written to the log
@@ -18,6 +18,7 @@
 #include "network/multimsgs.h"
 #include "network/multiutil.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
 #include "playerman/player.h"
 #include "ship/ship.h"
 
@@ -53,6 +54,8 @@ void mission_log_add_entry(LogType type, const char *pname, const char *sname, i
 		return;
 	}
 
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
+
 	Log_entries.emplace_back();
 	auto &entry = Log_entries.back();
 
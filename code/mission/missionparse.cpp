@@ -7143,6 +7143,20 @@ bool post_process_mission(mission *pm)
 		}
 	}
 
+	// now that the formulas are known to be good, compile the ones that get evaluated over and over
+	if (!Fred_running) {
+		for (auto &event : Mission_events) {
+			sexp_compile_program(event.formula);
+
+			// whether a chained event runs also depends on when its neighbours became true
+			event.dependencies = (event.chain_delay >= 0) ? SEXP_DEP_ANYTHING : sexp_get_dependencies(event.formula);
+		}
+		for (auto &goal : Mission_goals) {
+			sexp_compile_program(goal.formula);
+			goal.dependencies = sexp_get_dependencies(goal.formula);
+		}
+	}
+
 	// multiplayer missions are handled just before mission start
 	if (!(Game_mode & GM_MULTIPLAYER) ){	
 		ai_post_process_mission();
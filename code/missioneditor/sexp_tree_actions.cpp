@@ -889,11 +889,11 @@ void SexpTreeActions::clipboard_paste_replace()
 		return;
 
 	// the following assumptions are made..
-	Assertion(Sexp_nodes[Sexp_clipboard].type != SEXP_NOT_USED, "SEXP clipboard node %d marked SEXP_NOT_USED (text '%s')", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text);
-	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_LIST, "SEXP clipboard node %d has invalid subtype SEXP_ATOM_LIST (text '%s')", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text);
+	Assertion(Sexp_nodes[Sexp_clipboard].type != SEXP_NOT_USED, "SEXP clipboard node %d marked SEXP_NOT_USED (text '%s')", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text);
+	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_LIST, "SEXP clipboard node %d has invalid subtype SEXP_ATOM_LIST (text '%s')", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text);
 	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_CONTAINER_NAME,
 		"Attempt to use container name %s from SEXP clipboard. Please report!",
-		Sexp_nodes[Sexp_clipboard].text);
+		Sexp_node_data[Sexp_clipboard].text);
 
 	if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_OPERATOR) {
 		expand_operator(_model.item_index);
@@ -905,10 +905,10 @@ void SexpTreeActions::clipboard_paste_replace()
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_CONTAINER_DATA) {
 		expand_operator(_model.item_index);
-		const auto* p_container = get_sexp_container(Sexp_nodes[Sexp_clipboard].text);
+		const auto* p_container = get_sexp_container(Sexp_node_data[Sexp_clipboard].text);
 		Assertion(p_container,
 			"Attempt to paste unknown container %s. Please report!",
-			Sexp_nodes[Sexp_clipboard].text);
+			Sexp_node_data[Sexp_clipboard].text);
 		const auto& container = *p_container;
 		// this should always be true, but just in case
 		const bool has_modifiers = (Sexp_nodes[Sexp_clipboard].first != -1);
@@ -922,10 +922,10 @@ void SexpTreeActions::clipboard_paste_replace()
 		}
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_NUMBER) {
-		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "Number atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
+		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "Number atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
 		if (Sexp_nodes[Sexp_clipboard].type & SEXP_FLAG_VARIABLE) {
-			int var_idx = get_index_sexp_variable_name(Sexp_nodes[Sexp_clipboard].text);
-			Assertion(var_idx > -1, "Invalid variable index: lookup of '%s' from clipboard NUMBER atom failed", Sexp_nodes[Sexp_clipboard].text);
+			int var_idx = get_index_sexp_variable_name(Sexp_node_data[Sexp_clipboard].text);
+			Assertion(var_idx > -1, "Invalid variable index: lookup of '%s' from clipboard NUMBER atom failed", Sexp_node_data[Sexp_clipboard].text);
 			replace_variable_data(var_idx, (SEXPT_VARIABLE | SEXPT_NUMBER | SEXPT_VALID));
 		} else {
 			expand_operator(_model.item_index);
@@ -933,10 +933,10 @@ void SexpTreeActions::clipboard_paste_replace()
 		}
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_STRING) {
-		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "String atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
+		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "String atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
 		if (Sexp_nodes[Sexp_clipboard].type & SEXP_FLAG_VARIABLE) {
-			int var_idx = get_index_sexp_variable_name(Sexp_nodes[Sexp_clipboard].text);
-			Assertion(var_idx > -1, "Invalid variable index: lookup of '%s' from clipboard STRING atom failed", Sexp_nodes[Sexp_clipboard].text);
+			int var_idx = get_index_sexp_variable_name(Sexp_node_data[Sexp_clipboard].text);
+			Assertion(var_idx > -1, "Invalid variable index: lookup of '%s' from clipboard STRING atom failed", Sexp_node_data[Sexp_clipboard].text);
 			replace_variable_data(var_idx, (SEXPT_VARIABLE | SEXPT_STRING | SEXPT_VALID));
 		} else {
 			expand_operator(_model.item_index);
@@ -944,7 +944,7 @@ void SexpTreeActions::clipboard_paste_replace()
 		}
 
 	} else
-		Assertion(0, "Unknown and/or invalid SEXP subtype %d on clipboard (node %d, type %d, text '%s')", Sexp_nodes[Sexp_clipboard].subtype, Sexp_clipboard, Sexp_nodes[Sexp_clipboard].type, Sexp_nodes[Sexp_clipboard].text);
+		Assertion(0, "Unknown and/or invalid SEXP subtype %d on clipboard (node %d, type %d, text '%s')", Sexp_nodes[Sexp_clipboard].subtype, Sexp_clipboard, Sexp_nodes[Sexp_clipboard].type, Sexp_node_data[Sexp_clipboard].text);
 
 	_ui.ui_expand_branch(_model.tree_nodes[_model.item_index].handle);
 }
@@ -959,11 +959,11 @@ void SexpTreeActions::clipboard_paste_add()
 		return;
 
 	// the following assumptions are made..
-	Assertion(Sexp_nodes[Sexp_clipboard].type != SEXP_NOT_USED, "SEXP clipboard node %d marked SEXP_NOT_USED (text '%s')", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text);
-	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_LIST, "SEXP clipboard node %d has invalid subtype SEXP_ATOM_LIST (text '%s')", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text);
+	Assertion(Sexp_nodes[Sexp_clipboard].type != SEXP_NOT_USED, "SEXP clipboard node %d marked SEXP_NOT_USED (text '%s')", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text);
+	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_LIST, "SEXP clipboard node %d has invalid subtype SEXP_ATOM_LIST (text '%s')", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text);
 	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_CONTAINER_NAME,
 		"Attempt to use container name %s from SEXP clipboard. Please report!",
-		Sexp_nodes[Sexp_clipboard].text);
+		Sexp_node_data[Sexp_clipboard].text);
 
 	if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_OPERATOR) {
 		expand_operator(_model.item_index);
@@ -975,32 +975,32 @@ void SexpTreeActions::clipboard_paste_add()
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_CONTAINER_DATA) {
 		expand_operator(_model.item_index);
-		add_container_data(Sexp_nodes[Sexp_clipboard].text);
+		add_container_data(Sexp_node_data[Sexp_clipboard].text);
 		const int modifier_node = Sexp_nodes[Sexp_clipboard].first;
 		if (modifier_node != -1) {
 			_model.load_branch(modifier_node, _model.item_index);
 			_ui.ui_add_children_visual(_model.item_index);
 		} else {
 			// this shouldn't happen, but just in case
-			const auto* p_container = get_sexp_container(Sexp_nodes[Sexp_clipboard].text);
+			const auto* p_container = get_sexp_container(Sexp_node_data[Sexp_clipboard].text);
 			Assertion(p_container,
 				"Attempt to add-paste unknown container %s. Please report!",
-				Sexp_nodes[Sexp_clipboard].text);
+				Sexp_node_data[Sexp_clipboard].text);
 			add_default_modifier(*p_container);
 		}
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_NUMBER) {
-		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "Number atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
+		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "Number atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
 		expand_operator(_model.item_index);
 		add_data(CTEXT(Sexp_clipboard), (SEXPT_NUMBER | SEXPT_VALID));
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_STRING) {
-		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "String atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_nodes[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
+		Assertion(Sexp_nodes[Sexp_clipboard].rest == -1, "String atom on SEXP clipboard (node %d, text '%s') unexpectedly has rest=%d", Sexp_clipboard, Sexp_node_data[Sexp_clipboard].text, Sexp_nodes[Sexp_clipboard].rest);
 		expand_operator(_model.item_index);
 		add_data(CTEXT(Sexp_clipboard), (SEXPT_STRING | SEXPT_VALID));
 
 	} else
-		Assertion(0, "Unknown and/or invalid SEXP subtype %d on clipboard (node %d, type %d, text '%s')", Sexp_nodes[Sexp_clipboard].subtype, Sexp_clipboard, Sexp_nodes[Sexp_clipboard].type, Sexp_nodes[Sexp_clipboard].text);
+		Assertion(0, "Unknown and/or invalid SEXP subtype %d on clipboard (node %d, type %d, text '%s')", Sexp_nodes[Sexp_clipboard].subtype, Sexp_clipboard, Sexp_nodes[Sexp_clipboard].type, Sexp_node_data[Sexp_clipboard].text);
 
 	_ui.ui_expand_branch(_model.tree_nodes[_model.item_index].handle);
 }
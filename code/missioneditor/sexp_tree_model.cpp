@@ -467,7 +467,7 @@ void SexpTreeModel::load_tree_data(int index, const char* deflt)
 
 	if (Sexp_nodes[index].subtype == SEXP_ATOM_NUMBER) {
 		cur = allocate_node(-1);
-		if (atoi(Sexp_nodes[index].text))
+		if (atoi(Sexp_node_data[index].text))
 			set_node(cur, (SEXPT_OPERATOR | SEXPT_VALID), "true");
 		else
 			set_node(cur, (SEXPT_OPERATOR | SEXPT_VALID), "false");
@@ -506,44 +506,44 @@ int SexpTreeModel::load_branch(int index, int parent)
 				flag = 1;
 			}
 
-			set_node(cur, (SEXPT_OPERATOR | additional_flags), Sexp_nodes[index].text);
+			set_node(cur, (SEXPT_OPERATOR | additional_flags), Sexp_node_data[index].text);
 			load_branch(Sexp_nodes[index].rest, cur);
 			return cur;
 
 		} else if (Sexp_nodes[index].subtype == SEXP_ATOM_NUMBER) {
 			cur = allocate_node(parent);
 			if (Sexp_nodes[index].type & SEXP_FLAG_VARIABLE) {
-				get_combined_variable_name(combined_var_name, Sexp_nodes[index].text);
+				get_combined_variable_name(combined_var_name, Sexp_node_data[index].text);
 				set_node(cur, (SEXPT_VARIABLE | SEXPT_NUMBER | additional_flags), combined_var_name);
 			} else {
-				set_node(cur, (SEXPT_NUMBER | additional_flags), Sexp_nodes[index].text);
+				set_node(cur, (SEXPT_NUMBER | additional_flags), Sexp_node_data[index].text);
 			}
 
 		} else if (Sexp_nodes[index].subtype == SEXP_ATOM_STRING) {
 			cur = allocate_node(parent);
 			if (Sexp_nodes[index].type & SEXP_FLAG_VARIABLE) {
-				get_combined_variable_name(combined_var_name, Sexp_nodes[index].text);
+				get_combined_variable_name(combined_var_name, Sexp_node_data[index].text);
 				set_node(cur, (SEXPT_VARIABLE | SEXPT_STRING | additional_flags), combined_var_name);
 			} else {
-				set_node(cur, (SEXPT_STRING | additional_flags), Sexp_nodes[index].text);
+				set_node(cur, (SEXPT_STRING | additional_flags), Sexp_node_data[index].text);
 			}
 
 		} else if (Sexp_nodes[index].subtype == SEXP_ATOM_CONTAINER_NAME) {
 			Assertion(!(additional_flags & SEXPT_MODIFIER),
 				"Found a container name node %s that is also a container modifier. Please report!",
-				Sexp_nodes[index].text);
-			Assertion(get_sexp_container(Sexp_nodes[index].text) != nullptr,
+				Sexp_node_data[index].text);
+			Assertion(get_sexp_container(Sexp_node_data[index].text) != nullptr,
 				"Attempt to load unknown container data %s into SEXP tree. Please report!",
-				Sexp_nodes[index].text);
+				Sexp_node_data[index].text);
 			cur = allocate_node(parent);
-			set_node(cur, (SEXPT_CONTAINER_NAME | SEXPT_STRING | additional_flags), Sexp_nodes[index].text);
+			set_node(cur, (SEXPT_CONTAINER_NAME | SEXPT_STRING | additional_flags), Sexp_node_data[index].text);
 
 		} else if (Sexp_nodes[index].subtype == SEXP_ATOM_CONTAINER_DATA) {
 			cur = allocate_node(parent);
-			Assertion(get_sexp_container(Sexp_nodes[index].text) != nullptr,
+			Assertion(get_sexp_container(Sexp_node_data[index].text) != nullptr,
 				"Attempt to load unknown container data %s into SEXP tree. Please report!",
-				Sexp_nodes[index].text);
-			set_node(cur, (SEXPT_CONTAINER_DATA | SEXPT_STRING | additional_flags), Sexp_nodes[index].text);
+				Sexp_node_data[index].text);
+			set_node(cur, (SEXPT_CONTAINER_DATA | SEXPT_STRING | additional_flags), Sexp_node_data[index].text);
 			load_branch(Sexp_nodes[index].first, cur);
 
 		} else
@@ -1882,7 +1882,7 @@ void SexpTreeModel::ctx_validate_clipboard(SexpContextMenuState& state, int repl
 	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_LIST, "Invalid SEXP node subtype");
 	Assertion(Sexp_nodes[Sexp_clipboard].subtype != SEXP_ATOM_CONTAINER_NAME,
 		"Attempt to use container name %s from SEXP clipboard. Please report!",
-		Sexp_nodes[Sexp_clipboard].text);
+		Sexp_node_data[Sexp_clipboard].text);
 
 	if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_OPERATOR) {
 		int j = get_operator_const(CTEXT(Sexp_clipboard));
@@ -1903,7 +1903,7 @@ void SexpTreeModel::ctx_validate_clipboard(SexpContextMenuState& state, int repl
 			state.can_paste_add = true;
 
 	} else if (Sexp_nodes[Sexp_clipboard].subtype == SEXP_ATOM_CONTAINER_DATA) {
-		const auto* p_container = get_sexp_container(Sexp_nodes[Sexp_clipboard].text);
+		const auto* p_container = get_sexp_container(Sexp_node_data[Sexp_clipboard].text);
 		if (p_container != nullptr) {
 			const auto& container = *p_container;
 			if (any(container.type & ContainerType::NUMBER_DATA)) {
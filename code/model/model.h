@@ -405,6 +405,15 @@ struct bsp_collision_node {
 	int leaf;
 };
 
+// Depth first copy of a bsp_collision_node list. The first child of a node is stored right after it,
+// so only the second child needs an index. Nodes that can't lead to any polygons are left out.
+struct alignas(32) bsp_collision_flat_node {
+	vec3d min;
+	int second_child;	// -1 if there is at most one child
+	vec3d max;
+	int leaf;			// first polygon in the leaf list, -1 if this isn't a leaf node
+};
+
 struct bsp_collision_leaf {
 	vec3d plane_norm;
 	int vert_start;
@@ -412,6 +421,22 @@ struct bsp_collision_leaf {
 	ubyte tmap_num;
 
 	int next;
+
+	int tri_start;	// first of the num_verts - 2 fan triangles of this polygon in the tree's tri_blocks
+};
+
+#define MC_TRI_BLOCK_SIZE	4
+
+// The leaf polygons split into fan triangles and stored component-wise, so that a ray or swept sphere can be
+// checked against MC_TRI_BLOCK_SIZE triangles at once before doing the exact check on a single polygon.
+struct bsp_collision_tri_block {
+	float plane_norm[3][MC_TRI_BLOCK_SIZE];	// normal of the polygon the triangle belongs to
+	float base[3][MC_TRI_BLOCK_SIZE];			// first vertex of the polygon, shared by all of its fan triangles
+	float axis_u[3][MC_TRI_BLOCK_SIZE];		// the two axes the polygon is projected onto, same as fvi_point_face()
+	float axis_v[3][MC_TRI_BLOCK_SIZE];
+	float bary[4][MC_TRI_BLOCK_SIZE];			// inverse of the projected edges, gives the barycentric coordinates
+	float center[3][MC_TRI_BLOCK_SIZE];		// bounding sphere of the triangle
+	float radius[MC_TRI_BLOCK_SIZE];
 };
 
 struct bsp_collision_tree {
@@ -425,6 +450,12 @@ struct bsp_collision_tree {
 	vec3d *point_list;
 	SCP_vector<vec3d> poly_centers;
 
+	bsp_collision_tri_block *tri_blocks;
+	int n_tri_blocks;
+
+	SCP_vector<bsp_collision_flat_node> flat_nodes;
+	int flat_depth;
+
 	int n_verts;
 	bool used;
 };
@@ -1423,6 +1454,20 @@ typedef struct mc_info {
 int model_collide(mc_info *mc_info_obj);
 void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int version);
 
+// Collision trees of all submodels can be cached in data/cache, so they don't need to be parsed again
+bool model_collide_load_bsp_cache(polymodel *pm);
+void model_collide_save_bsp_cache(polymodel *pm);
+
+// Checks a ray or sphere directly against a single collision tree in its own frame of reference, without
+// any submodel handling. Only for trees with untextured polygons, meant for testing the tree layouts.
+int model_collide_tree(bsp_collision_tree *tree, mc_info *mc_info_obj, bool flat_layout);
+
+// Set to false to walk node_list recursively instead of using the flattened nodes
+extern bool Model_collide_flat_bsp;
+
+// Set to false to check every polygon of a leaf with the exact face checks only
+extern bool Model_collide_batch_tris;
+
 bsp_collision_tree *model_get_bsp_collision_tree(int tree_index);
 void model_remove_bsp_collision_tree(int tree_index);
 int model_create_bsp_collision_tree();
@@ -12,7 +12,10 @@
 
 #define MODEL_LIB
 
+#include "cfile/cfile.h"
+#include "cfile/cfilesystem.h"
 #include "cmdline/cmdline.h"
+#include "debugconsole/console.h"
 #include "graphics/tmapper.h"
 #include "math/fvi.h"
 #include "math/vecmat.h"
@@ -23,9 +26,19 @@
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MC_TRI_BLOCK_SSE
+#include <emmintrin.h>
+#endif
+
+#include <md5.h>
+
 #define TOL		1E-4
 #define DIST_TOL	1.0
 
+bool Model_collide_flat_bsp = true;
+DCF_BOOL(model_collide_flat_bsp, Model_collide_flat_bsp);
+
 // Some global variables that get set by model_collide and are used internally for
 // checking a collision rather than passing a bunch of parameters around. These are
 // not persistant between calls to model_collide
@@ -381,6 +394,179 @@ int model_collide_parse_bsp_defpoints(ubyte * p)
 	return nverts;
 }
 
+bool Model_collide_batch_tris = true;
+DCF_BOOL(model_collide_batch, Model_collide_batch_tris);
+
+// Slack given to the batched triangle checks, so that they never reject a polygon the exact
+// checks would have hit because of the different order of float operations.
+#define MC_TRI_BLOCK_TOL			1E-3f
+// fvi_polyedge_sphereline() accepts edge hits up to 0.1 units past the sphere radius and at
+// sphere times down to -0.05, so the swept sphere check has to be that generous too.
+#define MC_TRI_BLOCK_SPHERE_TOL		0.2f
+#define MC_TRI_BLOCK_SPHERE_T_MIN	-0.05f
+
+// Returns a bit mask of the triangles in the block the ray may hit between 0 and t_max.
+static uint mc_tri_block_check_ray(const bsp_collision_tri_block *block, const vec3d *p0, const vec3d *dir, float t_max)
+{
+#ifdef MC_TRI_BLOCK_SSE
+	const __m128 px = _mm_set1_ps(p0->xyz.x), py = _mm_set1_ps(p0->xyz.y), pz = _mm_set1_ps(p0->xyz.z);
+	const __m128 dx = _mm_set1_ps(dir->xyz.x), dy = _mm_set1_ps(dir->xyz.y), dz = _mm_set1_ps(dir->xyz.z);
+
+	const __m128 nx = _mm_loadu_ps(block->plane_norm[0]);
+	const __m128 ny = _mm_loadu_ps(block->plane_norm[1]);
+	const __m128 nz = _mm_loadu_ps(block->plane_norm[2]);
+
+	// distance along the ray to the polygon plane
+	__m128 wx = _mm_sub_ps(_mm_loadu_ps(block->base[0]), px);
+	__m128 wy = _mm_sub_ps(_mm_loadu_ps(block->base[1]), py);
+	__m128 wz = _mm_sub_ps(_mm_loadu_ps(block->base[2]), pz);
+
+	__m128 num = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, wx), _mm_mul_ps(ny, wy)), _mm_mul_ps(nz, wz));
+	__m128 den = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, dx), _mm_mul_ps(ny, dy)), _mm_mul_ps(nz, dz));
+	__m128 t = _mm_div_ps(num, den);
+
+	// hit point relative to the first polygon vertex, projected onto the polygon's axes
+	wx = _mm_sub_ps(_mm_mul_ps(dx, t), wx);
+	wy = _mm_sub_ps(_mm_mul_ps(dy, t), wy);
+	wz = _mm_sub_ps(_mm_mul_ps(dz, t), wz);
+
+	__m128 u = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block->axis_u[0]), wx), _mm_mul_ps(_mm_loadu_ps(block->axis_u[1]), wy)), _mm_mul_ps(_mm_loadu_ps(block->axis_u[2]), wz));
+	__m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block->axis_v[0]), wx), _mm_mul_ps(_mm_loadu_ps(block->axis_v[1]), wy)), _mm_mul_ps(_mm_loadu_ps(block->axis_v[2]), wz));
+
+	__m128 alpha = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block->bary[0]), u), _mm_mul_ps(_mm_loadu_ps(block->bary[1]), v));
+	__m128 beta = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block->bary[2]), u), _mm_mul_ps(_mm_loadu_ps(block->bary[3]), v));
+
+	const __m128 tol = _mm_set1_ps(-MC_TRI_BLOCK_TOL);
+
+	__m128 hit = _mm_and_ps(_mm_cmpge_ps(t, tol), _mm_cmple_ps(t, _mm_set1_ps(t_max + MC_TRI_BLOCK_TOL)));
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(alpha, tol));
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(beta, tol));
+	hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(alpha, beta), _mm_set1_ps(1.0f + MC_TRI_BLOCK_TOL)));
+
+	return (uint)_mm_movemask_ps(hit);
+#else
+	uint hits = 0;
+
+	for (int i = 0; i < MC_TRI_BLOCK_SIZE; i++) {
+		vec3d w;
+		w.xyz.x = block->base[0][i] - p0->xyz.x;
+		w.xyz.y = block->base[1][i] - p0->xyz.y;
+		w.xyz.z = block->base[2][i] - p0->xyz.z;
+
+		float num = block->plane_norm[0][i] * w.xyz.x + block->plane_norm[1][i] * w.xyz.y + block->plane_norm[2][i] * w.xyz.z;
+		float den = block->plane_norm[0][i] * dir->xyz.x + block->plane_norm[1][i] * dir->xyz.y + block->plane_norm[2][i] * dir->xyz.z;
+		float t = num / den;
+
+		if (!(t >= -MC_TRI_BLOCK_TOL && t <= t_max + MC_TRI_BLOCK_TOL)) {
+			continue;
+		}
+
+		w.xyz.x = dir->xyz.x * t - w.xyz.x;
+		w.xyz.y = dir->xyz.y * t - w.xyz.y;
+		w.xyz.z = dir->xyz.z * t - w.xyz.z;
+
+		float u = block->axis_u[0][i] * w.xyz.x + block->axis_u[1][i] * w.xyz.y + block->axis_u[2][i] * w.xyz.z;
+		float v = block->axis_v[0][i] * w.xyz.x + block->axis_v[1][i] * w.xyz.y + block->axis_v[2][i] * w.xyz.z;
+
+		float alpha = block->bary[0][i] * u + block->bary[1][i] * v;
+		float beta = block->bary[2][i] * u + block->bary[3][i] * v;
+
+		if (alpha >= -MC_TRI_BLOCK_TOL && beta >= -MC_TRI_BLOCK_TOL && alpha + beta <= 1.0f + MC_TRI_BLOCK_TOL) {
+			hits |= 1u << i;
+		}
+	}
+
+	return hits;
+#endif
+}
+
+// Returns a bit mask of the triangles in the block whose bounding sphere the swept sphere may touch.
+static uint mc_tri_block_check_sphereline(const bsp_collision_tri_block *block, const vec3d *p0, const vec3d *dir, float inv_dir_mag_sq, float radius)
+{
+#ifdef MC_TRI_BLOCK_SSE
+	const __m128 px = _mm_set1_ps(p0->xyz.x), py = _mm_set1_ps(p0->xyz.y), pz = _mm_set1_ps(p0->xyz.z);
+	const __m128 dx = _mm_set1_ps(dir->xyz.x), dy = _mm_set1_ps(dir->xyz.y), dz = _mm_set1_ps(dir->xyz.z);
+
+	__m128 cx = _mm_sub_ps(_mm_loadu_ps(block->center[0]), px);
+	__m128 cy = _mm_sub_ps(_mm_loadu_ps(block->center[1]), py);
+	__m128 cz = _mm_sub_ps(_mm_loadu_ps(block->center[2]), pz);
+
+	// closest point to the triangle center along the path of the sphere
+	__m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, dx), _mm_mul_ps(cy, dy)), _mm_mul_ps(cz, dz));
+	t = _mm_mul_ps(t, _mm_set1_ps(inv_dir_mag_sq));
+	t = _mm_min_ps(_mm_max_ps(t, _mm_set1_ps(MC_TRI_BLOCK_SPHERE_T_MIN)), _mm_set1_ps(1.0f));
+
+	cx = _mm_sub_ps(cx, _mm_mul_ps(dx, t));
+	cy = _mm_sub_ps(cy, _mm_mul_ps(dy, t));
+	cz = _mm_sub_ps(cz, _mm_mul_ps(dz, t));
+
+	__m128 dist_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+	__m128 reach = _mm_add_ps(_mm_loadu_ps(block->radius), _mm_set1_ps(radius));
+
+	return (uint)_mm_movemask_ps(_mm_cmple_ps(dist_sq, _mm_mul_ps(reach, reach)));
+#else
+	uint hits = 0;
+
+	for (int i = 0; i < MC_TRI_BLOCK_SIZE; i++) {
+		vec3d c;
+		c.xyz.x = block->center[0][i] - p0->xyz.x;
+		c.xyz.y = block->center[1][i] - p0->xyz.y;
+		c.xyz.z = block->center[2][i] - p0->xyz.z;
+
+		float t = (c.xyz.x * dir->xyz.x + c.xyz.y * dir->xyz.y + c.xyz.z * dir->xyz.z) * inv_dir_mag_sq;
+		CLAMP(t, MC_TRI_BLOCK_SPHERE_T_MIN, 1.0f);
+
+		c.xyz.x -= dir->xyz.x * t;
+		c.xyz.y -= dir->xyz.y * t;
+		c.xyz.z -= dir->xyz.z * t;
+
+		float reach = block->radius[i] + radius;
+
+		if (c.xyz.x * c.xyz.x + c.xyz.y * c.xyz.y + c.xyz.z * c.xyz.z <= reach * reach) {
+			hits |= 1u << i;
+		}
+	}
+
+	return hits;
+#endif
+}
+
+// Checks the fan triangles of a leaf polygon against the batched triangle data, keeping the result of
+// the last checked block around since the polygons of a leaf list are stored next to each other.
+static bool mc_leaf_may_hit(bsp_collision_tree *tree, bsp_collision_leaf *leaf, int *checked_block, uint *block_hits)
+{
+	if (leaf->num_verts < 3) {
+		return true;
+	}
+
+	int tri_end = leaf->tri_start + leaf->num_verts - 2;
+
+	for (int tri = leaf->tri_start; tri < tri_end; ++tri) {
+		int block = tri / MC_TRI_BLOCK_SIZE;
+
+		if (block != *checked_block) {
+			*checked_block = block;
+
+			if (Mc->flags & MC_CHECK_SPHERELINE) {
+				float dir_mag_sq = vm_vec_mag_squared(&Mc_direction);
+				float inv_dir_mag_sq = (dir_mag_sq > 0.0f) ? (1.0f / dir_mag_sq) : 0.0f;
+
+				*block_hits = mc_tri_block_check_sphereline(&tree->tri_blocks[block], &Mc_p0, &Mc_direction, inv_dir_mag_sq, Mc->radius * (1.0f + MC_TRI_BLOCK_TOL) + MC_TRI_BLOCK_SPHERE_TOL);
+			} else {
+				float t_max = (Mc->flags & MC_CHECK_RAY) ? FLT_MAX : 1.0f;
+
+				*block_hits = mc_tri_block_check_ray(&tree->tri_blocks[block], &Mc_p0, &Mc_direction, t_max);
+			}
+		}
+
+		if (*block_hits & (1u << (tri % MC_TRI_BLOCK_SIZE))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 {
 	int i;
@@ -388,6 +574,11 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 	uv_pair uvlist[TMAP_MAX_VERTS];
 	vec3d *points[TMAP_MAX_VERTS];
 
+	// an infinite swept sphere has no useful bounds, so that only goes through the exact checks
+	bool batch_checks = Model_collide_batch_tris && (tree->tri_blocks != nullptr) && ((Mc->flags & (MC_CHECK_SPHERELINE | MC_CHECK_RAY)) != (MC_CHECK_SPHERELINE | MC_CHECK_RAY));
+	int checked_block = -1;
+	uint block_hits = 0;
+
 	while ( tested_leaf >= 0 ) {
 		bsp_collision_leaf *leaf = &tree->leaf_list[tested_leaf];
 
@@ -406,6 +597,11 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 			flat_poly = true;
 		}
 
+		if ( batch_checks && !mc_leaf_may_hit(tree, leaf, &checked_block, &block_hits) ) {
+			tested_leaf = leaf->next;
+			continue;
+		}
+
 		int vert_num;
 		for ( i = 0; i < nv; ++i ) {
 			vert_num = tree->vert_list[vert_start+i].vertnum;
@@ -433,31 +629,156 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 	}
 }
 
-void model_collide_bsp(bsp_collision_tree *tree, int node_index)
+// The boxes are grown a bit for the slab test. fvi_ray_boundingbox() can reject a ray that enters a box right
+// through one of its edges because of rounding, which lets the ray slip through the seam between two leaves.
+#define MC_BSP_BOX_TOL		0.01f
+
+// Box check of both tree walks, with everything that only depends on the ray worked out once per tree instead
+// of once per node
+struct mc_bsp_ray {
+	vec3d inv_dir;
+	bool parallel[3];
+	float t_max;
+	float grow;
+};
+
+static void mc_bsp_ray_init(mc_bsp_ray *ray)
 {
-	if ( tree->node_list == NULL || tree->n_verts <= 0) {
-		return;
+	for (int i = 0; i < 3; ++i) {
+		ray->parallel[i] = (Mc_direction.a1d[i] == 0.0f);
+		ray->inv_dir.a1d[i] = ray->parallel[i] ? 0.0f : (1.0f / Mc_direction.a1d[i]);
 	}
 
-	bsp_collision_node *node = &tree->node_list[node_index];
-	vec3d hitpos;
+	// a little past the end of the ray, to go with the grown boxes
+	ray->t_max = (Mc->flags & MC_CHECK_RAY) ? FLT_MAX : (1.0f + MC_BSP_BOX_TOL);
+	ray->grow = MC_BSP_BOX_TOL;
 
-	// check the bounding box of this node. if it passes, check left and right children
-	if ( mc_ray_boundingbox( &node->min, &node->max, &Mc_p0, &Mc_direction, &hitpos ) ) {
-		if ( !(Mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &Mc_p0) > Mc_mag) ) {
-			// The ray isn't long enough to intersect the bounding box
-			return;
+	if ( Mc->flags & MC_CHECK_SPHERELINE ) {
+		ray->grow += Mc->radius;
+	}
+}
+
+static bool mc_bsp_ray_box(const mc_bsp_ray *ray, const vec3d *box_min, const vec3d *box_max)
+{
+	float t_enter = 0.0f;
+	float t_exit = ray->t_max;
+
+	for (int i = 0; i < 3; ++i) {
+		float min = box_min->a1d[i] - ray->grow;
+		float max = box_max->a1d[i] + ray->grow;
+
+		if ( ray->parallel[i] ) {
+			if ( Mc_p0.a1d[i] < min || Mc_p0.a1d[i] > max ) {
+				return false;
+			}
+			continue;
+		}
+
+		float t0 = (min - Mc_p0.a1d[i]) * ray->inv_dir.a1d[i];
+		float t1 = (max - Mc_p0.a1d[i]) * ray->inv_dir.a1d[i];
+
+		if ( t0 > t1 ) {
+			std::swap(t0, t1);
+		}
+
+		t_enter = MAX(t_enter, t0);
+		t_exit = MIN(t_exit, t1);
+
+		if ( t_enter > t_exit ) {
+			return false;
 		}
+	}
+
+	return true;
+}
 
+static void model_collide_bsp_node(bsp_collision_tree *tree, const mc_bsp_ray *ray, int node_index)
+{
+	bsp_collision_node *node = &tree->node_list[node_index];
+
+	// check the bounding box of this node. if it passes, check left and right children
+	if ( mc_bsp_ray_box( ray, &node->min, &node->max ) ) {
 		if ( node->leaf >= 0 ) {
 			model_collide_bsp_poly(tree, node->leaf);
 		} else {
-			if ( node->back >= 0 ) model_collide_bsp(tree, node->back);
-			if ( node->front >= 0 ) model_collide_bsp(tree, node->front);
+			if ( node->back >= 0 ) model_collide_bsp_node(tree, ray, node->back);
+			if ( node->front >= 0 ) model_collide_bsp_node(tree, ray, node->front);
 		}
 	}
 }
 
+void model_collide_bsp(bsp_collision_tree *tree, int node_index)
+{
+	if ( tree->node_list == NULL || tree->n_verts <= 0) {
+		return;
+	}
+
+	mc_bsp_ray ray;
+	mc_bsp_ray_init(&ray);
+
+	model_collide_bsp_node(tree, &ray, node_index);
+}
+
+// Trees no deeper than this walk the flattened nodes with a stack on the stack
+#define MC_BSP_STACK_SIZE	64
+
+static void model_collide_bsp_flat(bsp_collision_tree *tree)
+{
+	if ( tree->flat_nodes.empty() || tree->n_verts <= 0 ) {
+		return;
+	}
+
+	mc_bsp_ray ray;
+	mc_bsp_ray_init(&ray);
+
+	int local_stack[MC_BSP_STACK_SIZE];
+	int *stack = local_stack;
+
+	if ( tree->flat_depth > MC_BSP_STACK_SIZE ) {
+		thread_local SCP_vector<int> deep_stack;
+
+		deep_stack.resize(tree->flat_depth);
+		stack = deep_stack.data();
+	}
+
+	int stack_size = 0;
+	int node_index = 0;
+
+	// same order as model_collide_bsp(), the first child of a node is its back child
+	for (;;) {
+		const bsp_collision_flat_node *node = &tree->flat_nodes[node_index];
+
+		if ( mc_bsp_ray_box(&ray, &node->min, &node->max) ) {
+			if ( node->leaf >= 0 ) {
+				model_collide_bsp_poly(tree, node->leaf);
+			} else {
+				if ( node->second_child >= 0 ) {
+					stack[stack_size++] = node->second_child;
+				}
+
+				++node_index;
+				continue;
+			}
+		}
+
+		if ( stack_size == 0 ) {
+			break;
+		}
+
+		node_index = stack[--stack_size];
+	}
+}
+
+static void mc_check_bsp_tree(bsp_collision_tree *tree)
+{
+	// cached trees only come with the flattened nodes
+	if ( Model_collide_flat_bsp || tree->node_list == nullptr ) {
+		model_collide_bsp_flat(tree);
+	} else {
+		model_collide_bsp(tree, 0);
+	}
+}
+
 void model_collide_parse_bsp_tmappoly(bsp_collision_leaf *leaf, SCP_vector<model_tmap_vert> *vert_buffer, void *model_ptr)
 {
 	ubyte *p = (ubyte *)model_ptr;
@@ -577,6 +898,135 @@ void model_collide_parse_bsp_flatpoly(bsp_collision_leaf *leaf, SCP_vector<model
 	}
 }
 
+// Splits the leaf polygons into the fans fvi_point_face() checks them as, and stores the triangles in blocks
+// for mc_tri_block_check_ray() and mc_tri_block_check_sphereline().
+static void model_collide_bake_tri_blocks(bsp_collision_tree *tree, SCP_vector<bsp_collision_leaf> &leaves, const SCP_vector<model_tmap_vert> &verts)
+{
+	int n_tris = 0;
+
+	for (auto &leaf : leaves) {
+		leaf.tri_start = n_tris;
+
+		if (leaf.num_verts >= 3) {
+			n_tris += leaf.num_verts - 2;
+		}
+	}
+
+	tree->n_tri_blocks = (n_tris + MC_TRI_BLOCK_SIZE - 1) / MC_TRI_BLOCK_SIZE;
+
+	if (tree->n_tri_blocks == 0) {
+		tree->tri_blocks = nullptr;
+		return;
+	}
+
+	tree->tri_blocks = (bsp_collision_tri_block*)vm_malloc(sizeof(bsp_collision_tri_block) * tree->n_tri_blocks);
+	memset(tree->tri_blocks, 0, sizeof(bsp_collision_tri_block) * tree->n_tri_blocks);
+
+	for (const auto &leaf : leaves) {
+		if (leaf.num_verts < 3) {
+			continue;
+		}
+
+		const float *norm = leaf.plane_norm.a1d;
+		const vec3d *base = &tree->point_list[verts[leaf.vert_start].vertnum];
+
+		// same projection as fvi_point_face(), dropping the largest component of the normal
+		int i0;
+		if (fl_abs(norm[0]) > fl_abs(norm[1])) {
+			i0 = (fl_abs(norm[0]) > fl_abs(norm[2])) ? 0 : 2;
+		} else {
+			i0 = (fl_abs(norm[1]) > fl_abs(norm[2])) ? 1 : 2;
+		}
+		int i1 = (i0 + 1) % 3;
+		int i2 = (i0 + 2) % 3;
+
+		for (int j = 2; j < leaf.num_verts; ++j) {
+			const vec3d *v1 = &tree->point_list[verts[leaf.vert_start + j - 1].vertnum];
+			const vec3d *v2 = &tree->point_list[verts[leaf.vert_start + j].vertnum];
+
+			int tri = leaf.tri_start + j - 2;
+			bsp_collision_tri_block *block = &tree->tri_blocks[tri / MC_TRI_BLOCK_SIZE];
+			int lane = tri % MC_TRI_BLOCK_SIZE;
+
+			for (int k = 0; k < 3; ++k) {
+				block->plane_norm[k][lane] = norm[k];
+				block->base[k][lane] = base->a1d[k];
+				block->axis_u[k][lane] = (k == i1) ? 1.0f : 0.0f;
+				block->axis_v[k][lane] = (k == i2) ? 1.0f : 0.0f;
+			}
+
+			float u1 = v1->a1d[i1] - base->a1d[i1];
+			float v1_ = v1->a1d[i2] - base->a1d[i2];
+			float u2 = v2->a1d[i1] - base->a1d[i1];
+			float v2_ = v2->a1d[i2] - base->a1d[i2];
+			float det = u1 * v2_ - u2 * v1_;
+
+			// leave the barycentric coordinates at zero for degenerate triangles, so they always pass
+			// and only the exact check decides
+			if (fl_abs(det) > 1e-6f * (u1 * u1 + v1_ * v1_ + u2 * u2 + v2_ * v2_)) {
+				float inv_det = 1.0f / det;
+
+				block->bary[0][lane] = v2_ * inv_det;
+				block->bary[1][lane] = -u2 * inv_det;
+				block->bary[2][lane] = -v1_ * inv_det;
+				block->bary[3][lane] = u1 * inv_det;
+			}
+
+			vec3d center = (*base + *v1 + *v2) / 3.0f;
+			float radius = vm_vec_dist(&center, base);
+			radius = MAX(radius, vm_vec_dist(&center, v1));
+			radius = MAX(radius, vm_vec_dist(&center, v2));
+
+			for (int k = 0; k < 3; ++k) {
+				block->center[k][lane] = center.a1d[k];
+			}
+			block->radius[lane] = radius;
+		}
+	}
+}
+
+// Returns the index of the flattened node, or -1 if the node and its children have no polygons.
+static int model_collide_flatten_bsp_node(const SCP_vector<bsp_collision_node> &nodes, int node_index, SCP_vector<bsp_collision_flat_node> &flat_nodes, int depth, int *max_depth)
+{
+	const bsp_collision_node &node = nodes[node_index];
+	int flat_index = (int)flat_nodes.size();
+
+	*max_depth = MAX(*max_depth, depth);
+
+	flat_nodes.push_back({ node.min, -1, node.max, node.leaf });
+
+	if ( node.leaf >= 0 ) {
+		return flat_index;
+	}
+
+	int first = (node.back >= 0) ? model_collide_flatten_bsp_node(nodes, node.back, flat_nodes, depth + 1, max_depth) : -1;
+	int second = (node.front >= 0) ? model_collide_flatten_bsp_node(nodes, node.front, flat_nodes, depth + 1, max_depth) : -1;
+
+	if ( first < 0 && second < 0 ) {
+		flat_nodes.pop_back();
+		return -1;
+	}
+
+	// a lone front child ends up right after this node anyway
+	if ( first >= 0 && second >= 0 ) {
+		flat_nodes[flat_index].second_child = second;
+	}
+
+	return flat_index;
+}
+
+static void model_collide_flatten_bsp(bsp_collision_tree *tree, const SCP_vector<bsp_collision_node> &nodes)
+{
+	tree->flat_nodes.clear();
+	tree->flat_depth = 0;
+
+	if ( !nodes.empty() ) {
+		model_collide_flatten_bsp_node(nodes, 0, tree->flat_nodes, 1, &tree->flat_depth);
+	}
+
+	tree->flat_nodes.shrink_to_fit();
+}
+
 void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int version)
 {
 	TRACE_SCOPE(tracing::ModelParseBSPTree);
@@ -604,6 +1054,12 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 		tree->n_leaves = 0;
 		tree->leaf_list = NULL;
 
+		tree->n_tri_blocks = 0;
+		tree->tri_blocks = nullptr;
+
+		tree->flat_nodes.clear();
+		tree->flat_depth = 0;
+
 		// finally copy the vert list.
 		tree->vert_list = NULL;
 
@@ -613,7 +1069,7 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 	p += chunk_size;
 
 	bsp_collision_node new_node;
-	bsp_collision_leaf new_leaf{ vmd_zero_vector, 0, 0, 0, 0 };
+	bsp_collision_leaf new_leaf{ vmd_zero_vector, 0, 0, 0, 0, 0 };
 
 	SCP_vector<bsp_collision_node> node_buffer;
 	SCP_vector<bsp_collision_leaf> leaf_buffer;
@@ -809,12 +1265,16 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 
 	tree->n_verts = n_verts;
 
-	// copy node info. this might be a good time to organize the nodes into a cache efficient tree layout.
+	model_collide_flatten_bsp(tree, node_buffer);
+
+	// copy node info.
 	tree->n_nodes = (int)node_buffer.size();
 	tree->node_list = (bsp_collision_node*)vm_malloc(sizeof(bsp_collision_node) * node_buffer.size());
 	memcpy(tree->node_list, &node_buffer[0], sizeof(bsp_collision_node) * node_buffer.size());
 	node_buffer.clear();
 
+	model_collide_bake_tri_blocks(tree, leaf_buffer, vert_buffer);
+
 	// copy leaves.
 	tree->n_leaves = (int)leaf_buffer.size();
 	tree->leaf_list = (bsp_collision_leaf*)vm_malloc(sizeof(bsp_collision_leaf) * leaf_buffer.size());
@@ -1061,9 +1521,9 @@ void mc_check_subobj( int mn )
 					}
 				}
 
-				model_collide_bsp(model_get_bsp_collision_tree(lod_sm->collision_tree_index), 0);
+				mc_check_bsp_tree(model_get_bsp_collision_tree(lod_sm->collision_tree_index));
 			} else {
-				model_collide_bsp(model_get_bsp_collision_tree(sm->collision_tree_index), 0);
+				mc_check_bsp_tree(model_get_bsp_collision_tree(sm->collision_tree_index));
 			}
 		}
 	}
@@ -1247,11 +1707,10 @@ int model_collide(mc_info *mc_info_obj)
 		
 		// do the same for the list of hitpoints, if necessary
 		if (Mc->flags & MC_COLLIDE_ALL) {
-			for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
-				if (Mc->flags & MC_SUBMODEL) {
-					vm_vec_unrotate(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc->orient);
-					vm_vec_add2(&Mc->hit_points_all[i], Mc->pos);
-				} else {
+			if (Mc->flags & MC_SUBMODEL) {
+				vm_vec_unrotate_n(Mc->hit_points_all.data(), Mc->hit_points_all.data(), Mc->hit_points_all.size(), Mc->orient, Mc->pos);
+			} else {
+				for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
 					if (Mc_pmi) {
 						model_instance_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc_pmi, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
 					}
@@ -1266,3 +1725,367 @@ int model_collide(mc_info *mc_info_obj)
 
 	return Mc->num_hits;
 }
+
+int model_collide_tree(bsp_collision_tree *tree, mc_info *mc_info_obj, bool flat_layout)
+{
+	Mc = mc_info_obj;
+
+	Mc->num_hits = 0;
+	Mc->shield_hit_tri = -1;
+	Mc->hit_bitmap = -1;
+	Mc->edge_hit = false;
+
+	Mc_pm = nullptr;
+	Mc_pmi = nullptr;
+	Mc_submodel = 0;
+
+	Mc_p0 = *Mc->p0;
+	Mc_p1 = *Mc->p1;
+	vm_vec_sub(&Mc_direction, &Mc_p1, &Mc_p0);
+	Mc_mag = vm_vec_mag(&Mc_direction);
+
+	if ( IS_VEC_NULL(&Mc_direction) ) {
+		return 0;
+	}
+
+	if ( flat_layout ) {
+		model_collide_bsp_flat(tree);
+	} else {
+		model_collide_bsp(tree, 0);
+	}
+
+	return Mc->num_hits;
+}
+
+// Bump this whenever the layout of the collision tree changes
+#define MC_BSP_CACHE_VERSION	2
+
+// The cache files hold the tree structs as they are in memory, so they can only be read back by a build with the
+// same struct layout and byte order. This header is checked before anything else in the file is looked at.
+#define MC_BSP_CACHE_MAGIC		0x43505342		// "BSPC"
+#define MC_BSP_CACHE_BYTE_ORDER	0x01020304
+
+struct mc_bsp_cache_header {
+	int magic;
+	int version;
+	int byte_order;
+	int sizes[5];
+};
+
+static mc_bsp_cache_header model_collide_bsp_cache_header()
+{
+	return { MC_BSP_CACHE_MAGIC, MC_BSP_CACHE_VERSION, MC_BSP_CACHE_BYTE_ORDER,
+		{ (int)sizeof(vec3d), (int)sizeof(bsp_collision_leaf), (int)sizeof(model_tmap_vert),
+		  (int)sizeof(bsp_collision_tri_block), (int)sizeof(bsp_collision_flat_node) } };
+}
+
+static SCP_string model_collide_bsp_cache_filename(polymodel *pm)
+{
+	MD5 md5;
+
+	int header[] = { MC_BSP_CACHE_VERSION, pm->version, pm->n_models,
+		(int)sizeof(bsp_collision_leaf), (int)sizeof(model_tmap_vert), (int)sizeof(bsp_collision_tri_block), (int)sizeof(bsp_collision_flat_node) };
+	md5.update(reinterpret_cast<const char*>(header), (MD5::size_type) sizeof(header));
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		int size = pm->submodel[i].bsp_data_size;
+
+		md5.update(reinterpret_cast<const char*>(&size), (MD5::size_type) sizeof(size));
+		if (size > 0) {
+			md5.update(pm->submodel[i].bsp_data.get(), (MD5::size_type) size);
+		}
+	}
+
+	md5.finalize();
+
+	return SCP_string("bsp_tree-") + md5.hexdigest() + ".bin";
+}
+
+// The full path the cache file is written to. It is only ever read back from there as well, never from a
+// cache directory some other root (like a mod or the game data) happens to ship.
+static SCP_string model_collide_bsp_cache_path(polymodel *pm)
+{
+	SCP_string path;
+	auto filename = model_collide_bsp_cache_filename(pm);
+
+	cf_create_default_path_string(path, CF_TYPE_CACHE, filename.c_str(), CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+
+	// without a root to write to there is no path, and only a full path keeps cfopen() from searching every root
+	if ( path.find(DIR_SEPARATOR_CHAR) == SCP_string::npos ) {
+		path.clear();
+	}
+
+	return path;
+}
+
+static void model_collide_clear_bsp_tree(bsp_collision_tree *tree)
+{
+	if ( tree->node_list ) {
+		vm_free(tree->node_list);
+	}
+	if ( tree->point_list ) {
+		vm_free(tree->point_list);
+	}
+	if ( tree->leaf_list ) {
+		vm_free(tree->leaf_list);
+	}
+	if ( tree->vert_list ) {
+		vm_free(tree->vert_list);
+	}
+	if ( tree->tri_blocks ) {
+		vm_free(tree->tri_blocks);
+	}
+
+	tree->node_list = nullptr;
+	tree->n_nodes = 0;
+	tree->point_list = nullptr;
+	tree->n_verts = 0;
+	tree->leaf_list = nullptr;
+	tree->n_leaves = 0;
+	tree->vert_list = nullptr;
+	tree->tri_blocks = nullptr;
+	tree->n_tri_blocks = 0;
+	tree->poly_centers.clear();
+	tree->flat_nodes.clear();
+	tree->flat_depth = 0;
+}
+
+template <typename T>
+static T *model_collide_read_bsp_array(CFILE *fp, int count)
+{
+	if ( count <= 0 ) {
+		return nullptr;
+	}
+
+	auto data = (T*)vm_malloc(sizeof(T) * count);
+	if ( cfread(data, sizeof(T), count, fp) != count ) {
+		vm_free(data);
+		return nullptr;
+	}
+
+	return data;
+}
+
+// The cache file is only as trustworthy as the disk it sits on, so every index the tree walks and the polygon checks
+// follow is checked before the tree is used. Anything out of range makes the caller parse the model instead.
+static bool model_collide_bsp_tree_valid(const bsp_collision_tree *tree, int n_tmap_verts)
+{
+	for (int i = 0; i < n_tmap_verts; ++i) {
+		if ( tree->vert_list[i].vertnum >= (uint)tree->n_verts ) {
+			return false;
+		}
+	}
+
+	const int n_tris = tree->n_tri_blocks * MC_TRI_BLOCK_SIZE;
+
+	for (int i = 0; i < tree->n_leaves; ++i) {
+		const bsp_collision_leaf &leaf = tree->leaf_list[i];
+
+		if ( leaf.num_verts > TMAP_MAX_VERTS || leaf.vert_start < 0 || leaf.vert_start > n_tmap_verts - leaf.num_verts ) {
+			return false;
+		}
+
+		// the leaf lists only ever run forward, which also rules out loops
+		if ( leaf.next != -1 && (leaf.next <= i || leaf.next >= tree->n_leaves) ) {
+			return false;
+		}
+
+		if ( leaf.num_verts >= 3 && tree->tri_blocks != nullptr && (leaf.tri_start < 0 || leaf.tri_start > n_tris - (leaf.num_verts - 2)) ) {
+			return false;
+		}
+	}
+
+	// the first child of a node comes right after it and the second one further on, so a walk over every node
+	// visits each of them at most once and can't need a deeper stack than the depth the walk is given
+	const int n_flat_nodes = (int)tree->flat_nodes.size();
+	SCP_vector<int> stack;
+	int node_index = 0;
+	int visited = 0;
+
+	while ( n_flat_nodes > 0 ) {
+		if ( ++visited > n_flat_nodes ) {
+			return false;
+		}
+
+		const bsp_collision_flat_node &node = tree->flat_nodes[node_index];
+
+		if ( node.leaf < -1 || node.leaf >= tree->n_leaves ) {
+			return false;
+		}
+
+		if ( node.leaf < 0 ) {
+			if ( node.second_child != -1 ) {
+				if ( node.second_child <= node_index + 1 || node.second_child >= n_flat_nodes ) {
+					return false;
+				}
+
+				stack.push_back(node.second_child);
+				if ( (int)stack.size() > tree->flat_depth ) {
+					return false;
+				}
+			}
+
+			if ( ++node_index >= n_flat_nodes ) {
+				return false;
+			}
+			continue;
+		}
+
+		if ( stack.empty() ) {
+			break;
+		}
+
+		node_index = stack.back();
+		stack.pop_back();
+	}
+
+	return true;
+}
+
+static bool model_collide_read_bsp_tree(bsp_collision_tree *tree, CFILE *fp)
+{
+	tree->n_verts = cfread_int(fp, -1);
+	tree->n_leaves = cfread_int(fp, -1);
+	int n_tmap_verts = cfread_int(fp, -1);
+	tree->n_tri_blocks = cfread_int(fp, -1);
+	int n_flat_nodes = cfread_int(fp, -1);
+	tree->flat_depth = cfread_int(fp, -1);
+
+	if ( tree->n_verts < 0 || tree->n_leaves < 0 || n_tmap_verts < 0 || tree->n_tri_blocks < 0 || n_flat_nodes < 0 || tree->flat_depth < 0 ) {
+		return false;
+	}
+
+	tree->point_list = model_collide_read_bsp_array<vec3d>(fp, tree->n_verts);
+	tree->leaf_list = model_collide_read_bsp_array<bsp_collision_leaf>(fp, tree->n_leaves);
+	tree->vert_list = model_collide_read_bsp_array<model_tmap_vert>(fp, n_tmap_verts);
+	tree->tri_blocks = model_collide_read_bsp_array<bsp_collision_tri_block>(fp, tree->n_tri_blocks);
+
+	if ( (tree->n_verts > 0 && !tree->point_list) || (tree->n_leaves > 0 && !tree->leaf_list) ||
+		(n_tmap_verts > 0 && !tree->vert_list) || (tree->n_tri_blocks > 0 && !tree->tri_blocks) ) {
+		return false;
+	}
+
+	tree->poly_centers.resize(tree->n_leaves);
+	tree->flat_nodes.resize(n_flat_nodes);
+
+	if ( tree->n_leaves > 0 && cfread(tree->poly_centers.data(), sizeof(vec3d), tree->n_leaves, fp) != tree->n_leaves ) {
+		return false;
+	}
+	if ( n_flat_nodes > 0 && cfread(tree->flat_nodes.data(), sizeof(bsp_collision_flat_node), n_flat_nodes, fp) != n_flat_nodes ) {
+		return false;
+	}
+
+	return model_collide_bsp_tree_valid(tree, n_tmap_verts);
+}
+
+bool model_collide_load_bsp_cache(polymodel *pm)
+{
+	if ( Cmdline_nobspcache ) {
+		return false;
+	}
+
+	TRACE_SCOPE(tracing::ModelParseAllBSPTrees);
+
+	auto filename = model_collide_bsp_cache_path(pm);
+	if ( filename.empty() ) {
+		return false;
+	}
+
+	auto fp = cfopen(filename.c_str(), "rb", CF_TYPE_CACHE);
+	if ( !fp ) {
+		return false;
+	}
+
+	// read as raw bytes and not through cfread_int(), so a file written with the other byte order doesn't match
+	auto expected = model_collide_bsp_cache_header();
+	mc_bsp_cache_header header;
+
+	bool success = (cfread(&header, sizeof(header), 1, fp) == 1) && !memcmp(&header, &expected, sizeof(header));
+	success = success && (cfread_int(fp) == pm->n_models);
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		bsp_collision_tree *tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		model_collide_clear_bsp_tree(tree);
+
+		if ( success ) {
+			success = model_collide_read_bsp_tree(tree, fp);
+		}
+	}
+
+	cfclose(fp);
+
+	if ( !success ) {
+		mprintf(("Collision tree cache file %s for model %s is invalid, parsing the model instead.\n", filename.c_str(), pm->filename));
+
+		for (int i = 0; i < pm->n_models; ++i) {
+			model_collide_clear_bsp_tree(model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index));
+		}
+	}
+
+	return success;
+}
+
+void model_collide_save_bsp_cache(polymodel *pm)
+{
+	if ( Cmdline_nobspcache ) {
+		return;
+	}
+
+	auto filename = model_collide_bsp_cache_path(pm);
+	if ( filename.empty() ) {
+		return;
+	}
+
+	cf_create_directory(CF_TYPE_CACHE, CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+
+	auto fp = cfopen(filename.c_str(), "wb", CF_TYPE_CACHE);
+	if ( !fp ) {
+		mprintf(("Could not open collision tree cache file %s!\n", filename.c_str()));
+		return;
+	}
+
+	auto header = model_collide_bsp_cache_header();
+	cfwrite(&header, sizeof(header), 1, fp);
+
+	cfwrite_int(pm->n_models, fp);
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		bsp_collision_tree *tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		int n_tmap_verts = 0;
+		for (int j = 0; j < tree->n_leaves; ++j) {
+			n_tmap_verts = MAX(n_tmap_verts, tree->leaf_list[j].vert_start + tree->leaf_list[j].num_verts);
+		}
+
+		cfwrite_int(tree->n_verts, fp);
+		cfwrite_int(tree->n_leaves, fp);
+		cfwrite_int(n_tmap_verts, fp);
+		cfwrite_int(tree->n_tri_blocks, fp);
+		cfwrite_int((int)tree->flat_nodes.size(), fp);
+		cfwrite_int(tree->flat_depth, fp);
+
+		if ( tree->n_verts > 0 ) {
+			cfwrite(tree->point_list, sizeof(vec3d), tree->n_verts, fp);
+		}
+		if ( tree->n_leaves > 0 ) {
+			cfwrite(tree->leaf_list, sizeof(bsp_collision_leaf), tree->n_leaves, fp);
+		}
+		if ( n_tmap_verts > 0 ) {
+			cfwrite(tree->vert_list, sizeof(model_tmap_vert), n_tmap_verts, fp);
+		}
+		if ( tree->n_tri_blocks > 0 ) {
+			cfwrite(tree->tri_blocks, sizeof(bsp_collision_tri_block), tree->n_tri_blocks, fp);
+		}
+
+		Assertion(tree->poly_centers.size() == (size_t)tree->n_leaves, "Collision tree of model %s doesn't have a center for every polygon!", pm->filename);
+		if ( tree->n_leaves > 0 ) {
+			cfwrite(tree->poly_centers.data(), sizeof(vec3d), tree->n_leaves, fp);
+		}
+		if ( !tree->flat_nodes.empty() ) {
+			cfwrite(tree->flat_nodes.data(), sizeof(bsp_collision_flat_node), (int)tree->flat_nodes.size(), fp);
+		}
+	}
+
+	cfclose(fp);
+}
@@ -3492,11 +3492,18 @@ int model_load(const  char* filename, ship_info* sip, ErrorType error_type, bool
 
 	for (i = 0; i < pm->n_models; ++i) {
 		pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
-		bsp_collision_tree* tree             = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+	}
+
+	if (!model_collide_load_bsp_cache(pm)) {
+		for (i = 0; i < pm->n_models; ++i) {
+			bsp_collision_tree* tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+			Macro_ubyte_bounds = pm->submodel[i].bsp_data.get() + pm->submodel[i].bsp_data_size;
+			model_collide_parse_bsp(tree, pm->submodel[i].bsp_data.get(), pm->version);
+			Macro_ubyte_bounds = nullptr;
+		}
 
-		Macro_ubyte_bounds = pm->submodel[i].bsp_data.get() + pm->submodel[i].bsp_data_size;
-		model_collide_parse_bsp(tree, pm->submodel[i].bsp_data.get(), pm->version);
-		Macro_ubyte_bounds = nullptr;
+		model_collide_save_bsp_cache(pm);
 	}
 
 	// Find the core_radius... the minimum of 
@@ -5415,6 +5422,13 @@ void model_remove_bsp_collision_tree(int tree_index)
 	if ( Bsp_collision_tree_list[tree_index].vert_list ) {
 		vm_free( Bsp_collision_tree_list[tree_index].vert_list);
 	}
+
+	if ( Bsp_collision_tree_list[tree_index].tri_blocks ) {
+		vm_free( Bsp_collision_tree_list[tree_index].tri_blocks );
+	}
+
+	// reset the whole slot, so a reused tree doesn't start out with stale pointers or polygon centers
+	Bsp_collision_tree_list[tree_index] = bsp_collision_tree{};
 }
 
 #if BYTE_ORDER == BIG_ENDIAN
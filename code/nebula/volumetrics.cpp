@@ -1,12 +1,19 @@
 #include "volumetrics.h"
 
 #include "bmpman/bmpman.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
 #include "mission/missionparse.h"
 #include "model/model.h"
 #include "parse/parselo.h"
 #include "render/3d.h"
+#include "tracing/tracing.h"
+#include "utils/threading.h"
 
 #include <anl.h>
+#include <md5.h>
+
+#include <random>
 
 #define OFFSET_R 2
 #define OFFSET_G 1
@@ -400,13 +407,165 @@ static inline float getNebDistSquared(const ivec3& l, const ivec3& r, const vec3
 	return (dx < 0 ? 0 : dx) * scale.xyz.x * scale.xyz.x + (dy < 0 ? 0 : dy) * scale.xyz.y * scale.xyz.y + (dz < 0 ? 0 : dz) * scale.xyz.z * scale.xyz.z;
 }
 
+// Bump this whenever what ends up in the cached volume bitmaps changes
+#define VOLUMETRICS_CACHE_VERSION	1
+
+static SCP_string getVolumeCacheFilename(const polymodel* pm, int resolution, int oversampling, int smoothingSteps) {
+	MD5 md5;
+
+	int header[] = { VOLUMETRICS_CACHE_VERSION, resolution, oversampling, smoothingSteps, pm->n_models };
+	md5.update(reinterpret_cast<const char*>(header), (MD5::size_type) sizeof(header));
+	md5.update(reinterpret_cast<const char*>(&pm->mins), (MD5::size_type) sizeof(pm->mins));
+	md5.update(reinterpret_cast<const char*>(&pm->maxs), (MD5::size_type) sizeof(pm->maxs));
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		int size = pm->submodel[i].bsp_data_size;
+
+		md5.update(reinterpret_cast<const char*>(&pm->submodel[i].offset), (MD5::size_type) sizeof(pm->submodel[i].offset));
+		md5.update(reinterpret_cast<const char*>(&size), (MD5::size_type) sizeof(size));
+		if (size > 0) {
+			md5.update(pm->submodel[i].bsp_data.get(), (MD5::size_type) size);
+		}
+	}
+
+	md5.finalize();
+
+	return SCP_string("volumetrics-") + md5.hexdigest() + ".bin";
+}
+
+static SCP_string getNoiseCacheFilename(int noiseResolution, const std::optional<SCP_string>& noiseFunc1, const std::optional<SCP_string>& noiseFunc2) {
+	MD5 md5;
+
+	int header[] = { VOLUMETRICS_CACHE_VERSION, noiseResolution, noiseFunc1 ? 1 : 0, noiseFunc2 ? 1 : 0 };
+	md5.update(reinterpret_cast<const char*>(header), (MD5::size_type) sizeof(header));
+
+	for (const auto& func : { noiseFunc1, noiseFunc2 }) {
+		if (func) {
+			int length = static_cast<int>(func->size());
+			md5.update(reinterpret_cast<const char*>(&length), (MD5::size_type) sizeof(length));
+			md5.update(func->c_str(), (MD5::size_type) length);
+		}
+	}
+
+	md5.finalize();
+
+	return SCP_string("volumetrics-noise-") + md5.hexdigest() + ".bin";
+}
+
+static bool loadVolumeCache(const SCP_string& filename, int n, ubyte* data) {
+	if (Cmdline_novolumetricscache) {
+		return false;
+	}
+
+	auto fp = cfopen(filename.c_str(), "rb", CF_TYPE_CACHE, false,
+	                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+	if (!fp) {
+		return false;
+	}
+
+	int size = n * n * n * 4;
+	bool success = cfread_int(fp, -1) == n && cfread(data, 1, size, fp) == size;
+
+	cfclose(fp);
+
+	if (!success) {
+		mprintf(("Volumetric nebula cache file %s is invalid, rendering the volume instead.\n", filename.c_str()));
+	}
+
+	return success;
+}
+
+static void saveVolumeCache(const SCP_string& filename, int n, const ubyte* data) {
+	if (Cmdline_novolumetricscache) {
+		return;
+	}
+
+	auto fp = cfopen(filename.c_str(), "wb", CF_TYPE_CACHE, false,
+	                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+	if (!fp) {
+		mprintf(("Could not open volumetric nebula cache file %s!\n", filename.c_str()));
+		return;
+	}
+
+	cfwrite_int(n, fp);
+	cfwrite(data, 1, n * n * n * 4, fp);
+
+	cfclose(fp);
+}
+
+// Casts a ray along z through every column of the sample grid and marks the samples inside the hull.  The columns
+// are independent, so they are cast on the worker threads.
+static void sampleHull(bool* volumeSampleCache, int modelnum, const vec3d& bl, const vec3d& size, int n, int oversampling) {
+	int nSample = (n << (oversampling - 1)) + 1;
+	float nSteps = static_cast<float>(n << (oversampling - 1));
+
+	threading::parallel_for(static_cast<size_t>(nSample), 1, [&](size_t begin, size_t end) {
+		mc_info mc;
+
+		mc.model_num = modelnum;
+		mc.orient = &vmd_identity_matrix;
+		mc.pos = &vmd_zero_vector;
+		mc.p1 = &vmd_zero_vector;
+
+		mc.flags = MC_CHECK_MODEL | MC_COLLIDE_ALL | MC_CHECK_INVISIBLE_FACES;
+
+		SCP_multiset<int> collisionZIndices;
+
+		for (int x = static_cast<int>(begin); x < static_cast<int>(end); x++) {
+			for (int y = 0; y < nSample; y++) {
+				vec3d start = bl;
+				start += vec3d{ {{static_cast<float>(x) * size.xyz.x / nSteps,
+								 static_cast<float>(y) * size.xyz.y / nSteps,
+								 0.0f }} };
+				vec3d end = start;
+				end.xyz.z += size.xyz.z;
+
+				mc.p0 = &start;
+				mc.p1 = &end;
+				mc.hit_points_all.clear();
+				mc.hit_submodels_all.clear();
+				model_collide(&mc);
+
+				//Annoying hack cause sometimes, if edges of polygons get too close to the ray, the collisions are missed / too many. At least find odd rays and fix those, since these are very visible
+				//Seeded by the ray, so the result is the same whichever thread casts it
+				if (mc.hit_points_all.size() % 2 != 0) {
+					std::mt19937 rng(static_cast<unsigned int>(x * nSample + y));
+					std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+					do {
+						start += vec3d{ {{ size.xyz.x / nSteps * jitter(rng), size.xyz.y / nSteps * jitter(rng), 0.0f }} };
+						end += vec3d{ {{ size.xyz.x / nSteps * jitter(rng), size.xyz.y / nSteps * jitter(rng), 0.0f }} };
+						mc.hit_points_all.clear();
+						mc.hit_submodels_all.clear();
+						model_collide(&mc);
+					} while (mc.hit_points_all.size() % 2 != 0);
+				}
+
+				collisionZIndices.clear();
+				for(const vec3d& hitpnt : mc.hit_points_all)
+					collisionZIndices.emplace(static_cast<int>((hitpnt.xyz.z - bl.xyz.z) / size.xyz.z * nSteps));
+
+				size_t hitcnt = 0;
+				auto hitpntit = collisionZIndices.cbegin();
+				for (int z = 0; z < nSample; z++) {
+					while (hitpntit != collisionZIndices.cend() && *hitpntit < z) {
+						++hitpntit;
+						++hitcnt;
+					}
+					volumeSampleCache[x * nSample * nSample + y * nSample + z] = hitcnt % 2 != 0;
+				}
+			}
+		}
+	}, &tracing::RenderVolumeBitmapJob);
+}
+
 void volumetric_nebula::renderVolumeBitmap() {
 	Assertion(!hullPof.empty(), "Volumetric Nebula was not properly configured. Did you call parse_volumetric_nebula()?");
 	Assertion(!isVolumeBitmapValid(), "Volume bitmap was already rendered!");
 
+	TRACE_SCOPE(tracing::RenderVolumeBitmap);
+
 	int n = 1 << resolution;
 	int nSample = (n << (oversampling - 1)) + 1;
-	auto volumeSampleCache = make_unique<bool[]>(nSample * nSample * nSample);
 
 	int modelnum = model_load(hullPof.c_str(), nullptr, ErrorType::NONE);
 	if (modelnum < 0) {
@@ -423,163 +582,130 @@ void volumetric_nebula::renderVolumeBitmap() {
 	bb_min = pos - (size * 0.5f);
 	bb_max = pos + (size * 0.5f);
 
-	mc_info mc;
-
-	mc.model_num = modelnum;
-	mc.orient = &vmd_identity_matrix;
-	mc.pos = &vmd_zero_vector;
-	mc.p1 = &vmd_zero_vector;
-
-	mc.flags = MC_CHECK_MODEL | MC_COLLIDE_ALL | MC_CHECK_INVISIBLE_FACES;
-
-	//Calculate minimum "bottom left" corner of scaled size box
-	vec3d bl = pm->mins - (size * ((scaleFactor - 1.0f) / 2.0f / scaleFactor));
-
-	//Go through sampling procedure to test where the nebula even is
-	for (int x = 0; x < nSample; x++) {
-		for (int y = 0; y < nSample; y++) {
-			vec3d start = bl;
-			start += vec3d{ {{static_cast<float>(x) * size.xyz.x / static_cast<float>(n << (oversampling - 1)),
-							 static_cast<float>(y) * size.xyz.y / static_cast<float>(n << (oversampling - 1)),
-							 0.0f }} };
-			vec3d end = start;
-			end.xyz.z += size.xyz.z;
-
-			mc.p0 = &start;
-			mc.p1 = &end;
-			mc.hit_points_all.clear();
-			mc.hit_submodels_all.clear();
-			model_collide(&mc);
-
-			//Annoying hack cause sometimes, if edges of polygons get too close to the ray, the collisions are missed / too many. At least find odd rays and fix those, since these are very visible
-			while (mc.hit_points_all.size() % 2 != 0) {
-				start += vec3d{ {{ size.xyz.x / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f),
-								  size.xyz.y / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f), 0.0f }} };
-				end += vec3d{ {{ size.xyz.x / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f),
-								size.xyz.y / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f), 0.0f }} };
-				mc.hit_points_all.clear();
-				mc.hit_submodels_all.clear();
-				model_collide(&mc);
-			}
-
-			SCP_multiset<int> collisionZIndices;
-			for(const vec3d& hitpnt : mc.hit_points_all)
-				collisionZIndices.emplace(static_cast<int>((hitpnt.xyz.z - bl.xyz.z) / size.xyz.z * static_cast<float>(n << (oversampling - 1))));
-
-			size_t hitcnt = 0;
-			auto hitpntit = collisionZIndices.cbegin();
-			for (int z = 0; z < nSample; z++) {
-				while (hitpntit != collisionZIndices.cend() && *hitpntit < z) {
-					++hitpntit;
-					++hitcnt;
-				}
-				volumeSampleCache[x * nSample * nSample + y * nSample + z] = hitcnt % 2 != 0;
-			}
-		}
-	}
+	//scale is the maximal distance possible.
+	udfScale = vm_vec_mag(&size);
 
-	model_unload(modelnum);
+	int smoothing_steps = getVolumeBitmapSmoothingSteps();
 
-	//Sample the nebula values from the binary cubegrid.
 	volumeBitmapData = make_unique<ubyte[]>(n * n * n * 4);
-	int oversamplingCount = (1 << (oversampling - 1));
 
-	int smoothing_steps = getVolumeBitmapSmoothingSteps();
-	float oversamplingDivisor = 255.1f / (static_cast<float>(oversamplingCount + smoothing_steps) * static_cast<float>(oversamplingCount + smoothing_steps) * static_cast<float>(oversamplingCount + smoothing_steps));
-	int smoothStart = smoothing_steps / 2;
-	int smoothStop = (smoothing_steps / 2 + (1 & smoothing_steps));
-
-	for (int x = 0; x < n; x++) {
-		for (int y = 0; y < n; y++) {
-			for (int z = 0; z < n; z++) {
-				int sum = 0;
-				for (int sx = x * oversamplingCount - smoothStart; sx < (x + 1) * oversamplingCount + smoothStop; sx++) {
-					for (int sy = y * oversamplingCount - smoothStart; sy < (y + 1) * oversamplingCount + smoothStop; sy++) {
-						for (int sz = z * oversamplingCount - smoothStart; sz < (z + 1) * oversamplingCount + smoothStop; sz++) {
-							if (sx >= 0 && sx < nSample && sy >= 0 && sy < nSample && sz >= 0 && sz < nSample &&
-								volumeSampleCache[sx * nSample * nSample + sy * nSample + sz])
-								sum++;
+	auto cacheFilename = getVolumeCacheFilename(pm, resolution, oversampling, smoothing_steps);
+
+	if (loadVolumeCache(cacheFilename, n, volumeBitmapData.get())) {
+		model_unload(modelnum);
+	} else {
+		//Calculate minimum "bottom left" corner of scaled size box
+		vec3d bl = pm->mins - (size * ((scaleFactor - 1.0f) / 2.0f / scaleFactor));
+
+		//Go through sampling procedure to test where the nebula even is
+		auto volumeSampleCache = make_unique<bool[]>(nSample * nSample * nSample);
+		sampleHull(volumeSampleCache.get(), modelnum, bl, size, n, oversampling);
+
+		model_unload(modelnum);
+
+		//Sample the nebula values from the binary cubegrid.
+		int oversamplingCount = (1 << (oversampling - 1));
+
+		float oversamplingDivisor = 255.1f / (static_cast<float>(oversamplingCount + smoothing_steps) * static_cast<float>(oversamplingCount + smoothing_steps) * static_cast<float>(oversamplingCount + smoothing_steps));
+		int smoothStart = smoothing_steps / 2;
+		int smoothStop = (smoothing_steps / 2 + (1 & smoothing_steps));
+
+		threading::parallel_for(static_cast<size_t>(n), 1, [&](size_t begin, size_t end) {
+			for (int x = static_cast<int>(begin); x < static_cast<int>(end); x++) {
+				for (int y = 0; y < n; y++) {
+					for (int z = 0; z < n; z++) {
+						int sum = 0;
+						for (int sx = x * oversamplingCount - smoothStart; sx < (x + 1) * oversamplingCount + smoothStop; sx++) {
+							for (int sy = y * oversamplingCount - smoothStart; sy < (y + 1) * oversamplingCount + smoothStop; sy++) {
+								for (int sz = z * oversamplingCount - smoothStart; sz < (z + 1) * oversamplingCount + smoothStop; sz++) {
+									if (sx >= 0 && sx < nSample && sy >= 0 && sy < nSample && sz >= 0 && sz < nSample &&
+										volumeSampleCache[sx * nSample * nSample + sy * nSample + sz])
+										sum++;
+								}
+							}
 						}
+
+						volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)] = static_cast<ubyte>(static_cast<float>(sum) * oversamplingDivisor);
 					}
 				}
-
-				volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)] = static_cast<ubyte>(static_cast<float>(sum) * oversamplingDivisor);
 			}
-		}
-	}
-
-	// Test for edges in the nebula to compute the UDF
-	auto volumeEdgeCache = make_unique<ivec3[]>(n * n * n);
-	SCP_set<ivec3> udfBFS_checking, udfBFS_to_check;
-
-	for (int x = 0; x < n; x++) {
-		for (int y = 0; y < n; y++) {
-			for (int z = 0; z < n; z++) {
-				const ubyte& nebula_density = volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)];
-
-				//If we have neither full nor no nebula presence, it's an edge.
-				if (nebula_density > 0 && nebula_density < 255) {
-					udfBFS_to_check.emplace(ivec3{x, y, z});
-					volumeEdgeCache[x * n * n + y * n + z] = ivec3{x, y, z};
-				}
-				else {
-					bool found_edge = false;
-					//it's possible that we get completely sharp edges. So test for that.
-					for (const ivec3& neighbor : getNeighbors({x, y, z})){
-						if (neighbor.x < 0 || neighbor.x >= n || neighbor.y < 0 || neighbor.y >= n || neighbor.z < 0 || neighbor.z >= n)
-							continue;
-
-						if (nebula_density != volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, neighbor.x, neighbor.y, neighbor.z)]){
-							found_edge = true;
-							break;
+		}, &tracing::RenderVolumeBitmapJob);
+
+		// Test for edges in the nebula to compute the UDF
+		auto volumeEdgeCache = make_unique<ivec3[]>(n * n * n);
+
+		threading::parallel_for(static_cast<size_t>(n), 1, [&](size_t begin, size_t end) {
+			for (int x = static_cast<int>(begin); x < static_cast<int>(end); x++) {
+				for (int y = 0; y < n; y++) {
+					for (int z = 0; z < n; z++) {
+						const ubyte& nebula_density = volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)];
+
+						//If we have neither full nor no nebula presence, it's an edge.
+						bool found_edge = nebula_density > 0 && nebula_density < 255;
+
+						//it's possible that we get completely sharp edges. So test for that.
+						if (!found_edge) {
+							for (const ivec3& neighbor : getNeighbors({x, y, z})){
+								if (neighbor.x < 0 || neighbor.x >= n || neighbor.y < 0 || neighbor.y >= n || neighbor.z < 0 || neighbor.z >= n)
+									continue;
+
+								if (nebula_density != volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, neighbor.x, neighbor.y, neighbor.z)]){
+									found_edge = true;
+									break;
+								}
+							}
 						}
-					}
 
-					if (found_edge) {
-						udfBFS_to_check.emplace(ivec3{x, y, z});
-						volumeEdgeCache[x * n * n + y * n + z] = ivec3{x, y, z};
+						volumeEdgeCache[x * n * n + y * n + z] = found_edge ? ivec3{x, y, z} : ivec3{-1, -1, -1};
 					}
-					else
-						volumeEdgeCache[x * n * n + y * n + z] = ivec3{-1, -1, -1};
 				}
 			}
+		}, &tracing::RenderVolumeBitmapJob);
+
+		SCP_set<ivec3> udfBFS_checking, udfBFS_to_check;
+
+		for (int i = 0; i < n * n * n; i++) {
+			if (volumeEdgeCache[i].x >= 0)
+				udfBFS_to_check.emplace(volumeEdgeCache[i]);
 		}
-	}
 
-	//BFS from the known nebula edges to find the distance to the closest edge
-	while(!udfBFS_to_check.empty()){
-		udfBFS_checking = udfBFS_to_check;
-		udfBFS_to_check.clear();
+		//BFS from the known nebula edges to find the distance to the closest edge
+		while(!udfBFS_to_check.empty()){
+			udfBFS_checking = udfBFS_to_check;
+			udfBFS_to_check.clear();
 
-		for (const ivec3& toCheck : udfBFS_checking){
-			const ivec3& closestEdgeTile = volumeEdgeCache[toCheck.x * n * n + toCheck.y * n + toCheck.z];
+			for (const ivec3& toCheck : udfBFS_checking){
+				const ivec3& closestEdgeTile = volumeEdgeCache[toCheck.x * n * n + toCheck.y * n + toCheck.z];
 
-			for (const ivec3& neighbor : getNeighbors(toCheck)) {
-				if (neighbor.x < 0 || neighbor.x >= n || neighbor.y < 0 || neighbor.y >= n || neighbor.z < 0 || neighbor.z >= n)
-					continue;
+				for (const ivec3& neighbor : getNeighbors(toCheck)) {
+					if (neighbor.x < 0 || neighbor.x >= n || neighbor.y < 0 || neighbor.y >= n || neighbor.z < 0 || neighbor.z >= n)
+						continue;
 
-				ivec3& neighborClosestEdgeTile = volumeEdgeCache[neighbor.x * n * n + neighbor.y * n + neighbor.z];
+					ivec3& neighborClosestEdgeTile = volumeEdgeCache[neighbor.x * n * n + neighbor.y * n + neighbor.z];
 
-				if (neighborClosestEdgeTile.x < 0 || getNebDistSquared(neighbor, closestEdgeTile, size, false) < getNebDistSquared(neighbor, neighborClosestEdgeTile, size, false)) {
-					neighborClosestEdgeTile = closestEdgeTile;
-					udfBFS_to_check.emplace(neighbor);
+					if (neighborClosestEdgeTile.x < 0 || getNebDistSquared(neighbor, closestEdgeTile, size, false) < getNebDistSquared(neighbor, neighborClosestEdgeTile, size, false)) {
+						neighborClosestEdgeTile = closestEdgeTile;
+						udfBFS_to_check.emplace(neighbor);
+					}
 				}
 			}
 		}
-	}
 
-	//Compute the actual UDF from the BFS
-	//scale is the maximal distance possible.
-	udfScale = vm_vec_mag(&size);
-	for (int x = 0; x < n; x++) {
-		for (int y = 0; y < n; y++) {
-			for (int z = 0; z < n; z++) {
-				float dist = sqrtf(getNebDistSquared(ivec3{x, y, z}, volumeEdgeCache[x * n * n + y * n + z], size, true)) / static_cast<float>(n); //in meters
-				volumeBitmapData[COLOR_3D_ARRAY_POS(n, R, x, y, z)] = static_cast<ubyte>(dist / udfScale * 255.0f); //UDF
-				volumeBitmapData[COLOR_3D_ARRAY_POS(n, G, x, y, z)] = 0; // Reserved
-				volumeBitmapData[COLOR_3D_ARRAY_POS(n, B, x, y, z)] = 0; // Reserved
+		//Compute the actual UDF from the BFS
+		threading::parallel_for(static_cast<size_t>(n), 1, [&](size_t begin, size_t end) {
+			for (int x = static_cast<int>(begin); x < static_cast<int>(end); x++) {
+				for (int y = 0; y < n; y++) {
+					for (int z = 0; z < n; z++) {
+						float dist = sqrtf(getNebDistSquared(ivec3{x, y, z}, volumeEdgeCache[x * n * n + y * n + z], size, true)) / static_cast<float>(n); //in meters
+						volumeBitmapData[COLOR_3D_ARRAY_POS(n, R, x, y, z)] = static_cast<ubyte>(dist / udfScale * 255.0f); //UDF
+						volumeBitmapData[COLOR_3D_ARRAY_POS(n, G, x, y, z)] = 0; // Reserved
+						volumeBitmapData[COLOR_3D_ARRAY_POS(n, B, x, y, z)] = 0; // Reserved
+					}
+				}
 			}
-		}
+		}, &tracing::RenderVolumeBitmapJob);
+
+		saveVolumeCache(cacheFilename, n, volumeBitmapData.get());
 	}
 
 	volumeBitmapHandle = bm_create_3d(32, n, n, n, volumeBitmapData.get());
@@ -590,32 +716,58 @@ void volumetric_nebula::renderVolumeBitmap() {
 	int nNoise = 1 << noiseResolution;
 	noiseVolumeBitmapData = make_unique<ubyte[]>(nNoise * nNoise * nNoise * 4);
 
-	anl::CKernel kernel;
-
-	anl::CArray3Dd img(nNoise, nNoise, nNoise), img2(nNoise, nNoise, nNoise);
-	anl::SMappingRanges ranges(
-		0.0f, 1.0f,
-		0.0f, 1.0f,
-		0.0f, 1.0f);
-
-	anl::CInstructionIndex wispyNoise = noiseColorFunc1 ? getCustomNoise(kernel, *noiseColorFunc1) : getDefaultNoise(kernel, 0);
-	anl::CInstructionIndex wispyNoise2 = noiseColorFunc2 ? getCustomNoise(kernel, *noiseColorFunc2) : getDefaultNoise(kernel, 3);
-
-	anl::map3D(anl::SEAMLESS_XYZ, img, kernel, ranges, wispyNoise);
-	anl::map3D(anl::SEAMLESS_XYZ, img2, kernel, ranges, wispyNoise2);
-
-	for (int x = 0; x < nNoise; x++) {
-		for (int y = 0; y < nNoise; y++) {
-			for (int z = 0; z < nNoise; z++) {
-				const auto& noisePixel = img.get(x, y, z);
-				const auto& noisePixel2 = img2.get(x, y, z);
-				noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, R, x, y, z)] = static_cast<ubyte>(noisePixel * 255.0f); // R. Color noise 1, sampled at detail 1
-				noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, G, x, y, z)] = static_cast<ubyte>(noisePixel2 * 255.0f); // G. Color noise 2, sampled at detail 2
-				noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, B, x, y, z)] = 0; // B. Reserved for surface noise
-				noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, A, x, y, z)] = 0; // A. Reserved for surface noise.
+	auto noiseCacheFilename = getNoiseCacheFilename(noiseResolution, noiseColorFunc1, noiseColorFunc2);
+
+	if (!loadVolumeCache(noiseCacheFilename, nNoise, noiseVolumeBitmapData.get())) {
+		anl::CKernel kernel;
+
+		anl::CArray3Dd img(nNoise, nNoise, nNoise), img2(nNoise, nNoise, nNoise);
+		anl::SMappingRanges ranges(
+			0.0f, 1.0f,
+			0.0f, 1.0f,
+			0.0f, 1.0f);
+
+		anl::CInstructionIndex wispyNoise = noiseColorFunc1 ? getCustomNoise(kernel, *noiseColorFunc1) : getDefaultNoise(kernel, 0);
+		anl::CInstructionIndex wispyNoise2 = noiseColorFunc2 ? getCustomNoise(kernel, *noiseColorFunc2) : getDefaultNoise(kernel, 3);
+
+		//Each z slice of either noise is mapped on its own, on the engine's worker threads rather than ANL's own
+		threading::parallel_for(static_cast<size_t>(2 * nNoise), 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				bool second = i >= static_cast<size_t>(nNoise);
+				auto& target = second ? img2 : img;
+				int z = static_cast<int>(i % nNoise);
+
+				anl::SChunk3D chunk(second ? wispyNoise2 : wispyNoise);
+				chunk.seamlessmode = anl::SEAMLESS_XYZ;
+				chunk.a = target.getData() + static_cast<size_t>(z) * nNoise * nNoise;
+				chunk.awidth = nNoise;
+				chunk.aheight = nNoise;
+				chunk.adepth = nNoise;
+				chunk.chunkdepth = 1;
+				chunk.chunkzoffset = z;
+				chunk.kernel = kernel;
+				chunk.ranges = ranges;
+
+				anl::map3DChunk(chunk);
+			}
+		}, &tracing::RenderVolumeBitmapJob);
+
+		for (int x = 0; x < nNoise; x++) {
+			for (int y = 0; y < nNoise; y++) {
+				for (int z = 0; z < nNoise; z++) {
+					const auto& noisePixel = img.get(x, y, z);
+					const auto& noisePixel2 = img2.get(x, y, z);
+					noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, R, x, y, z)] = static_cast<ubyte>(noisePixel * 255.0f); // R. Color noise 1, sampled at detail 1
+					noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, G, x, y, z)] = static_cast<ubyte>(noisePixel2 * 255.0f); // G. Color noise 2, sampled at detail 2
+					noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, B, x, y, z)] = 0; // B. Reserved for surface noise
+					noiseVolumeBitmapData[COLOR_3D_ARRAY_POS(nNoise, A, x, y, z)] = 0; // A. Reserved for surface noise.
+				}
 			}
 		}
+
+		saveVolumeCache(noiseCacheFilename, nNoise, noiseVolumeBitmapData.get());
 	}
+
 	noiseVolumeBitmapHandle = bm_create_3d(32, nNoise, nNoise, nNoise, noiseVolumeBitmapData.get());
 }
 
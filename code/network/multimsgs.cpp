@@ -8580,6 +8580,7 @@ void process_variable_update_packet( ubyte *data, header *hinfo)
 	if ( (variable_index >= 0) && (variable_index < sexp_variable_count()) )
 	{
 		strcpy_s(Sexp_variables[variable_index].text, value); 
+		sexp_dependencies_changed(SEXP_DEP_VARIABLES);
 	}	
 
 	// send the packet on to all clients. 
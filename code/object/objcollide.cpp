@@ -9,6 +9,7 @@
 
 
 #include "cmdline/cmdline.h"
+#include "debugconsole/console.h"
 #include "globalincs/linklist.h"
 #include "io/timer.h"
 #include "object/objcollide.h"
@@ -21,6 +22,7 @@
 #include "tracing/Monitor.h"
 #include "utils/threading.h"
 
+#include <algorithm>
 #include <limits>
 
 
@@ -48,10 +50,160 @@ public:
 	collider_pair()
 		: a(nullptr), b(nullptr), signature_a(-1), signature_b(-1), next_check_time(-1), initialized(false)
 	{}
+
+	// true if either object has been freed (and maybe reused) since this pair was set up
+	bool is_stale() const
+	{
+		return !initialized || signature_a != a->signature || signature_b != b->signature;
+	}
+};
+
+MONITOR(CollisionCachePairs)
+MONITOR(CollisionCacheCapacity)
+MONITOR(CollisionCachePurged)
+
+// Flat open addressing hash map from packed object indices to collider pairs, using linear probing.
+// Pairs of freed objects are not removed one at a time; their signatures already mark them as invalid,
+// so they are dropped in bulk, either when the table reaches half load (growing it in the same pass if that
+// frees little) or once enough colliders have been removed.
+class collider_pair_cache
+{
+	static constexpr uint EMPTY_KEY = std::numeric_limits<uint>::max();
+	static constexpr size_t MIN_CAPACITY = 1024;
+
+	SCP_vector<uint> m_keys;
+	SCP_vector<collider_pair> m_pairs;
+	size_t m_count = 0;
+
+	size_t slot_of(uint key) const
+	{
+		// Fibonacci hashing, keys are two small object indices packed together
+		return static_cast<size_t>((key * 2654435769u) >> 8) & (m_keys.size() - 1);
+	}
+
+	static bool is_live(const collider_pair &pair)
+	{
+		return !pair.is_stale();
+	}
+
+	collider_pair &insert_new(uint key)
+	{
+		size_t slot = slot_of(key);
+
+		while (m_keys[slot] != EMPTY_KEY) {
+			slot = (slot + 1) & (m_keys.size() - 1);
+		}
+
+		m_keys[slot] = key;
+		m_pairs[slot] = collider_pair();
+		++m_count;
+
+		return m_pairs[slot];
+	}
+
+	// rebuilds the table keeping only the entries the predicate accepts, with the capacity
+	// new_capacity_for() picks from the number of entries removed
+	template <typename KeepPredicate, typename CapacityFunc>
+	size_t rebuild(KeepPredicate keep, CapacityFunc new_capacity_for)
+	{
+		static SCP_vector<std::pair<uint, collider_pair>> survivors;
+		survivors.clear();
+
+		for (size_t i = 0; i < m_keys.size(); ++i) {
+			if (m_keys[i] != EMPTY_KEY && keep(m_pairs[i])) {
+				survivors.emplace_back(m_keys[i], m_pairs[i]);
+			}
+		}
+
+		const size_t removed = m_count - survivors.size();
+		const size_t new_capacity = new_capacity_for(removed);
+
+		m_keys.assign(new_capacity, EMPTY_KEY);
+		m_pairs.resize(new_capacity);
+		m_count = 0;
+
+		for (auto &survivor : survivors) {
+			insert_new(survivor.first) = survivor.second;
+		}
+
+		mon_CollisionCachePairs = static_cast<int>(m_count);
+		mon_CollisionCacheCapacity = static_cast<int>(m_keys.size());
+		MONITOR_INC(CollisionCachePurged, static_cast<int>(removed));
+
+		return removed;
+	}
+
+public:
+	// returns the pair for this key, adding a blank one if there is none yet
+	collider_pair &operator[](uint key)
+	{
+		if (m_keys.empty()) {
+			m_keys.assign(MIN_CAPACITY, EMPTY_KEY);
+			m_pairs.resize(MIN_CAPACITY);
+		}
+
+		size_t slot = slot_of(key);
+
+		while (m_keys[slot] != EMPTY_KEY) {
+			if (m_keys[slot] == key) {
+				return m_pairs[slot];
+			}
+
+			slot = (slot + 1) & (m_keys.size() - 1);
+		}
+
+		// keep the load factor at or below one half, getting rid of dead pairs before growing; unless that
+		// frees at least a quarter of the table, grow in the same pass, otherwise we'd soon be back here
+		// rebuilding the whole table for only a handful of free slots
+		if ((m_count + 1) * 2 > m_keys.size()) {
+			const size_t capacity = m_keys.size();
+
+			rebuild(is_live, [capacity](size_t removed) { return (removed * 4 < capacity) ? capacity * 2 : capacity; });
+		}
+
+		mon_CollisionCachePairs = static_cast<int>(m_count + 1);
+
+		return insert_new(key);
+	}
+
+	// drops every pair whose objects are gone, returns the number of pairs removed
+	size_t purge_stale()
+	{
+		const size_t capacity = std::max(m_keys.size(), MIN_CAPACITY);
+
+		return rebuild(is_live, [capacity](size_t) { return capacity; });
+	}
+
+	template <typename Func>
+	void for_each(Func func)
+	{
+		for (size_t i = 0; i < m_keys.size(); ++i) {
+			if (m_keys[i] != EMPTY_KEY) {
+				func(m_pairs[i]);
+			}
+		}
+	}
+
+	size_t size() const { return m_count; }
+
+	void clear()
+	{
+		m_keys.clear();
+		m_keys.shrink_to_fit();
+		m_pairs.clear();
+		m_pairs.shrink_to_fit();
+		m_count = 0;
+
+		mon_CollisionCachePairs = 0;
+		mon_CollisionCacheCapacity = 0;
+	}
 };
 
 static SCP_set<object*> Collision_cache_stale_objects;
-static SCP_unordered_map<uint, collider_pair> Collision_cached_pairs;
+static collider_pair_cache Collision_cached_pairs;
+
+// colliders removed since the last purge of the pair cache
+static size_t Collision_cache_removed_colliders = 0;
 
 class checkobject;
 extern checkobject CheckObjects[MAX_OBJECTS];
@@ -511,11 +663,11 @@ int collide_remove_weapons( )
 	}
 
 	// first pass is to see if any of the weapons don't have collision pairs.
-	for (auto& pair : Collision_cached_pairs) {
-        collider_pair* pair_obj = &pair.second;
+	Collision_cached_pairs.for_each([](collider_pair& pair) {
+		collider_pair* pair_obj = &pair;
 
 		if (!pair_obj->initialized) {
-			continue;
+			return;
 		}
 
 		if (pair_obj->a->type == OBJ_WEAPON && pair_obj->signature_a == pair_obj->a->signature) {
@@ -533,7 +685,7 @@ int collide_remove_weapons( )
 				pair_obj->initialized = false;
 			}
 		}
-	}
+	});
 
 	// for each weapon which could be removed, delete the object
 	int num_deleted = 0;
@@ -605,29 +757,29 @@ void obj_remove_collider(int obj_index)
 	}
 
 	Objects[obj_index].flags.set(Object::Object_Flags::Not_in_coll);
+
+	// the object's pairs are now dead, but they are cleaned out in bulk later on
+	++Collision_cache_removed_colliders;
 }
 
 void obj_reset_colliders()
 {
 	Collision_sort_list.clear();
 	Collision_cached_pairs.clear();
+	Collision_cache_removed_colliders = 0;
 }
 
 void obj_collide_retime_stale_pairs()
 {
 	TRACE_SCOPE(tracing::RetimeCollisionCache);
 
-	auto it = Collision_cached_pairs.begin();
-	while (it != Collision_cached_pairs.end()) {
-		auto &pair = it->second;
-		if (pair.signature_a != pair.a->signature || pair.signature_b != pair.b->signature) {
-			it = Collision_cached_pairs.erase(it);
-		} else {
-			if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
-				pair.next_check_time = timestamp(0);
-			it++;
-		}
-	}
+	Collision_cached_pairs.purge_stale();
+	Collision_cache_removed_colliders = 0;
+
+	Collision_cached_pairs.for_each([](collider_pair& pair) {
+		if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
+			pair.next_check_time = timestamp(0);
+	});
 
 	for (auto objp : Collision_cache_stale_objects)
 		objp->flags.remove(Object::Object_Flags::Collision_cache_stale);
@@ -640,10 +792,22 @@ void obj_collide_obj_cache_stale(object* objp)
 	Collision_cache_stale_objects.insert(objp);
 }
 
+// If set, the broadphase re-sorts every collider list from scratch with obj_quicksort_colliders() and
+// recomputes endpoints on each access, as it used to.  Otherwise endpoints are computed once per frame
+// into Collider_endpoint_min/max and the main collider list is kept sorted from one frame to the next.
+bool Collision_legacy_sort = false;
+DCF_BOOL(collision_legacy_sort, Collision_legacy_sort)
+
+MONITOR(NumColliderSortMoves)
+
 //local helper functions only used in objcollide.cpp
 namespace
 {
 
+// per-axis collider extents for the current frame, indexed by object number
+float Collider_endpoint_min[3][MAX_OBJECTS];
+float Collider_endpoint_max[3][MAX_OBJECTS];
+
 float obj_get_collider_endpoint(int obj_num, int axis, bool min)
 {
     if ( Objects[obj_num].type == OBJ_BEAM ) {
@@ -691,6 +855,61 @@ float obj_get_collider_endpoint(int obj_num, int axis, bool min)
     }
 }
 
+// fill in Collider_endpoint_min/max for every object in the list
+void obj_cache_collider_endpoints(const SCP_vector<int> &list)
+{
+	for (int obj_num : list) {
+		for (int axis = 0; axis < 3; ++axis) {
+			Collider_endpoint_min[axis][obj_num] = obj_get_collider_endpoint(obj_num, axis, true);
+			Collider_endpoint_max[axis][obj_num] = obj_get_collider_endpoint(obj_num, axis, false);
+		}
+	}
+}
+
+inline float obj_collider_min(int obj_num, int axis)
+{
+	return Collision_legacy_sort ? obj_get_collider_endpoint(obj_num, axis, true) : Collider_endpoint_min[axis][obj_num];
+}
+
+inline float obj_collider_max(int obj_num, int axis)
+{
+	return Collision_legacy_sort ? obj_get_collider_endpoint(obj_num, axis, false) : Collider_endpoint_max[axis][obj_num];
+}
+
+// Sorts the list by cached min endpoint on the given axis.  Lists that were sorted last frame are only
+// slightly out of order, so an insertion sort is tried first, falling back to a full sort once it has
+// moved too many entries (e.g. lots of new colliders appended at the end of the list).
+void obj_sort_colliders(SCP_vector<int> &list, int axis)
+{
+	Assert( axis >= 0 );
+	Assert( axis <= 2 );
+
+	const float *endpoints = Collider_endpoint_min[axis];
+	const size_t max_moves = 4 * list.size() + 64;
+	size_t moves = 0;
+
+	for (size_t i = 1; i < list.size(); ++i) {
+		const int obj_num = list[i];
+		const float value = endpoints[obj_num];
+		size_t j = i;
+
+		while ( (j > 0) && (endpoints[list[j - 1]] > value) ) {
+			list[j] = list[j - 1];
+			--j;
+		}
+
+		list[j] = obj_num;
+		moves += i - j;
+
+		if (moves > max_moves) {
+			std::sort(list.begin(), list.end(), [endpoints](int a, int b) { return endpoints[a] < endpoints[b]; });
+			break;
+		}
+	}
+
+	MONITOR_INC(NumColliderSortMoves, static_cast<int>(moves));
+}
+
 void obj_quicksort_colliders(SCP_vector<int> *list, int left, int right, int axis)
 {
     Assert( axis >= 0 );
@@ -726,110 +945,227 @@ void obj_quicksort_colliders(SCP_vector<int> *list, int left, int right, int axi
     }
 }
 
-struct collision_thread_data {
-	struct collision_queue_item {
-		obj_pair objs;
-		uint ctype;
-	};
-	struct collision_queue_result {
-		obj_pair objs;
-		bool never_recheck;
-		std::any collision_data;
-		void (*process_collision)( obj_pair *pair,  const std::any& collision_data );
-	};
-
-	std::atomic_size_t queue_length, result_length;
-	std::mutex queue_mutex, result_mutex;
-	std::unique_ptr<SCP_vector<collision_queue_item>> queue_load, queue_process;
-	std::unique_ptr<SCP_vector<collision_queue_result>> queue_results, queue_send;
-
-	collision_thread_data() :
-		queue_length(0),
-		result_length(0),
-		queue_load(std::make_unique<SCP_vector<collision_queue_item>>()),
-		queue_process(std::make_unique<SCP_vector<collision_queue_item>>()),
-		queue_results(std::make_unique<SCP_vector<collision_queue_result>>()),
-		queue_send(std::make_unique<SCP_vector<collision_queue_result>>()) {}
+struct collision_queue_item {
+	obj_pair objs;
+	uint ctype;
+};
+
+struct collision_queue_result {
+	obj_pair objs;
+	bool never_recheck;
+	std::any collision_data;
+	void (*process_collision)( obj_pair *pair,  const std::any& collision_data );
+};
+
+// Each worker has its own queue, filled round-robin by the main thread during the sweep.  Items are
+// only ever appended while collisions are being processed, so any thread can take the item at 'head'
+// with a single CAS, which lets idle workers steal from busy ones without locking.  Results stay in
+// the worker's own list until all workers are done, and are then handed back to the main thread in bulk.
+struct alignas(64) collision_thread_data {
+	std::unique_ptr<collision_queue_item[]> items;
+	size_t capacity = 0;
+
+	alignas(64) std::atomic_size_t head;	// next item to be taken
+	alignas(64) std::atomic_size_t tail;	// one past the last published item
+
+	SCP_vector<collision_queue_result> results;
+
+	collision_thread_data() : head(0), tail(0) {}
 };
 
+constexpr size_t COLLISION_QUEUE_MIN_CAPACITY = 1024;
+
 std::unique_ptr<collision_thread_data[]> collision_thread_data_buffer;
 std::atomic_bool collision_processing_done = false;
+size_t collision_next_queue = 0;
+bool collision_queue_overflowed = false;
+
+// checks the main thread had to do itself since the queues were full, or picked up while waiting on the workers
+SCP_vector<collision_queue_result> collision_main_thread_results;
+
+// parking for workers that ran out of things to do
+std::mutex collision_park_mutex;
+std::condition_variable collision_park_cv;
+std::atomic_size_t collision_parked_workers = 0;
+size_t collision_park_generation = 0;
+
+bool collision_queue_take(collision_thread_data& queue, collision_queue_item& item_out) {
+	size_t head = queue.head.load(std::memory_order_acquire);
+
+	while (head < queue.tail.load(std::memory_order_acquire)) {
+		// slots are never rewritten while collisions are processed, so copying before claiming is safe
+		item_out = queue.items[head];
+
+		if (queue.head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// take from our own queue first, then try to steal from the others
+bool collision_queue_take_any(size_t first_queue, collision_queue_item& item_out) {
+	const size_t num_workers = threading::get_num_workers();
+
+	for (size_t i = 0; i < num_workers; i++) {
+		if (collision_queue_take(collision_thread_data_buffer[(first_queue + i) % num_workers], item_out)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+collision_queue_result run_mp_collision_check(collision_queue_item& collision_check) {
+	collision_result (*check_collision)( obj_pair *pair ) = nullptr;
+
+	switch( collision_check.ctype )	{
+		case COLLISION_OF(OBJ_WEAPON, OBJ_SHIP):
+		case COLLISION_OF(OBJ_SHIP, OBJ_WEAPON):
+			check_collision = collide_ship_weapon_check;
+			break;
+		case COLLISION_OF(OBJ_SHIP, OBJ_SHIP):
+			check_collision = collide_ship_ship_check;
+			break;
+		default:
+			UNREACHABLE("Got non MP-compatible collision type %d!", collision_check.ctype);
+			// treat the bad pair as never colliding
+			return collision_queue_result{collision_check.objs, true, std::any(), nullptr};
+	}
+
+	auto&& [never_check_again, collision_data_maybe, collision_fnc] = check_collision(&collision_check.objs);
+
+	return collision_queue_result{collision_check.objs, never_check_again, collision_data_maybe, collision_fnc};
+}
+
+void unpark_mp_collision_workers(bool all) {
+	{
+		std::scoped_lock lock(collision_park_mutex);
+		++collision_park_generation;
+	}
+
+	if (all) {
+		collision_park_cv.notify_all();
+	} else {
+		collision_park_cv.notify_one();
+	}
+}
+
+void park_mp_collision_worker(size_t threadIdx) {
+	std::unique_lock<std::mutex> lk(collision_park_mutex);
+	const size_t generation = collision_park_generation;
+
+	collision_parked_workers.fetch_add(1, std::memory_order_seq_cst);
+
+	// the main thread only wakes us up if it sees us parked, so check for work again now that we are
+	bool has_work = collision_processing_done.load(std::memory_order_seq_cst);
+	const size_t num_workers = threading::get_num_workers();
+	for (size_t i = 0; i < num_workers && !has_work; i++) {
+		auto& queue = collision_thread_data_buffer[(threadIdx + i) % num_workers];
+		has_work = queue.head.load(std::memory_order_seq_cst) < queue.tail.load(std::memory_order_seq_cst);
+	}
+
+	if (!has_work) {
+		collision_park_cv.wait(lk, [generation]() { return collision_park_generation != generation; });
+	}
+
+	collision_parked_workers.fetch_sub(1, std::memory_order_seq_cst);
+}
 
 void spin_up_mp_collision() {
+	const size_t num_workers = threading::get_num_workers();
+
+	for (size_t i = 0; i < num_workers; i++) {
+		auto& thread = collision_thread_data_buffer[i];
+
+		if (thread.capacity == 0 || collision_queue_overflowed) {
+			thread.capacity = std::max(thread.capacity * 2, COLLISION_QUEUE_MIN_CAPACITY);
+			thread.items = std::make_unique<collision_queue_item[]>(thread.capacity);
+		}
+
+		thread.head.store(0, std::memory_order_relaxed);
+		thread.tail.store(0, std::memory_order_relaxed);
+		thread.results.clear();
+	}
+
+	collision_next_queue = 0;
+	collision_queue_overflowed = false;
+	collision_main_thread_results.clear();
+
 	collision_processing_done.store(false);
 	threading::spin_up_threaded_task(threading::WorkerThreadTask::COLLISION);
 }
 
 void spin_down_mp_collision() {
 	threading::spin_down_threaded_task();
-	collision_processing_done.store(true);
+	collision_processing_done.store(true, std::memory_order_seq_cst);
+	unpark_mp_collision_workers(true);
 	threading::spin_down_wait_complete();
 }
 
 void queue_mp_collision(uint ctype, const obj_pair& colliding) {
-	size_t min_queue_length = std::numeric_limits<size_t>::max();
-	size_t target_thread = 0;
-	for (size_t i = 0; i < threading::get_num_workers(); i++) {
-		size_t queue_length = collision_thread_data_buffer[i].queue_length.load(std::memory_order_acquire);
-		if (queue_length == 0) {
-			target_thread = i;
-			break;
-		}
-		else if (queue_length < min_queue_length) {
-			target_thread = i;
-			min_queue_length = queue_length;
+	const size_t num_workers = threading::get_num_workers();
+	collision_queue_item item{colliding, ctype};
+
+	// plain round-robin, since workers steal from each other there's no need to balance queue lengths here
+	for (size_t i = 0; i < num_workers; i++) {
+		auto& thread = collision_thread_data_buffer[collision_next_queue];
+		collision_next_queue = (collision_next_queue + 1) % num_workers;
+
+		// only the main thread ever writes to tail
+		const size_t tail = thread.tail.load(std::memory_order_relaxed);
+
+		if (tail < thread.capacity) {
+			thread.items[tail] = item;
+			thread.tail.store(tail + 1, std::memory_order_seq_cst);
+
+			if (collision_parked_workers.load(std::memory_order_seq_cst) > 0) {
+				unpark_mp_collision_workers(false);
+			}
+
+			return;
 		}
 	}
-	{
-		auto& thread = collision_thread_data_buffer[target_thread];
-		std::scoped_lock lock(thread.queue_mutex);
-		thread.queue_load->emplace_back( collision_thread_data::collision_queue_item{colliding, ctype} );
-		thread.queue_length.fetch_add(1, std::memory_order_release);
-	}
-}
 
-void post_process_threaded_collisions() {
-	SCP_map<size_t, size_t> workerThreads;
-	for (size_t i = 0; i < threading::get_num_workers(); i++)
-		workerThreads.emplace(i, 0);
+	// all queues are full, so check this one ourselves and make the queues bigger next frame
+	collision_queue_overflowed = true;
+	collision_main_thread_results.push_back(run_mp_collision_check(item));
+}
 
-	while (!workerThreads.empty()) {
-		for(auto& [i, processed] : workerThreads) {
-			auto& thread = collision_thread_data_buffer[i];
+void process_mp_collision_results(SCP_vector<collision_queue_result>& results) {
+	for (auto& collision : results) {
+		uint key = (OBJ_INDEX(collision.objs.a) << collision_cache_bitshift) + OBJ_INDEX(collision.objs.b);
+		collider_pair *collision_info = &Collision_cached_pairs[key];
 
-			size_t queue_length = thread.queue_length.load(std::memory_order_acquire);
-			size_t result_length = thread.result_length.load(std::memory_order_acquire);
+		if (collision.collision_data.has_value())
+			collision.process_collision(&collision.objs, collision.collision_data);
 
-			if (result_length > processed) {
-				{
-					std::scoped_lock lock(thread.result_mutex);
-					thread.queue_results.swap(thread.queue_send);
-				}
-				for (auto& collision : *thread.queue_send) {
-					uint key = (OBJ_INDEX(collision.objs.a) << collision_cache_bitshift) + OBJ_INDEX(collision.objs.b);
-					collider_pair *collision_info = &Collision_cached_pairs[key];
-
-					if (collision.collision_data.has_value())
-						collision.process_collision(&collision.objs, collision.collision_data);
-
-					if (collision.never_recheck) {
-						collision_info->next_check_time = -1;
-					} else {
-						collision_info->next_check_time = collision.objs.next_check_time;
-					}
-				}
-				processed += thread.queue_send->size();
-				thread.queue_send->clear();
-			}
-			else if (queue_length == 0) {
-				thread.queue_results->clear();
-				workerThreads.erase(i);
-				break;
-			}
+		if (collision.never_recheck) {
+			collision_info->next_check_time = -1;
+		} else {
+			collision_info->next_check_time = collision.objs.next_check_time;
 		}
 	}
 
+	results.clear();
+}
+
+void post_process_threaded_collisions() {
+	// help the workers with whatever is still queued up
+	collision_queue_item item;
+	while (collision_queue_take_any(0, item)) {
+		collision_main_thread_results.push_back(run_mp_collision_check(item));
+	}
+
+	// once this returns, every worker has finished its last check and is idle
 	spin_down_mp_collision();
+
+	for (size_t i = 0; i < threading::get_num_workers(); i++) {
+		process_mp_collision_results(collision_thread_data_buffer[i].results);
+	}
+
+	process_mp_collision_results(collision_main_thread_results);
 }
 
 void obj_collide_pair(object *A, object *B)
@@ -1152,10 +1488,10 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
     for (int in_index : list){
         bool overlapped = false;
 
-        const float min = obj_get_collider_endpoint(in_index, axis, true);
+        const float min = obj_collider_min(in_index, axis);
 
         for (size_t j = 0; j < overlappers.size(); ) {
-            const float overlap_max = obj_get_collider_endpoint(overlappers[j], axis, false);
+            const float overlap_max = obj_collider_max(overlappers[j], axis);
             if ( min <= overlap_max ) {
                 overlapped = true;
 
@@ -1192,45 +1528,25 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
 
 void collide_mp_worker_thread(size_t threadIdx) {
 	auto& thread = collision_thread_data_buffer[threadIdx];
-	thread.result_length.store(0);
-
-	while (!thread.queue_process->empty() || thread.queue_length.load(std::memory_order_acquire) > 0 || !collision_processing_done.load(std::memory_order_acquire)) {
-		if (!thread.queue_process->empty()) {
-
-			for (auto& collision_check : *thread.queue_process) {
-				collision_result (*check_collision)( obj_pair *pair ) = nullptr;
-
-				switch( collision_check.ctype )	{
-					case COLLISION_OF(OBJ_WEAPON, OBJ_SHIP):
-					case COLLISION_OF(OBJ_SHIP, OBJ_WEAPON):
-						check_collision = collide_ship_weapon_check;
-						break;
-					case COLLISION_OF(OBJ_SHIP, OBJ_SHIP):
-						check_collision = collide_ship_ship_check;
-						break;
-					default:
-						UNREACHABLE("Got non MP-compatible collision type %d!", collision_check.ctype);
-						thread.queue_length.fetch_sub(1, std::memory_order_release); // keep the counter balanced
-						continue;                                                    // skip the bad pair
-				}
+	collision_queue_item item;
 
-				auto&& [never_check_again, collision_data_maybe, collision_fnc] = check_collision(&collision_check.objs);
+	while (true) {
+		if (collision_queue_take_any(threadIdx, item)) {
+			thread.results.push_back(run_mp_collision_check(item));
+			continue;
+		}
 
-				{
-					std::scoped_lock lock{thread.result_mutex};
-					thread.queue_results->emplace_back(collision_thread_data::collision_queue_result{collision_check.objs, never_check_again, collision_data_maybe, collision_fnc});
-				}
-				thread.result_length.fetch_add(1, std::memory_order_release);
-				thread.queue_length.fetch_sub(1, std::memory_order_release);
+		// the main thread has stopped queuing and everything is taken, so we're done
+		if (collision_processing_done.load(std::memory_order_acquire)) {
+			if (!collision_queue_take_any(threadIdx, item)) {
+				break;
 			}
-			thread.queue_process->clear();
-		}
-		else if (thread.queue_length.load(std::memory_order_acquire) > 0) {
-			//We must have data in the load queue then.
-			std::scoped_lock lock(thread.queue_mutex);
-			thread.queue_load.swap(thread.queue_process);
-			thread.queue_load->clear();
+
+			thread.results.push_back(run_mp_collision_check(item));
+			continue;
 		}
+
+		park_mp_collision_worker(threadIdx);
 	}
 }
 
@@ -1256,6 +1572,10 @@ void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 
 	if (!Collision_cache_stale_objects.empty()) {
 		obj_collide_retime_stale_pairs();
+	} else if (Collision_cache_removed_colliders * 8 > Collision_sort_list.size()) {
+		// enough colliders have gone away since the last purge that a good part of the cache is dead weight
+		Collision_cached_pairs.purge_stale();
+		Collision_cache_removed_colliders = 0;
 	}
 
 	// the main use case is to go through the main Collision detection list, so use that if
@@ -1264,26 +1584,52 @@ void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 		Collision_list = &Collision_sort_list;
 	}
 
-	sort_list_y.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(Collision_list, 0, (int)(Collision_list->size() - 1), 0);
-	}
-	obj_find_overlap_colliders(sort_list_y, *Collision_list, 0, false);
+	if (Collision_legacy_sort) {
+		sort_list_y.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_quicksort_colliders(Collision_list, 0, (int)(Collision_list->size() - 1), 0);
+		}
+		obj_find_overlap_colliders(sort_list_y, *Collision_list, 0, false);
 
-	sort_list_z.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&sort_list_y, 0, (int)(sort_list_y.size() - 1), 1);
-	}
-	obj_find_overlap_colliders(sort_list_z, sort_list_y, 1, false);
+		sort_list_z.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_quicksort_colliders(&sort_list_y, 0, (int)(sort_list_y.size() - 1), 1);
+		}
+		obj_find_overlap_colliders(sort_list_z, sort_list_y, 1, false);
 
-	sort_list_y.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&sort_list_z, 0, (int)(sort_list_z.size() - 1), 2);
+		sort_list_y.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_quicksort_colliders(&sort_list_z, 0, (int)(sort_list_z.size() - 1), 2);
+		}
+		obj_find_overlap_colliders(sort_list_y, sort_list_z, 2, true);
+	} else {
+		// the collision list keeps its x order between frames, while the y and z lists are rebuilt
+		// each time, so only the first sort is cheap, but all of them avoid recomputing endpoints
+		sort_list_y.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_cache_collider_endpoints(*Collision_list);
+			obj_sort_colliders(*Collision_list, 0);
+		}
+		obj_find_overlap_colliders(sort_list_y, *Collision_list, 0, false);
+
+		sort_list_z.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_sort_colliders(sort_list_y, 1);
+		}
+		obj_find_overlap_colliders(sort_list_z, sort_list_y, 1, false);
+
+		sort_list_y.clear();
+		{
+			TRACE_SCOPE(tracing::SortColliders);
+			obj_sort_colliders(sort_list_z, 2);
+		}
+		obj_find_overlap_colliders(sort_list_y, sort_list_z, 2, true);
 	}
-	obj_find_overlap_colliders(sort_list_y, sort_list_z, 2, true);
 
 	if (threading::is_threading())
 		post_process_threaded_collisions();
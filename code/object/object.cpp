@@ -10,6 +10,7 @@
 
 
 
+#include "ai/aithink.h"
 #include "asteroid/asteroid.h"
 #include "cmeasure/cmeasure.h"
 #include "debris/debris.h"
@@ -32,6 +33,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "observer/observer.h"
@@ -554,6 +556,7 @@ void obj_free(int objnum)
 
 	// remove objp from the used list
 	list_remove( &obj_used_list, objp );
+	obj_grid_invalidate(obj_grid_type::BLAST_TARGETS);
 
 	// add objp to the end of the free
 	list_append( &obj_free_list, objp );
@@ -712,6 +715,7 @@ void obj_delete(int objnum)
 			while(moveup != END_OF_LIST(&Ship_obj_list)){
 				if(OBJ_INDEX(objp) == moveup->objnum){
 					list_remove(&Ship_obj_list,moveup);
+					obj_grid_invalidate(obj_grid_type::SHIPS);
 					break;
 				}
 				moveup = GET_NEXT(moveup);
@@ -830,6 +834,8 @@ void obj_merge_created_list(void)
 	// creates object pairs for it, and then adds it to the used list.
 	//	OLD WAY: list_merge( &obj_used_list, &obj_create_list );
 	object *objp = GET_FIRST(&obj_create_list);
+	bool merged = false;
+
 	while( objp !=END_OF_LIST(&obj_create_list) )	{
 		list_remove( obj_create_list, objp );
 
@@ -838,10 +844,15 @@ void obj_merge_created_list(void)
 
 		// Then add it to the object used list
 		list_append( &obj_used_list, objp );
+		merged = true;
 
 		objp = GET_FIRST(&obj_create_list);
 	}
 
+	if ( merged ) {
+		obj_grid_invalidate(obj_grid_type::BLAST_TARGETS);
+	}
+
 	// Make sure the create list is empty.
 	list_init(&obj_create_list);
 }
@@ -1590,6 +1601,12 @@ void obj_move_all(float frametime)
 
 	obj_merge_created_list();
 
+	// everything has moved since the last frame
+	obj_grid_invalidate();
+
+	// let the AI think about the world before anything in it moves
+	ai_think_all();
+
 	// Clear the table that tells which groups of weapons have cast light so far.
 	if(!(Game_mode & GM_MULTIPLAYER) || (MULTIPLAYER_MASTER)) {
 		obj_clear_weapon_group_id_list();
@@ -0,0 +1,297 @@
+#include "object/objectgrid.h"
+
+#include "debugconsole/console.h"
+#include "globalincs/linklist.h"
+#include "iff_defs/iff_defs.h"
+#include "object/object.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+#include "utils/threading.h"
+#include "weapon/weapon.h"
+
+#include <algorithm>
+#include <cmath>
+
+extern float flFrametime;
+
+// If cleared, queries hand back every object of the requested teams, just like walking the list would
+bool Obj_grid_enabled = true;
+DCF_BOOL(obj_grid, Obj_grid_enabled)
+
+MONITOR(NumObjGridQueries)
+MONITOR(NumObjGridCandidates)
+
+namespace
+{
+
+// Most AI queries reach a few thousand meters, which keeps them to a handful of cells per axis
+const float OBJ_GRID_CELL_SIZE = 1500.0f;
+
+// How far from its center an object may reach.  More than its radius, since the corners of the bounding box
+// some callers measure against can stick out of the model radius.
+const float OBJ_GRID_REACH_SCALE = 2.0f;
+
+// Added to the distance objects can have moved since the grid was built, for collisions pushing things around
+const float OBJ_GRID_MOVEMENT_SLACK = 10.0f;
+
+struct grid_entry {
+	int objnum;
+	int team_mask;
+	int cell[3];
+	vec3d pos;
+	float reach;
+};
+
+struct object_grid {
+	bool valid = false;
+
+	SCP_vector<grid_entry> entries;		// in list order, so sorting entry indices restores the list order
+	SCP_vector<int> big_entries;		// objects reaching past a cell, which every query checks
+	SCP_vector<int> bucket_start;		// bucket b holds bucket_entries[bucket_start[b]] up to bucket_start[b + 1]
+	SCP_vector<int> bucket_entries;
+	SCP_vector<int> bucket_fill;
+	uint bucket_mask = 0;
+
+	float max_reach = 0.0f;				// of the entries in the buckets
+	float movement = 0.0f;				// furthest any object can have moved since the grid was built
+};
+
+object_grid Obj_grids[static_cast<int>(obj_grid_type::NUM_GRIDS)];
+
+int grid_cell(float coord)
+{
+	return static_cast<int>(floorf(coord / OBJ_GRID_CELL_SIZE));
+}
+
+uint grid_hash(int x, int y, int z)
+{
+	return (static_cast<uint>(x) * 73856093u) ^ (static_cast<uint>(y) * 19349663u) ^ (static_cast<uint>(z) * 83492791u);
+}
+
+void grid_add_object(object_grid& grid, int objnum, int team_mask, float* max_speed)
+{
+	auto objp = &Objects[objnum];
+
+	grid_entry entry;
+	entry.objnum = objnum;
+	entry.team_mask = team_mask;
+	entry.pos = objp->pos;
+	entry.reach = objp->radius * OBJ_GRID_REACH_SCALE;
+
+	for (int k = 0; k < 3; k++) {
+		entry.cell[k] = grid_cell(objp->pos.a1d[k]);
+	}
+
+	auto pip = &objp->phys_info;
+	float speed = MAX(vm_vec_mag(&pip->vel), MAX(pip->max_vel.xyz.z, MAX(pip->afterburner_max_vel.xyz.z, pip->booster_max_vel.xyz.z)));
+	*max_speed = MAX(*max_speed, speed);
+
+	grid.entries.push_back(entry);
+}
+
+void grid_build(obj_grid_type type, object_grid& grid)
+{
+	grid.entries.clear();
+	grid.big_entries.clear();
+	grid.max_reach = 0.0f;
+
+	float max_speed = 0.0f;
+
+	if (type == obj_grid_type::SHIPS) {
+		for (auto so : list_range(&Ship_obj_list)) {
+			auto objp = &Objects[so->objnum];
+			grid_add_object(grid, so->objnum, (objp->instance >= 0) ? iff_get_mask(Ships[objp->instance].team) : 0, &max_speed);
+		}
+	} else if (type == obj_grid_type::MISSILES) {
+		for (auto mo : list_range(&Missile_obj_list)) {
+			auto objp = &Objects[mo->objnum];
+			grid_add_object(grid, mo->objnum, (objp->instance >= 0) ? iff_get_mask(Weapons[objp->instance].team) : 0, &max_speed);
+		}
+	} else {
+		for (auto objp : list_range(&obj_used_list)) {
+			if (objp->type == OBJ_WEAPON) {
+				if (Weapon_info[Weapons[objp->instance].weapon_info_index].weapon_hitpoints <= 0)
+					continue;
+			} else if (objp->type != OBJ_SHIP && objp->type != OBJ_ASTEROID) {
+				continue;
+			}
+
+			grid_add_object(grid, OBJ_INDEX(objp), OBJ_GRID_ALL_TEAMS, &max_speed);
+		}
+	}
+
+	// objects move a frame between queries at worst, double that in case they speed up meanwhile
+	grid.movement = 2.0f * max_speed * flFrametime + OBJ_GRID_MOVEMENT_SLACK;
+
+	uint num_buckets = 1;
+	while (num_buckets < grid.entries.size() * 2) {
+		num_buckets <<= 1;
+	}
+	grid.bucket_mask = num_buckets - 1;
+
+	// counting sort of the entries by bucket
+	grid.bucket_start.assign(num_buckets + 1, 0);
+	grid.bucket_entries.clear();
+
+	for (int i = 0; i < static_cast<int>(grid.entries.size()); i++) {
+		auto& entry = grid.entries[i];
+
+		if (entry.reach > OBJ_GRID_CELL_SIZE) {
+			grid.big_entries.push_back(i);
+			continue;
+		}
+
+		grid.max_reach = MAX(grid.max_reach, entry.reach);
+		grid.bucket_start[(grid_hash(entry.cell[0], entry.cell[1], entry.cell[2]) & grid.bucket_mask) + 1]++;
+	}
+
+	for (uint b = 0; b < num_buckets; b++) {
+		grid.bucket_start[b + 1] += grid.bucket_start[b];
+	}
+
+	grid.bucket_entries.resize(grid.bucket_start[num_buckets]);
+	grid.bucket_fill.assign(grid.bucket_start.begin(), grid.bucket_start.end() - 1);
+
+	for (int i = 0; i < static_cast<int>(grid.entries.size()); i++) {
+		auto& entry = grid.entries[i];
+
+		if (entry.reach > OBJ_GRID_CELL_SIZE) {
+			continue;
+		}
+
+		uint bucket = grid_hash(entry.cell[0], entry.cell[1], entry.cell[2]) & grid.bucket_mask;
+		grid.bucket_entries[grid.bucket_fill[bucket]++] = i;
+	}
+
+	grid.valid = true;
+}
+
+object_grid& grid_get(obj_grid_type type)
+{
+	Assertion(type != obj_grid_type::NUM_GRIDS, "Invalid object grid type!");
+
+	auto& grid = Obj_grids[static_cast<int>(type)];
+	if (!grid.valid) {
+		Assertion(!threading::in_job(), "Object grids that jobs query have to be built with obj_grid_build() first!");
+		grid_build(type, grid);
+	}
+
+	return grid;
+}
+
+}
+
+void obj_grid_invalidate()
+{
+	for (auto& grid : Obj_grids) {
+		grid.valid = false;
+	}
+}
+
+void obj_grid_invalidate(obj_grid_type type)
+{
+	Assertion(type != obj_grid_type::NUM_GRIDS, "Invalid object grid type!");
+
+	Obj_grids[static_cast<int>(type)].valid = false;
+}
+
+void obj_grid_build(obj_grid_type type)
+{
+	grid_get(type);
+}
+
+namespace {
+
+void grid_query(const object_grid& grid, const vec3d* pos, float radius, int team_mask, SCP_vector<int>& objnums)
+{
+	objnums.clear();
+
+	if (!Obj_grid_enabled) {
+		for (auto& entry : grid.entries) {
+			if (entry.team_mask & team_mask) {
+				objnums.push_back(entry.objnum);
+			}
+		}
+
+		return;
+	}
+
+	auto in_range = [&](const grid_entry& entry) {
+		if (!(entry.team_mask & team_mask)) {
+			return false;
+		}
+
+		float reach = radius + entry.reach + grid.movement;
+		return (reach >= 0.0f) && (vm_vec_dist_squared(pos, &entry.pos) <= reach * reach);
+	};
+
+	float extent = radius + grid.max_reach + grid.movement;
+	float cells_per_axis = 2.0f * extent / OBJ_GRID_CELL_SIZE + 2.0f;
+
+	// when the query covers more cells than there are objects, looking at every object is cheaper
+	if (cells_per_axis * cells_per_axis * cells_per_axis > static_cast<float>(grid.entries.size())) {
+		for (auto& entry : grid.entries) {
+			if (in_range(entry)) {
+				objnums.push_back(entry.objnum);
+			}
+		}
+
+		return;
+	}
+
+	thread_local SCP_vector<int> found;
+	found.clear();
+
+	int lo[3], hi[3];
+	for (int k = 0; k < 3; k++) {
+		lo[k] = grid_cell(pos->a1d[k] - extent);
+		hi[k] = grid_cell(pos->a1d[k] + extent);
+	}
+
+	for (int x = lo[0]; x <= hi[0]; x++) {
+		for (int y = lo[1]; y <= hi[1]; y++) {
+			for (int z = lo[2]; z <= hi[2]; z++) {
+				uint bucket = grid_hash(x, y, z) & grid.bucket_mask;
+
+				for (int i = grid.bucket_start[bucket]; i < grid.bucket_start[bucket + 1]; i++) {
+					int index = grid.bucket_entries[i];
+					auto& entry = grid.entries[index];
+
+					// other cells can share the bucket
+					if (entry.cell[0] != x || entry.cell[1] != y || entry.cell[2] != z) {
+						continue;
+					}
+
+					if (in_range(entry)) {
+						found.push_back(index);
+					}
+				}
+			}
+		}
+	}
+
+	for (int index : grid.big_entries) {
+		if (in_range(grid.entries[index])) {
+			found.push_back(index);
+		}
+	}
+
+	std::sort(found.begin(), found.end());
+
+	for (int index : found) {
+		objnums.push_back(grid.entries[index].objnum);
+	}
+}
+
+}
+
+void obj_grid_query(obj_grid_type type, const vec3d* pos, float radius, int team_mask, SCP_vector<int>& objnums)
+{
+	grid_query(grid_get(type), pos, radius, team_mask, objnums);
+
+	// the monitors aren't thread safe, so queries from jobs go uncounted
+	if (!threading::in_job()) {
+		MONITOR_INC(NumObjGridQueries, 1);
+		MONITOR_INC(NumObjGridCandidates, static_cast<int>(objnums.size()));
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+// Spatial index over the ship and missile lists and the objects area damage can hit, for code that would otherwise
+// walk a whole list looking for objects near a point.  Each grid is rebuilt lazily from the object positions the first time it is queried in a
+// frame, so a query is only as current as the start of the frame plus whatever the objects could have moved
+// since then.  That movement is padded into every query, which makes the results a superset of the objects in
+// range; callers still measure the real distance of every object they are given.
+
+// BLAST_TARGETS holds the ships, asteroids and weapons with hitpoints in obj_used_list, in that list's order, for
+// shockwaves and other area damage.  Its objects match every team mask.
+enum class obj_grid_type { SHIPS, MISSILES, BLAST_TARGETS, NUM_GRIDS };
+
+// Query every team
+#define OBJ_GRID_ALL_TEAMS	(-1)
+
+// Throws away all grids.  Called at the start of every frame, since everything has moved.
+void obj_grid_invalidate();
+
+// Throws away just the one grid.  Called whenever an object enters or leaves the list that grid is built from.
+void obj_grid_invalidate(obj_grid_type type);
+
+// Rebuilds the grid now if it is out of date, so that queries from several threads don't have to.
+void obj_grid_build(obj_grid_type type);
+
+// Fills objnums with every object of the grid whose team matches team_mask and whose bounding box may come
+// within radius of pos.  The objects are in the same order as in Ship_obj_list or Missile_obj_list, so loops
+// (or obj_used_list) with first-come tie breaks behave as if they walked the list themselves.  Objects that should be dead are
+// not filtered out.
+void obj_grid_query(obj_grid_type type, const vec3d* pos, float radius, int team_mask, SCP_vector<int>& objnums);
@@ -1032,6 +1032,7 @@ int	Sexp_clipboard = -1;  // used by Fred
 
 int Num_sexp_nodes = 0;
 sexp_node *Sexp_nodes = nullptr;
+sexp_node_data *Sexp_node_data = nullptr;
 
 sexp_variable Sexp_variables[MAX_SEXP_VARIABLES];
 sexp_variable Block_variables[MAX_SEXP_VARIABLES];			// used for compatibility with retail. 
@@ -1277,10 +1278,10 @@ int arg_item::is_empty()
 void clear_cache(int node)
 {
 	// free anything cached
-	if (Sexp_nodes[node].cache)
+	if (Sexp_node_data[node].cache)
 	{
-		delete Sexp_nodes[node].cache;
-		Sexp_nodes[node].cache = nullptr;
+		delete Sexp_node_data[node].cache;
+		Sexp_node_data[node].cache = nullptr;
 	}
 
 	// note that cached_variable_index is not reset here because it is a parallel cache (c.f. sexp_get_variable_index)
@@ -1315,7 +1316,9 @@ void sexp_nodes_init()
 	if (last_persistent_node == -1)
 	{
 		vm_free(Sexp_nodes);
+		vm_free(Sexp_node_data);
 		Sexp_nodes = nullptr;
+		Sexp_node_data = nullptr;
 		Num_sexp_nodes = 0;
 	}
 	// if there's enough of a difference to make it worthwhile, free some nodes
@@ -1326,7 +1329,8 @@ void sexp_nodes_init()
 		Num_sexp_nodes += SEXP_NODE_INCREMENT - (Num_sexp_nodes % SEXP_NODE_INCREMENT);
 
 		Sexp_nodes = (sexp_node *) vm_realloc(Sexp_nodes, sizeof(sexp_node) * Num_sexp_nodes);
-		Verify(Sexp_nodes != nullptr);
+		Sexp_node_data = (sexp_node_data *) vm_realloc(Sexp_node_data, sizeof(sexp_node_data) * Num_sexp_nodes);
+		Verify(Sexp_nodes != nullptr && Sexp_node_data != nullptr);
 	}
 
 	nprintf(("SEXP", "Exited function with %d nodes.\n", Num_sexp_nodes));
@@ -1342,7 +1346,9 @@ static void sexp_nodes_close()
 			clear_cache(i);
 
 		vm_free(Sexp_nodes);
+		vm_free(Sexp_node_data);
 		Sexp_nodes = nullptr;
+		Sexp_node_data = nullptr;
 		Num_sexp_nodes = 0;
 	}
 }
@@ -1356,6 +1362,7 @@ void init_sexp()
 	Sexp_current_argument_nesting_level = 0;
 	Current_sexp_network_packet.initialize();
 
+	sexp_clear_programs();
 	sexp_nodes_init();
 	init_sexp_vars();
 	init_sexp_containers();
@@ -1454,12 +1461,14 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 		// allocate in blocks of SEXP_NODE_INCREMENT
 		Num_sexp_nodes += SEXP_NODE_INCREMENT;
 		Sexp_nodes = (sexp_node *) vm_realloc(Sexp_nodes, sizeof(sexp_node) * Num_sexp_nodes);
+		Sexp_node_data = (sexp_node_data *) vm_realloc(Sexp_node_data, sizeof(sexp_node_data) * Num_sexp_nodes);
 
-		Verify(Sexp_nodes != nullptr);
+		Verify(Sexp_nodes != nullptr && Sexp_node_data != nullptr);
 		nprintf(("SEXP", "Bumping dynamic sexp node limit from %d to %d...\n", old_size, Num_sexp_nodes));
 
 		// clear all the new sexp nodes we just allocated
 		memset(&Sexp_nodes[old_size], 0, sizeof(sexp_node) * SEXP_NODE_INCREMENT); //-V512
+		memset(&Sexp_node_data[old_size], 0, sizeof(sexp_node_data) * SEXP_NODE_INCREMENT); //-V512
 
 		// our new sexp is the first out of the ones we just created
 		node = old_size;
@@ -1470,7 +1479,7 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 	Assert(strlen(text) < TOKEN_LENGTH);
 	Assert(type >= 0);
 
-	strcpy_s(Sexp_nodes[node].text, text);
+	strcpy_s(Sexp_node_data[node].text, text);
 	Sexp_nodes[node].type = type;
 	Sexp_nodes[node].subtype = subtype;
 	Sexp_nodes[node].first = first;
@@ -1478,9 +1487,9 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 	Sexp_nodes[node].value = SEXP_UNKNOWN;
 	Sexp_nodes[node].flags = SNF_DEFAULT_VALUE;
 	Sexp_nodes[node].op_index = NO_OPERATOR_INDEX_DEFINED;
-	Sexp_nodes[node].cache = nullptr;
-	Sexp_nodes[node].cached_variable_index = -1;
-	Sexp_nodes[node].duration_index = -1;
+	Sexp_node_data[node].cache = nullptr;
+	Sexp_node_data[node].cached_variable_index = -1;
+	Sexp_node_data[node].duration_index = -1;
 
 	// special-arg?
 	if (type == SEXP_ATOM && !strcmp(text, SEXP_ARGUMENT_STRING))
@@ -1594,6 +1603,8 @@ int free_one_sexp(int num)
 	return 1;
 }
 
+static void sexp_program_node_freed(int node);
+
 /**
  * Free a used sexp node, so it can be reused later.  
  *
@@ -1617,6 +1628,10 @@ int free_sexp(int num, int calling_node)
 	clear_cache(num);
 	count++;
 
+	// a program must not outlive any of its nodes
+	if (Sexp_nodes[num].flags & SNF_IN_SEXP_PROGRAM)
+		sexp_program_node_freed(num);
+
 	i = Sexp_nodes[num].first;
 	while (i != -1) 
 	{
@@ -1679,8 +1694,8 @@ void flush_sexp_tree(int node)
 
 	Sexp_nodes[node].value = SEXP_UNKNOWN;
 	clear_cache(node);
-	Sexp_nodes[node].cached_variable_index = -1;
-	Sexp_nodes[node].duration_index = -1;
+	Sexp_node_data[node].cached_variable_index = -1;
+	Sexp_node_data[node].duration_index = -1;
 
 	flush_sexp_tree(Sexp_nodes[node].first);
 	flush_sexp_tree(Sexp_nodes[node].rest);
@@ -1723,7 +1738,7 @@ int dup_sexp_chain(int node)
 	// TODO - CASE OF SEXP VARIABLES - ONLY 1 COPY OF VARIABLE
 	first = dup_sexp_chain(Sexp_nodes[node].first);
 	rest = dup_sexp_chain(Sexp_nodes[node].rest);
-	cur = alloc_sexp(Sexp_nodes[node].text, Sexp_nodes[node].type, Sexp_nodes[node].subtype, first, rest);
+	cur = alloc_sexp(Sexp_node_data[node].text, Sexp_nodes[node].type, Sexp_nodes[node].subtype, first, rest);
 
 	if (cur == -1) {
 		if (first != -1){
@@ -1752,7 +1767,7 @@ int cmp_sexp_chains(int node1, int node2)
 	}
 
 	// DA: 1/7/99 Need to check the actual Sexp_node.text, not possible variable, which can be equal
-	if (stricmp(Sexp_nodes[node1].text, Sexp_nodes[node2].text) != 0){
+	if (stricmp(Sexp_node_data[node1].text, Sexp_node_data[node2].text) != 0){
 		return 0;
 	}
 
@@ -1928,7 +1943,7 @@ int get_operator_index(int node)
 		return Sexp_nodes[node].op_index;
 	}
 
-	int index = get_operator_index(Sexp_nodes[node].text); 
+	int index = get_operator_index(Sexp_node_data[node].text); 
 	Sexp_nodes[node].op_index = index;
 	return index;
 }
@@ -2308,14 +2323,14 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 				return SEXP_CHECK_MISSING_CONTAINER_MODIFIER;
 			}
 
-			const auto *p_data_container = get_sexp_container(Sexp_nodes[node].text);
+			const auto *p_data_container = get_sexp_container(Sexp_node_data[node].text);
 			// name should have already been checked in get_sexp()
 			Assertion(p_data_container,
 				"Attempt to check type of container data for SEXP operator %s at arg %d for non-existent container %s. "
 				"Please report!",
 				Operators[op_index].text.c_str(),
 				argnum,
-				Sexp_nodes[node].text);
+				Sexp_node_data[node].text);
 			const auto &data_container = *p_data_container;
 
 			if (!check_container_data_type(desired_argument_type,
@@ -2331,10 +2346,10 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 					(Sexp_nodes[modifier_node].subtype != SEXP_ATOM_CONTAINER_DATA)) {
 				Assertion(Sexp_nodes[modifier_node].subtype != SEXP_ATOM_CONTAINER_NAME,
 					"Attempt to use container name %s as modifier for container %s. Please report!",
-					Sexp_nodes[modifier_node].text,
-					Sexp_nodes[node].text);
+					Sexp_node_data[modifier_node].text,
+					Sexp_node_data[node].text);
 				if (data_container.is_list()) {
-					const auto modifier = get_list_modifier(Sexp_nodes[modifier_node].text);
+					const auto modifier = get_list_modifier(Sexp_node_data[modifier_node].text);
 					if ((Sexp_nodes[modifier_node].subtype != SEXP_ATOM_STRING) ||
 							(modifier == ListModifier::INVALID)) {
 						if (bad_node)
@@ -2350,7 +2365,7 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 						}
 						// we can't check that index < length because we don't know what the length will be then
 						if (Sexp_nodes[list_index_node].subtype != SEXP_ATOM_NUMBER ||
-								atoi(Sexp_nodes[list_index_node].text) < 0) {
+								atoi(Sexp_node_data[list_index_node].text) < 0) {
 							if (bad_node)
 								*bad_node = list_index_node;
 							return SEXP_CHECK_INVALID_LIST_MODIFIER;
@@ -2434,7 +2449,7 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 				if (node_return_type == OPR_NUMBER){
 					// for numeric literals, check whether the number is negative
 					if (node_subtype == SEXP_ATOM_NUMBER){
-						if (*Sexp_nodes[node].text == '-')
+						if (*Sexp_node_data[node].text == '-')
 							return SEXP_CHECK_NEGATIVE_NUM;
 					}
 
@@ -2673,14 +2688,14 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 						if (op_const < First_available_operator_id) {
 							ship_node = CDR(op_node);
 						} else {
-							int r_count = get_dynamic_parameter_index(Sexp_nodes[op_node].text, argnum);
+							int r_count = get_dynamic_parameter_index(Sexp_node_data[op_node].text, argnum);
 							
 							if (r_count < 0)
 								error_display(1,
 									"Expected to find a dynamic lua parent parameter for node %i in operator %s but "
 									"found nothing!",
 									argnum,
-									Sexp_nodes[op_node].text);
+									Sexp_node_data[op_node].text);
 							
 							ship_node = op_node; //initialize it I guess
 							while (r_count >= 0) {
@@ -3417,14 +3432,14 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 							ship_node = CDR(z);
 						} else if (desired_argument_type == OPF_DOCKER_POINT) {
 							if (op_const >= First_available_operator_id) {
-								int r_count = get_dynamic_parameter_index(Sexp_nodes[op_node].text, argnum);
+								int r_count = get_dynamic_parameter_index(Sexp_node_data[op_node].text, argnum);
 								
 								if (r_count < 0)
 									error_display(1,
 										"Expected to find a dynamic lua parent parameter for node %i in operator %s "
 										"but found nothing!",
 										argnum,
-										Sexp_nodes[op_node].text);
+										Sexp_node_data[op_node].text);
 								
 								ship_node = op_node; // initialize it I guess
 								while (r_count >= 0) {
@@ -3438,14 +3453,14 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 						} else if (desired_argument_type == OPF_DOCKEE_POINT) {
 							ship_node = CDDDR(z);
 						} else if (op_const >= First_available_operator_id) {
-							int r_count = get_dynamic_parameter_index(Sexp_nodes[op_node].text, argnum);
+							int r_count = get_dynamic_parameter_index(Sexp_node_data[op_node].text, argnum);
 							
 							if (r_count < 0)
 								error_display(1,
 									"Expected to find a dynamic lua parent parameter for node %i in operator %s "
 									"but found nothing!",
 									argnum,
-									Sexp_nodes[op_node].text);
+									Sexp_node_data[op_node].text);
 							
 							ship_node = op_node; // initialize it I guess
 							while (r_count >= 0) {
@@ -4042,9 +4057,9 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 					return SEXP_CHECK_TYPE_MISMATCH;
 				}
 
-				p_container = get_sexp_container(Sexp_nodes[node].text);
+				p_container = get_sexp_container(Sexp_node_data[node].text);
 				if (!p_container) {
-					Warning(LOCATION, "Attempt to use unknown container %s. Please report!", Sexp_nodes[node].text);
+					Warning(LOCATION, "Attempt to use unknown container %s. Please report!", Sexp_node_data[node].text);
 					return SEXP_CHECK_TYPE_MISMATCH;
 				}
 
@@ -4074,9 +4089,9 @@ int check_sexp_syntax(int node, int desired_return_type, int recursive, int *bad
 			{
 				if (node_subtype == SEXP_ATOM_CONTAINER_NAME) {
 					// only list containers of strings or map containers with string keys are allowed
-					const auto *p_str_container = get_sexp_container(Sexp_nodes[node].text);
+					const auto *p_str_container = get_sexp_container(Sexp_node_data[node].text);
 					if (!p_str_container) {
-						Warning(LOCATION, "Attempt to use unknown container %s. Please report!", Sexp_nodes[node].text);
+						Warning(LOCATION, "Attempt to use unknown container %s. Please report!", Sexp_node_data[node].text);
 						return SEXP_CHECK_TYPE_MISMATCH;
 					}
 
@@ -4305,7 +4320,7 @@ int check_sexp_potential_issues(int node, int *bad_node, SCP_string &issue_msg)
 							issue_msg = "At least one ship (";
 							issue_msg += Ships[obj.instance].ship_name;
 							issue_msg += ") has \"Does Not Change Position\" and/or \"Does Not Change Orientation\" checked, while this ";
-							issue_msg += Sexp_nodes[node].text;
+							issue_msg += Sexp_node_data[node].text;
 							issue_msg += " operator uses the \"immobile\" flag.  Be aware that all three flags are independent and setting/checking one flag will not "
 								"set/check another.  For convenience, the set-mobile and set-immobile operators will clear conflicting flags, but alter-ship-flag will not.";
 							return SEXP_CHECK_POTENTIAL_ISSUE;
@@ -4535,13 +4550,13 @@ void localize_sexp(int text_node, int id_node)
 	if (text_node < 0 || id_node < 0)
 		return;
 
-	int id = atoi(Sexp_nodes[id_node].text);
+	int id = atoi(Sexp_node_data[id_node].text);
 	Assert(id < 10000000);
 	SCP_string xstr;
-	sprintf(xstr, "XSTR(\"%s\", %d)", Sexp_nodes[text_node].text, id);
+	sprintf(xstr, "XSTR(\"%s\", %d)", Sexp_node_data[text_node].text, id);
 
-	memset(Sexp_nodes[text_node].text, 0, TOKEN_LENGTH * sizeof(char));
-	lcl_ext_localize(xstr.c_str(), Sexp_nodes[text_node].text, TOKEN_LENGTH - 1);
+	memset(Sexp_node_data[text_node].text, 0, TOKEN_LENGTH * sizeof(char));
+	lcl_ext_localize(xstr.c_str(), Sexp_node_data[text_node].text, TOKEN_LENGTH - 1);
 }
 
 // Advance to and consume the closing parenthesis of a sexp, in case of a parse error.
@@ -5235,39 +5250,39 @@ void stuff_sexp_text_string(SCP_string &dest, int node, int mode)
 	Assert((node >= 0) && (node < Num_sexp_nodes));
 
 	if (Sexp_nodes[node].subtype == SEXP_ATOM_CONTAINER_NAME) {
-		Assertion(get_sexp_container(Sexp_nodes[node].text) != nullptr,
+		Assertion(get_sexp_container(Sexp_node_data[node].text) != nullptr,
 			"Couldn't find container: %s\n",
-			Sexp_nodes[node].text);
+			Sexp_node_data[node].text);
 
-		sprintf(dest, "%s%s ", sexp_container::NAME_NODE_PREFIX.c_str(), Sexp_nodes[node].text);
+		sprintf(dest, "%s%s ", sexp_container::NAME_NODE_PREFIX.c_str(), Sexp_node_data[node].text);
 	}
 	else if (Sexp_nodes[node].subtype == SEXP_ATOM_CONTAINER_DATA) {
-		Assertion(get_sexp_container(Sexp_nodes[node].text) != nullptr,
+		Assertion(get_sexp_container(Sexp_node_data[node].text) != nullptr,
 			"Couldn't find container: %s\n",
-			Sexp_nodes[node].text);
+			Sexp_node_data[node].text);
 
-		sprintf(dest, "%c%s%c ", sexp_container::DELIM, Sexp_nodes[node].text, sexp_container::DELIM);
+		sprintf(dest, "%c%s%c ", sexp_container::DELIM, Sexp_node_data[node].text, sexp_container::DELIM);
 	}
 	else if (Sexp_nodes[node].type & SEXP_FLAG_VARIABLE)
 	{
-		int sexp_variables_index = get_index_sexp_variable_name(Sexp_nodes[node].text);
+		int sexp_variables_index = get_index_sexp_variable_name(Sexp_node_data[node].text);
 		// during the last pass through error-reporting mode, sexp variables have already been transcoded to their indexes
 		if (mode == SEXP_ERROR_CHECK_MODE && sexp_variables_index < 0)
 		{
-			if (can_construe_as_integer(Sexp_nodes[node].text))
-				sexp_variables_index = atoi(Sexp_nodes[node].text);
+			if (can_construe_as_integer(Sexp_node_data[node].text))
+				sexp_variables_index = atoi(Sexp_node_data[node].text);
 		}
 
 		const char *var_name, *var_contents;
 		if (sexp_variables_index < 0)
 		{
-			Warning(LOCATION, "Couldn't find variable: %s\n", Sexp_nodes[node].text);
-			var_name = Sexp_nodes[node].text;
+			Warning(LOCATION, "Couldn't find variable: %s\n", Sexp_node_data[node].text);
+			var_name = Sexp_node_data[node].text;
 			var_contents = "undefined";
 		}
 		else
 		{
-			var_name = (Fred_running) ? Sexp_nodes[node].text : Sexp_variables[sexp_variables_index].variable_name;
+			var_name = (Fred_running) ? Sexp_node_data[node].text : Sexp_variables[sexp_variables_index].variable_name;
 			var_contents = Sexp_variables[sexp_variables_index].text;
 			Assertion((Sexp_variables[sexp_variables_index].type & SEXP_VARIABLE_NUMBER) || (Sexp_variables[sexp_variables_index].type & SEXP_VARIABLE_STRING), "Variable %s must be either a number or a string!", var_name);
 		}
@@ -5447,7 +5462,7 @@ void ensure_opf_positive_is_positive(int node, int &val)
 			int parent_node = find_parent_operator(node);	// these calls are known to be valid because
 			int arg_num = find_argnum(parent_node, node);	// they are prerequisites to marking the node
 
-			Warning(LOCATION, "Parent node \"%s\", argument %d (token \"%s\", value %d) is negative, but is required to be positive!", Sexp_nodes[parent_node].text, arg_num + 1, Sexp_nodes[node].text, val);
+			Warning(LOCATION, "Parent node \"%s\", argument %d (token \"%s\", value %d) is negative, but is required to be positive!", Sexp_node_data[parent_node].text, arg_num + 1, Sexp_node_data[node].text, val);
 			Warned_about_opf_positive = true;
 		}
 
@@ -5796,13 +5811,13 @@ const ship_registry_entry *eval_ship(int node)
 		return nullptr;
 
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_node_data[node].cache)
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_SHIP)
+		if (Sexp_node_data[node].cache->sexp_node_data_type != OPF_SHIP)
 			return nullptr;
 
-		return &Ship_registry[Sexp_nodes[node].cache->ship_registry_index];
+		return &Ship_registry[Sexp_node_data[node].cache->ship_registry_index];
 	}
 
 	// maybe forward to a special-arg node
@@ -5820,7 +5835,7 @@ const ship_registry_entry *eval_ship(int node)
 	{
 		// cache the value if it can't change later
 		if (!is_node_value_dynamic(node))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_SHIP, -1, ship_it->second);
+			Sexp_node_data[node].cache = new sexp_cached_data(OPF_SHIP, -1, ship_it->second);
 
 		return &Ship_registry[ship_it->second];
 	}
@@ -5839,13 +5854,13 @@ const prop *eval_prop(int node)
 		return nullptr;
 
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_node_data[node].cache)
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_PROP)
+		if (Sexp_node_data[node].cache->sexp_node_data_type != OPF_PROP)
 			return nullptr;
 
-		return prop_id_lookup(Sexp_nodes[node].cache->ship_registry_index);
+		return prop_id_lookup(Sexp_node_data[node].cache->ship_registry_index);
 	}
 
 	// maybe forward to a special-arg node
@@ -5863,7 +5878,7 @@ const prop *eval_prop(int node)
 	{
 		// cache the value if it can't change later
 		if (!is_node_value_dynamic(node))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_PROP, -1, prop_idx);
+			Sexp_node_data[node].cache = new sexp_cached_data(OPF_PROP, -1, prop_idx);
 
 		return prop_id_lookup(prop_idx);
 	}
@@ -5881,13 +5896,13 @@ wing *eval_wing(int node)
 		return nullptr;
 
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_node_data[node].cache)
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_WING)
+		if (Sexp_node_data[node].cache->sexp_node_data_type != OPF_WING)
 			return nullptr;
 
-		return &Wings[Sexp_nodes[node].cache->other_index];
+		return &Wings[Sexp_node_data[node].cache->other_index];
 	}
 
 	// maybe forward to a special-arg node
@@ -5905,7 +5920,7 @@ wing *eval_wing(int node)
 	{
 		// cache the value if it can't change later
 		if (!is_node_value_dynamic(node))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_WING, wing_num);
+			Sexp_node_data[node].cache = new sexp_cached_data(OPF_WING, wing_num);
 
 		return &Wings[wing_num];
 	}
@@ -5916,7 +5931,7 @@ wing *eval_wing(int node)
 
 /**
  * Returns a number parsed from the sexp node text.
- * NOTE: sexp_atoi() should only replace atoi(CTEXT(n)) - it should not replace atoi(Sexp_nodes[node].text) - see commit 9923c87bc1
+ * NOTE: sexp_atoi() should only replace atoi(CTEXT(n)) - it should not replace atoi(Sexp_node_data[node].text) - see commit 9923c87bc1
  */
 int sexp_atoi(int node)
 {
@@ -5927,13 +5942,13 @@ int sexp_atoi(int node)
 	if (!Fred_running)
 	{
 		// check cache
-		if (Sexp_nodes[node].cache)
+		if (Sexp_node_data[node].cache)
 		{
 			// have we cached something else?
-			if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_NUMBER)
+			if (Sexp_node_data[node].cache->sexp_node_data_type != OPF_NUMBER)
 				return 0;
 
-			return Sexp_nodes[node].cache->numeric_literal;
+			return Sexp_node_data[node].cache->numeric_literal;
 		}
 
 		// maybe forward to a special-arg node
@@ -5954,7 +5969,7 @@ int sexp_atoi(int node)
 	{
 		// cache the value if it can't change later
 		if (!is_node_value_dynamic(node))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
+			Sexp_node_data[node].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
 	}
 
 	return num;
@@ -5971,7 +5986,7 @@ bool sexp_can_construe_as_integer(int node)
 	// SEXP caching is not set up to work in FRED, so bypass all the caching code in that case
 	if (!Fred_running)
 	{
-		if (Sexp_nodes[node].cache && Sexp_nodes[node].cache->sexp_node_data_type == OPF_NUMBER)
+		if (Sexp_node_data[node].cache && Sexp_node_data[node].cache->sexp_node_data_type == OPF_NUMBER)
 			return true;
 
 		// maybe forward to a special-arg node
@@ -5998,8 +6013,8 @@ int sexp_get_variable_index(int node)
 	if (node < 0)
 		return -1;
 
-	if (Sexp_nodes[node].cached_variable_index >= 0)
-		return Sexp_nodes[node].cached_variable_index;
+	if (Sexp_node_data[node].cached_variable_index >= 0)
+		return Sexp_node_data[node].cached_variable_index;
 
 	if (!(Sexp_nodes[node].type & SEXP_FLAG_VARIABLE))
 		return -1;
@@ -6007,16 +6022,16 @@ int sexp_get_variable_index(int node)
 	Assert(Sexp_nodes[node].first == -1);
 
 	if (Fred_running)
-		return get_index_sexp_variable_name(Sexp_nodes[node].text);
+		return get_index_sexp_variable_name(Sexp_node_data[node].text);
 
 	// parse it
-	int index = atoi(Sexp_nodes[node].text);
+	int index = atoi(Sexp_node_data[node].text);
 
 	// verify variable set
 	Assert(Sexp_variables[index].type & SEXP_VARIABLE_SET);
 
 	// cache and return
-	Sexp_nodes[node].cached_variable_index = index;
+	Sexp_node_data[node].cached_variable_index = index;
 	return index;
 }
 
@@ -6599,7 +6614,7 @@ int rand_sexp(int node, bool multiple)
 	{
 		// set .value and .text so random number is generated only once.
 		Sexp_nodes[node].value = SEXP_NUM_EVAL;
-		sprintf(Sexp_nodes[node].text, "%d", rand_num);
+		sprintf(Sexp_node_data[node].text, "%d", rand_num);
 
 		// any cached value is no longer relevant because we just changed the text
 		clear_cache(node);
@@ -6609,7 +6624,7 @@ int rand_sexp(int node, bool multiple)
 	{
 		// Set the seed to a new seeded random value. This will ensure that the next time the method
 		// is called it will return a predictable but different number from the previous time. 
-		sprintf(Sexp_nodes[CDDR(node)].text, "%d", rand_internal(1, INT_MAX, seed));
+		sprintf(Sexp_node_data[CDDR(node)].text, "%d", rand_internal(1, INT_MAX, seed));
 
 		// any cached value is no longer relevant because we just changed the text
 		clear_cache(CDDR(node));
@@ -7173,15 +7188,15 @@ void eval_object_ship_wing_point_team(object_ship_wing_point_team *oswpt, int no
 		}
 	}
 	// check caching
-	else if (Sexp_nodes[node].cache)
+	else if (Sexp_node_data[node].cache)
 	{
-		if (Sexp_nodes[node].cache->sexp_node_data_type == OPF_SHIP)
+		if (Sexp_node_data[node].cache->sexp_node_data_type == OPF_SHIP)
 		{
-			ship_registry_index = Sexp_nodes[node].cache->ship_registry_index;
+			ship_registry_index = Sexp_node_data[node].cache->ship_registry_index;
 		}
-		else if (Sexp_nodes[node].cache->sexp_node_data_type == OPF_WING)
+		else if (Sexp_node_data[node].cache->sexp_node_data_type == OPF_WING)
 		{
-			wingnum = Sexp_nodes[node].cache->other_index;
+			wingnum = Sexp_node_data[node].cache->other_index;
 		}
 		// TODO: other caching
 		else
@@ -11543,7 +11558,7 @@ int test_argument_vector_for_condition(const SCP_vector<std::pair<const char*, i
 	// Sexp_applicable_argument_list is a stack and we want the first argument in the list to be the first one out
 	while (!Applicable_arguments_temp.empty())
 	{
-		// if we're using a temporary buffer for the string (as opposed to a permanent buffer like shipp->ship_name or Sexp_nodes[n].text)
+		// if we're using a temporary buffer for the string (as opposed to a permanent buffer like shipp->ship_name or Sexp_node_data[n].text)
 		// then we need to dup the strings, but we need to know whether the calling function dup'd them, or whether we should dup them here
 		if (strdup_status == STRDUP_STATUS::ALREADY_DUPPED)
 			Sexp_applicable_argument_list.add_data_set_dup(Applicable_arguments_temp.back());
@@ -11719,13 +11734,13 @@ int eval_random_of(int arg_handler_node, int condition_node)
 		Sexp_applicable_argument_list.clear_nesting_level();
 
 		// evaluate conditional for current argument
-		Sexp_replacement_arguments.emplace_back(Sexp_nodes[n].text, n);
+		Sexp_replacement_arguments.emplace_back(Sexp_node_data[n].text, n);
 		val = eval_sexp(condition_node);
 
 		// true?
 		if (val == SEXP_TRUE)
 		{
-			Sexp_applicable_argument_list.add_data(Sexp_nodes[n].text, n);
+			Sexp_applicable_argument_list.add_data(Sexp_node_data[n].text, n);
 		}
 		else if (Sexp_nodes[condition_node].value == SEXP_KNOWN_FALSE || Sexp_nodes[condition_node].value == SEXP_NAN_FOREVER)
 		{
@@ -11889,13 +11904,13 @@ int eval_in_sequence(int arg_handler_node, int condition_node)
 		Sexp_applicable_argument_list.clear_nesting_level();
 
 		// evaluate conditional for current argument
-		Sexp_replacement_arguments.emplace_back(Sexp_nodes[n].text, n);
+		Sexp_replacement_arguments.emplace_back(Sexp_node_data[n].text, n);
 		val = eval_sexp(condition_node);
 
 		// true?
 		if (val == SEXP_TRUE)
 		{
-			Sexp_applicable_argument_list.add_data(Sexp_nodes[n].text, n);
+			Sexp_applicable_argument_list.add_data(Sexp_node_data[n].text, n);
 		}
 		else if ((Sexp_nodes[condition_node].value == SEXP_KNOWN_FALSE) || (Sexp_nodes[condition_node].value == SEXP_NAN_FOREVER))
 		{
@@ -12410,10 +12425,10 @@ void sexp_change_argument_validity(int n, bool invalidate)
 		while (invalidate && (arg_n != -1)) {
 			Assertion(Sexp_nodes[arg_n].subtype != SEXP_ATOM_CONTAINER_NAME,
 				"Attempt to use invalidate-argument with container %s. Please report!",
-				Sexp_nodes[arg_n].text);
+				Sexp_node_data[arg_n].text);
 			Assertion(Sexp_nodes[arg_n].subtype != SEXP_ATOM_CONTAINER_DATA,
 				"Attempt to use invalidate-argument with data from container %s. Please report!",
-				Sexp_nodes[arg_n].text);
+				Sexp_node_data[arg_n].text);
 
 			if (Sexp_nodes[arg_n].flags & SNF_ARGUMENT_SELECT) {
 				// now check if the selected argument matches the one we want to invalidate
@@ -12435,10 +12450,10 @@ void sexp_change_argument_validity(int n, bool invalidate)
 			{
 				Assertion(Sexp_nodes[arg_n].subtype != SEXP_ATOM_CONTAINER_NAME,
 					"Attempt to change argument validity of container %s. Please report!",
-					Sexp_nodes[arg_n].text);
+					Sexp_node_data[arg_n].text);
 				Assertion(Sexp_nodes[arg_n].subtype != SEXP_ATOM_CONTAINER_DATA,
 					"Attempt to change argument validity of data from container %s. Please report!",
-					Sexp_nodes[arg_n].text);
+					Sexp_node_data[arg_n].text);
 
 				// match?
 				if (!strcmp(CTEXT(n), CTEXT(arg_n)))
@@ -12645,12 +12660,12 @@ int sexp_functional_switch(int node)
 int sexp_is_true_for_duration(int op_node, int node)
 {
 	// find our start time using the duration slot, creating one if necessary
-	if (Sexp_nodes[op_node].duration_index < 0)
+	if (Sexp_node_data[op_node].duration_index < 0)
 	{
-		Sexp_nodes[op_node].duration_index = static_cast<int>(Sexp_is_true_for_duration_times.size());
+		Sexp_node_data[op_node].duration_index = static_cast<int>(Sexp_is_true_for_duration_times.size());
 		Sexp_is_true_for_duration_times.push_back(Missiontime);
 	}
-	fix& start_time = Sexp_is_true_for_duration_times[Sexp_nodes[op_node].duration_index];
+	fix& start_time = Sexp_is_true_for_duration_times[Sexp_node_data[op_node].duration_index];
 
 	// get the duration we want
 	bool is_nan, is_nan_forever;
@@ -14435,7 +14450,7 @@ void sexp_close_sound_from_file(int n)
 		sexp_var = sexp_get_variable_index(n);
 		if (sexp_var < 0)
 		{
-			Warning(LOCATION, "close-sound-from-file: Variable %s does not exist!", Sexp_nodes[n].text);
+			Warning(LOCATION, "close-sound-from-file: Variable %s does not exist!", Sexp_node_data[n].text);
 			return;
 		}
 
@@ -14500,7 +14515,7 @@ void sexp_play_sound_from_file(int n)
 		sexp_var = sexp_get_variable_index(n);
 		if (sexp_var < 0)
 		{
-			Warning(LOCATION, "play-sound-from-file: Variable %s does not exist!", Sexp_nodes[n].text);
+			Warning(LOCATION, "play-sound-from-file: Variable %s does not exist!", Sexp_node_data[n].text);
 			return;
 		}
 
@@ -14558,7 +14573,7 @@ void sexp_pause_sound_from_file(int n)
 		sexp_var = sexp_get_variable_index(n);
 		if (sexp_var < 0)
 		{
-			Warning(LOCATION, "pause-sound-from-file: Variable %s does not exist!", Sexp_nodes[n].text);
+			Warning(LOCATION, "pause-sound-from-file: Variable %s does not exist!", Sexp_node_data[n].text);
 			return;
 		}
 
@@ -16697,7 +16712,7 @@ void sexp_add_background_bitmap(int n, bool is_sun, bool uses_correct_angles)
 		sexp_var = sexp_get_variable_index(n);
 		if (sexp_var < 0)
 		{
-			Warning(LOCATION, "sexp-add-%s-bitmap: Variable %s does not exist!", is_sun ? "sun" : "background", Sexp_nodes[n].text);
+			Warning(LOCATION, "sexp-add-%s-bitmap: Variable %s does not exist!", is_sun ? "sun" : "background", Sexp_node_data[n].text);
 			return;
 		}
 
@@ -17518,7 +17533,7 @@ void sexp_tech_toggle_intel(int node, bool add, bool xstr)
 	while (n >= 0)
 	{
 		// don't use things like CTEXT or eval_num, since we didn't in the preloader
-		auto name = Sexp_nodes[n].text;
+		auto name = Sexp_node_data[n].text;
 		n = CDR(n);
 
 		// the xstr variant must have an id
@@ -17526,7 +17541,7 @@ void sexp_tech_toggle_intel(int node, bool add, bool xstr)
 		{
 			if (n < 0)
 				break;
-			id = atoi(Sexp_nodes[n].text);
+			id = atoi(Sexp_node_data[n].text);
 			n = CDR(n);
 		}
 		else
@@ -19205,12 +19220,15 @@ void sexp_reset_event(int node)
 			eventp->satisfied_time = TIMESTAMP::invalid();
 			eventp->born_on_date = TIMESTAMP::invalid();
 			eventp->previous_result = 0;
+			eventp->dependency_stamp = 0;
 
 			flush_sexp_tree(eventp->formula);
 		}
 		else
 			Warning(LOCATION, "Could not find event '%s'", name);
 	}
+
+	sexp_dependencies_changed(SEXP_DEP_GOALS_AND_EVENTS);
 }
 
 /**
@@ -19227,6 +19245,7 @@ void sexp_reset_goal(int node)
 			auto goalp = &Mission_goals[goal_num];
 
 			goalp->satisfied = GOAL_INCOMPLETE;
+			goalp->dependency_stamp = 0;
 			flush_sexp_tree(goalp->formula);
 		}
 		else
@@ -19406,7 +19425,7 @@ void sexp_ship_deal_with_subsystem_flag(int op_node, int node, Ship::Subsystem_F
 	}
 
 	//Process subsystems
-	const char *op_name = Sexp_nodes[op_node].text;
+	const char *op_name = Sexp_node_data[op_node].text;
 	process_ship_subsystems(ship_entry, true, node, true, op_name, [&](ProcessSubsystemType type, ship_subsys *ss)
 	{
 		if (type == ProcessSubsystemType::SUBSYSTEM)
@@ -25116,8 +25135,8 @@ int sexp_string_to_int(int n)
 	char *buf_ch, buf[TOKEN_LENGTH];
 	Assert (n != -1);
 
-	if (Sexp_nodes[n].cache)
-		return Sexp_nodes[n].cache->numeric_literal;
+	if (Sexp_node_data[n].cache)
+		return Sexp_node_data[n].cache->numeric_literal;
 
 	// maybe forward to a special-arg node
 	if (Sexp_nodes[n].flags & SNF_SPECIAL_ARG_IN_NODE)
@@ -25154,7 +25173,7 @@ int sexp_string_to_int(int n)
 
 	// cache the value if it can't change later
 	if (!is_node_value_dynamic(n))
-		Sexp_nodes[n].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
+		Sexp_node_data[n].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
 
 	return num;
 }
@@ -25177,7 +25196,7 @@ void sexp_int_to_string(int n)
 	sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "int-to-string: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "int-to-string: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 
@@ -25217,7 +25236,7 @@ void sexp_string_concatenate(int n)
 	sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "string-concatenate: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "string-concatenate: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 
@@ -25257,7 +25276,7 @@ void sexp_string_concatenate_block(int n)
 	sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "string-concatenate-block: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "string-concatenate-block: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 	n = CDR(n);
@@ -25315,7 +25334,7 @@ void sexp_string_get_substring(int node)
 	sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "string-get-substring: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "string-get-substring: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 
@@ -25385,7 +25404,7 @@ void sexp_string_set_substring(int node)
 	sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "string-set-substring: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "string-set-substring: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 
@@ -25463,7 +25482,7 @@ void sexp_modify_variable_xstr(int n)
 	auto sexp_variable_index = sexp_get_variable_index(n);
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "modify-variable-xstr: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "modify-variable-xstr: Variable %s does not exist!", Sexp_node_data[n].text);
 		return;
 	}
 	n = CDR(n);
@@ -25474,7 +25493,7 @@ void sexp_modify_variable_xstr(int n)
 	}
 
 	// get new string
-	const char* new_text = Sexp_nodes[n].text;
+	const char* new_text = Sexp_node_data[n].text;
 
 	// assign to variable
 	sexp_modify_variable(new_text, sexp_variable_index);
@@ -27200,7 +27219,7 @@ int sexp_script_eval(int node, int return_type, bool concat_args = false)
 
 					if (variable_index < 0)
 					{
-						Warning(LOCATION, "script-eval: Variable %s does not exist!", Sexp_nodes[n].text);
+						Warning(LOCATION, "script-eval: Variable %s does not exist!", Sexp_node_data[n].text);
 					}
 					else if (!(Sexp_variables[variable_index].type & SEXP_VARIABLE_STRING))
 					{
@@ -28162,6 +28181,57 @@ void add_to_event_log_buffer(int node, int op_num, int result)
 	Current_event_log_buffer->push_back(std::move(tmp));
 }
 
+/**
+ * Records what an operator returned in its node, and turns the special values into the true or false that
+ * eval_sexp() returns.
+ */
+static int eval_sexp_store_result(int cur_node, int sexp_val)
+{
+	// if we haven't returned, check the sexp value of the sexpression evaluation.  A special
+	// value of known true or known false means that we should set the sexp.value field for
+	// short circuit eval.
+	if (sexp_val == SEXP_KNOWN_TRUE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_TRUE;
+		return SEXP_TRUE;
+	}
+
+	if (sexp_val == SEXP_KNOWN_FALSE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_FALSE;
+		return SEXP_FALSE;
+	}
+
+	if ( sexp_val == SEXP_NAN ) {
+		Sexp_nodes[cur_node].value = SEXP_NAN;			// not a number values are false I would suspect
+		return SEXP_FALSE;
+	}
+
+	if ( sexp_val == SEXP_NAN_FOREVER ) {
+		Sexp_nodes[cur_node].value = SEXP_NAN_FOREVER;
+		// Goober5000 changed from sexp_val to SEXP_FALSE on 2/21/2006 in accordance with above comment
+		// NOTE: we return false rather than known-false to match the SEXP_KNOWN_FALSE case above
+		return SEXP_FALSE;
+	}
+
+	if ( sexp_val == SEXP_CANT_EVAL ) {
+		Sexp_nodes[cur_node].value = SEXP_CANT_EVAL;
+		Assume_event_is_current = false;  // indicate sexp isn't current yet
+		return SEXP_FALSE;
+	}
+
+	if ( Sexp_nodes[cur_node].value == SEXP_NAN ) {	// if we had a nan, but now don't, reset the value
+		Sexp_nodes[cur_node].value = SEXP_UNKNOWN;
+		return sexp_val;
+	}
+
+	if ( sexp_val ){
+		Sexp_nodes[cur_node].value = SEXP_TRUE;
+	} else {
+		Sexp_nodes[cur_node].value = SEXP_FALSE;
+	}
+
+	return sexp_val;
+}
+
 /**
  * High-level sexpression evaluator
  */
@@ -30739,50 +30809,777 @@ int eval_sexp(int cur_node, int referenced_node)
 
 		Assertion(sexp_val != UNINITIALIZED, "SEXP %s didn't return a value!", CTEXT(cur_node));
 
-		// if we haven't returned, check the sexp value of the sexpression evaluation.  A special
-		// value of known true or known false means that we should set the sexp.value field for
-		// short circuit eval.
-		if (sexp_val == SEXP_KNOWN_TRUE) {
-			Sexp_nodes[cur_node].value = SEXP_KNOWN_TRUE;
-			return SEXP_TRUE;
+		return eval_sexp_store_result(cur_node, sexp_val);
+	}
+}
+
+// Goals and events are evaluated over and over for the whole mission, so once a mission has been checked each of
+// their formulas is lowered into a sexp_program: the nodes eval_sexp() would visit, flattened in the order it
+// visits them, with the operator already looked up.  The boolean and comparison operators that make up most
+// conditions are run straight from the program; the objective operators that usually sit at the leaves are called
+// directly, skipping the operator switch; everything else is handed back to eval_sexp().  Every node ends up with
+// the same value it would have had, so the known-true/known-false short-circuiting works exactly as before.
+
+enum class sexp_instruction_kind : ubyte
+{
+	LIST,		// a list node, followed by the operator it holds
+	ATOM,		// a number, variable or other atom that isn't an operator
+	OPERATOR,	// an operator with a handler, followed by whichever of its arguments the handler runs from the program
+	TREE		// anything else, which is evaluated through eval_sexp()
+};
+
+struct sexp_instruction;
+typedef int (*sexp_instruction_handler)(const sexp_instruction *ins);
+
+struct sexp_instruction
+{
+	sexp_instruction_kind kind;
+	int node;
+	int op_num;
+	int num_args;		// arguments that follow in the program
+	int size;			// instructions in this subtree, this one included
+	sexp_instruction_handler handler;
+};
+
+struct sexp_program_operator
+{
+	sexp_instruction_handler handler;
+	int num_args;		// how many arguments are compiled into the program; -1 for all of them, of which there must be one
+};
+
+bool Sexp_programs_enabled = true;
+DCF_BOOL(sexp_programs, Sexp_programs_enabled)
+
+// programs by the node of their formula; a program without instructions is compiled again when it is next run
+static SCP_unordered_map<int, SCP_vector<sexp_instruction>> Sexp_programs;
+static SCP_unordered_map<int, int> Sexp_program_formulas;	// the formula of the program each compiled node is in
+
+static int sexp_program_exec(const sexp_instruction *ins);
+
+static bool sexp_program_is_true(const sexp_instruction *ins)
+{
+	int result = sexp_program_exec(ins);
+	return (result == SEXP_TRUE) || (result == SEXP_KNOWN_TRUE);
+}
+
+static const sexp_instruction *sexp_program_next_arg(const sexp_instruction *arg)
+{
+	return arg + arg->size;
+}
+
+// The boolean operators evaluate their first argument through the operator it holds, and the others through their
+// list nodes; see sexp_and() and friends
+static int sexp_program_and(const sexp_instruction *ins)
+{
+	bool all_true = true;
+	bool result = true;
+
+	auto arg = ins + 1;
+	for (int i = 0; i < ins->num_args; i++, arg = sexp_program_next_arg(arg))
+	{
+		// this should never happen, because all arguments which return logical values are operators
+		if (i == 0 && arg->kind != sexp_instruction_kind::LIST)
+		{
+			result = (sexp_atoi(arg->node) != 0) && result;
+			continue;
 		}
 
-		if (sexp_val == SEXP_KNOWN_FALSE) {
-			Sexp_nodes[cur_node].value = SEXP_KNOWN_FALSE;
-			return SEXP_FALSE;
+		auto eval_ins = (i == 0) ? arg + 1 : arg;
+		result = sexp_program_is_true(eval_ins) && result;
+
+		int value = Sexp_nodes[eval_ins->node].value;
+		if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+			return SEXP_KNOWN_FALSE;
+		if (value != SEXP_KNOWN_TRUE)
+			all_true = false;
+	}
+
+	if (all_true)
+		return SEXP_KNOWN_TRUE;
+
+	return result ? SEXP_TRUE : SEXP_FALSE;
+}
+
+static int sexp_program_or(const sexp_instruction *ins)
+{
+	bool all_false = true;
+	bool result = false;
+
+	auto arg = ins + 1;
+	for (int i = 0; i < ins->num_args; i++, arg = sexp_program_next_arg(arg))
+	{
+		// this should never happen, because all arguments which return logical values are operators
+		if (i == 0 && arg->kind != sexp_instruction_kind::LIST)
+		{
+			result = (sexp_atoi(arg->node) != 0) || result;
+			continue;
 		}
 
-		if ( sexp_val == SEXP_NAN ) {
-			Sexp_nodes[cur_node].value = SEXP_NAN;			// not a number values are false I would suspect
-			return SEXP_FALSE;
+		auto eval_ins = (i == 0) ? arg + 1 : arg;
+		result = sexp_program_is_true(eval_ins) || result;
+
+		int value = Sexp_nodes[eval_ins->node].value;
+		if (value == SEXP_KNOWN_TRUE)
+			return SEXP_KNOWN_TRUE;
+		if (value != SEXP_KNOWN_FALSE)
+			all_false = false;
+	}
+
+	if (all_false)
+		return SEXP_KNOWN_FALSE;
+
+	return result ? SEXP_TRUE : SEXP_FALSE;
+}
+
+static int sexp_program_not(const sexp_instruction *ins)
+{
+	bool result = false;
+
+	if (ins->num_args > 0)
+	{
+		auto arg = ins + 1;
+
+		if (arg->kind == sexp_instruction_kind::LIST)
+		{
+			result = sexp_program_is_true(arg + 1);
+
+			int value = Sexp_nodes[(arg + 1)->node].value;
+			if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+				return SEXP_KNOWN_TRUE;
+			else if (value == SEXP_KNOWN_TRUE)
+				return SEXP_KNOWN_FALSE;
+			else if (value == SEXP_NAN)
+				return SEXP_TRUE;
 		}
+		else
+			result = (sexp_atoi(arg->node) != 0);
+	}
 
-		if ( sexp_val == SEXP_NAN_FOREVER ) {
-			Sexp_nodes[cur_node].value = SEXP_NAN_FOREVER;
-			// Goober5000 changed from sexp_val to SEXP_FALSE on 2/21/2006 in accordance with above comment
-			// NOTE: we return false rather than known-false to match the SEXP_KNOWN_FALSE case above
-			return SEXP_FALSE;
+	return result ? SEXP_FALSE : SEXP_TRUE;
+}
+
+// same as sexp_number_compare(), down to which nodes it looks at for NaNs
+static int sexp_program_number_compare(const sexp_instruction *ins)
+{
+	auto arg = ins + 1;
+	int first_node = arg->node;
+	int first_number = sexp_program_exec(arg);
+
+	// bail on NANs
+	if (CAR(first_node) != -1)
+	{
+		if (Sexp_nodes[CAR(first_node)].value == SEXP_NAN) return SEXP_FALSE;
+		if (Sexp_nodes[CAR(first_node)].value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
+	}
+	if (CDR(first_node) != -1)
+	{
+		if (Sexp_nodes[CDR(first_node)].value == SEXP_NAN) return SEXP_FALSE;
+		if (Sexp_nodes[CDR(first_node)].value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
+	}
+
+	// compare first node with each of the others
+	for (int i = 1; i < ins->num_args; i++)
+	{
+		arg = sexp_program_next_arg(arg);
+		int current_node = arg->node;
+
+		// bail on NANs
+		if (CAR(current_node) != -1)
+		{
+			if (Sexp_nodes[CAR(current_node)].value == SEXP_NAN) return SEXP_FALSE;
+			if (Sexp_nodes[CAR(current_node)].value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
+		}
+		if (CDR(current_node) != -1)
+		{
+			if (Sexp_nodes[CDR(current_node)].value == SEXP_NAN) return SEXP_FALSE;
+			if (Sexp_nodes[CDR(current_node)].value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
 		}
 
-		if ( sexp_val == SEXP_CANT_EVAL ) {
-			Sexp_nodes[cur_node].value = SEXP_CANT_EVAL;
-			Assume_event_is_current = false;  // indicate sexp isn't current yet
-			return SEXP_FALSE;
+		int current_number = sexp_program_exec(arg);
+
+		// must satisfy our particular operator
+		switch (ins->op_num)
+		{
+			case OP_EQUALS:
+				if (first_number != current_number) return SEXP_FALSE;
+				break;
+
+			case OP_NOT_EQUAL:
+				if (first_number == current_number) return SEXP_FALSE;
+				break;
+
+			case OP_GREATER_THAN:
+				if (first_number <= current_number) return SEXP_FALSE;
+				break;
+
+			case OP_GREATER_OR_EQUAL:
+				if (first_number < current_number) return SEXP_FALSE;
+				break;
+
+			case OP_LESS_THAN:
+				if (first_number >= current_number) return SEXP_FALSE;
+				break;
+
+			case OP_LESS_OR_EQUAL:
+				if (first_number > current_number) return SEXP_FALSE;
+				break;
+
+			default:
+				Warning(LOCATION, "Unhandled comparison case!  Operator = %d", ins->op_num);
+				break;
+		}
+	}
+
+	// it satisfies the operator for all the arguments
+	return SEXP_TRUE;
+}
+
+// same as eval_num()
+static int sexp_program_eval_num(const sexp_instruction *arg, bool &is_nan, bool &is_nan_forever)
+{
+	is_nan = false;
+	is_nan_forever = false;
+
+	if (arg->kind != sexp_instruction_kind::LIST)
+		return sexp_atoi(arg->node);
+
+	auto op = arg + 1;
+	int val = sexp_program_exec(op);
+
+	// NaNs will propagate through operations, so let the calling function know
+	if (Sexp_nodes[op->node].value == SEXP_NAN)
+	{
+		val = 0;
+		is_nan = true;
+	}
+	else if (Sexp_nodes[op->node].value == SEXP_NAN_FOREVER)
+	{
+		val = 0;
+		is_nan_forever = true;
+	}
+	else
+		ensure_opf_positive_is_positive(op->node, val);
+
+	return val;
+}
+
+static int sexp_program_has_time_elapsed(const sexp_instruction *ins)
+{
+	bool is_nan, is_nan_forever;
+	int time = sexp_program_eval_num(ins + 1, is_nan, is_nan_forever);
+	if (is_nan)
+		return SEXP_FALSE;
+	if (is_nan_forever)
+		return SEXP_KNOWN_FALSE;
+
+	int mission_time = (ins->op_num == OP_HAS_TIME_ELAPSED_MSECS) ? sexp_mission_time_msecs() : sexp_mission_time();
+	if (mission_time >= time)
+		return SEXP_KNOWN_TRUE;
+
+	return SEXP_FALSE;
+}
+
+// eval_when() without the argument handling, which plain whens and every-times don't need.  Only the condition is
+// compiled; the actions run through eval_sexp() as before.
+static int sexp_program_when(const sexp_instruction *ins)
+{
+	auto cond = ins + 1;
+	Assertion(cond->kind == sexp_instruction_kind::LIST, "The condition of a compiled when must be a list!");
+	int val = sexp_program_exec(cond + 1);
+
+	// if value is true, perform the actions in the 'then' part
+	if (val == SEXP_TRUE)
+	{
+		for (int actions = CDR(cond->node); actions != -1; actions = CDR(actions))
+		{
+			int exp = CAR(actions);
+			if (exp != -1)
+				eval_when_do_one_exp(exp);
+		}
+	}
+
+	int short_circuit_node = (cond + 1)->node;
+	if (Sexp_nodes[short_circuit_node].value == SEXP_KNOWN_FALSE || Sexp_nodes[short_circuit_node].value == SEXP_NAN_FOREVER)
+		return SEXP_KNOWN_FALSE;  // no need to waste time on this anymore
+
+	return val;
+}
+
+static int sexp_program_every_time(const sexp_instruction *ins)
+{
+	sexp_program_when(ins);
+	flush_sexp_tree(CDR(ins->node));
+	return SEXP_NAN;
+}
+
+static const SCP_unordered_map<int, sexp_program_operator> &sexp_program_operators()
+{
+	static const SCP_unordered_map<int, sexp_program_operator> operators = {
+		// run from the program
+		{ OP_TRUE, { [](const sexp_instruction *) { return SEXP_KNOWN_TRUE; }, 0 } },
+		{ OP_FALSE, { [](const sexp_instruction *) { return SEXP_KNOWN_FALSE; }, 0 } },
+		{ OP_AND, { sexp_program_and, -1 } },
+		{ OP_OR, { sexp_program_or, -1 } },
+		{ OP_NOT, { sexp_program_not, -1 } },
+		{ OP_EQUALS, { sexp_program_number_compare, -1 } },
+		{ OP_NOT_EQUAL, { sexp_program_number_compare, -1 } },
+		{ OP_GREATER_THAN, { sexp_program_number_compare, -1 } },
+		{ OP_GREATER_OR_EQUAL, { sexp_program_number_compare, -1 } },
+		{ OP_LESS_THAN, { sexp_program_number_compare, -1 } },
+		{ OP_LESS_OR_EQUAL, { sexp_program_number_compare, -1 } },
+		{ OP_HAS_TIME_ELAPSED, { sexp_program_has_time_elapsed, 1 } },
+		{ OP_HAS_TIME_ELAPSED_MSECS, { sexp_program_has_time_elapsed, 1 } },
+		{ OP_WHEN, { sexp_program_when, 1 } },
+		{ OP_EVERY_TIME, { sexp_program_every_time, 1 } },
+
+		// called directly, with their arguments evaluated by the operator as usual
+		{ OP_MISSION_TIME, { [](const sexp_instruction *) { return sexp_mission_time(); }, 0 } },
+		{ OP_MISSION_TIME_MSECS, { [](const sexp_instruction *) { return sexp_mission_time_msecs(); }, 0 } },
+		{ OP_IS_DESTROYED_DELAY, { [](const sexp_instruction *ins) { return sexp_is_destroyed_delay(CDR(ins->node)); }, 0 } },
+		{ OP_IS_SUBSYSTEM_DESTROYED_DELAY, { [](const sexp_instruction *ins) { return sexp_is_subsystem_destroyed_delay(CDR(ins->node)); }, 0 } },
+		{ OP_HAS_DOCKED_DELAY, { [](const sexp_instruction *ins) { return sexp_has_docked_or_undocked(CDR(ins->node), ins->op_num); }, 0 } },
+		{ OP_HAS_UNDOCKED_DELAY, { [](const sexp_instruction *ins) { return sexp_has_docked_or_undocked(CDR(ins->node), ins->op_num); }, 0 } },
+		{ OP_HAS_ARRIVED_DELAY, { [](const sexp_instruction *ins) { return sexp_has_arrived_delay(CDR(ins->node)); }, 0 } },
+		{ OP_HAS_DEPARTED_DELAY, { [](const sexp_instruction *ins) { return sexp_has_departed_delay(CDR(ins->node)); }, 0 } },
+		{ OP_IS_DISABLED_DELAY, { [](const sexp_instruction *ins) { return sexp_is_disabled_xor_disarmed_delay(CDR(ins->node), true); }, 0 } },
+		{ OP_IS_DISARMED_DELAY, { [](const sexp_instruction *ins) { return sexp_is_disabled_xor_disarmed_delay(CDR(ins->node), false); }, 0 } },
+		{ OP_WAYPOINTS_DONE_DELAY, { [](const sexp_instruction *ins) { return sexp_are_waypoints_done_delay(CDR(ins->node)); }, 0 } },
+		{ OP_DESTROYED_DEPARTED_DELAY, { [](const sexp_instruction *ins) { return sexp_destroyed_departed_delay(CDR(ins->node)); }, 0 } },
+		{ OP_SHIP_TYPE_DESTROYED, { [](const sexp_instruction *ins) { return sexp_ship_type_destroyed(CDR(ins->node)); }, 0 } },
+		{ OP_CARGO_KNOWN_DELAY, { [](const sexp_instruction *ins) { return sexp_is_cargo_known(CDR(ins->node), true); }, 0 } },
+		{ OP_HAS_BEEN_TAGGED_DELAY, { [](const sexp_instruction *ins) { return sexp_has_been_tagged_delay(CDR(ins->node)); }, 0 } },
+		{ OP_EVENT_TRUE_DELAY, { [](const sexp_instruction *ins) { return sexp_event_delay_status(CDR(ins->node), 1); }, 0 } },
+		{ OP_EVENT_FALSE_DELAY, { [](const sexp_instruction *ins) { return sexp_event_delay_status(CDR(ins->node), 0); }, 0 } },
+		{ OP_EVENT_TRUE_MSECS_DELAY, { [](const sexp_instruction *ins) { return sexp_event_delay_status(CDR(ins->node), 1, true); }, 0 } },
+		{ OP_EVENT_FALSE_MSECS_DELAY, { [](const sexp_instruction *ins) { return sexp_event_delay_status(CDR(ins->node), 0, true); }, 0 } },
+		{ OP_GOAL_TRUE_DELAY, { [](const sexp_instruction *ins) { return sexp_goal_delay_status(CDR(ins->node), 1); }, 0 } },
+		{ OP_GOAL_FALSE_DELAY, { [](const sexp_instruction *ins) { return sexp_goal_delay_status(CDR(ins->node), 0); }, 0 } },
+		{ OP_EVENT_INCOMPLETE, { [](const sexp_instruction *ins) { return sexp_event_incomplete(CDR(ins->node)); }, 0 } },
+		{ OP_GOAL_INCOMPLETE, { [](const sexp_instruction *ins) { return sexp_goal_incomplete(CDR(ins->node)); }, 0 } },
+		{ OP_PERCENT_SHIPS_DESTROYED, { [](const sexp_instruction *ins) { return sexp_percent_ships_arrive_depart_destroy_disarm_disable_scan(CDR(ins->node), ins->op_num); }, 0 } },
+		{ OP_PERCENT_SHIPS_DEPARTED, { [](const sexp_instruction *ins) { return sexp_percent_ships_arrive_depart_destroy_disarm_disable_scan(CDR(ins->node), ins->op_num); }, 0 } },
+		{ OP_PERCENT_SHIPS_ARRIVED, { [](const sexp_instruction *ins) { return sexp_percent_ships_arrive_depart_destroy_disarm_disable_scan(CDR(ins->node), ins->op_num); }, 0 } },
+		{ OP_SHIELDS_LEFT, { [](const sexp_instruction *ins) { return sexp_shields_left(CDR(ins->node)); }, 0 } },
+		{ OP_HITS_LEFT, { [](const sexp_instruction *ins) { return sexp_hits_left(CDR(ins->node), false); }, 0 } },
+		{ OP_DISTANCE, { [](const sexp_instruction *ins) { return sexp_distance(CDR(ins->node), sexp_retail_distance3); }, 0 } },
+	};
+
+	return operators;
+}
+
+// Whether an argument can be run from the program by one of the operators that compile their arguments
+static bool sexp_program_arg_compilable(int node)
+{
+	if ((Sexp_nodes[node].first != -1) && (Sexp_nodes[node].subtype != SEXP_ATOM_CONTAINER_DATA))
+		return true;
+
+	return (SEXP_NODE_TYPE(node) == SEXP_ATOM) && (Sexp_nodes[node].subtype == SEXP_ATOM_NUMBER);
+}
+
+/**
+ * Appends the instructions for evaluating node the way eval_sexp(node) would.
+ */
+static void sexp_compile_node(SCP_vector<sexp_instruction> &code, int node)
+{
+	size_t index = code.size();
+	code.push_back(sexp_instruction{ sexp_instruction_kind::TREE, node, OP_NOT_AN_OP, 0, 1, nullptr });
+
+	Sexp_nodes[node].flags |= SNF_IN_SEXP_PROGRAM;
+
+	// ignore for container data, because their "first" is a container modifier
+	if ((Sexp_nodes[node].first != -1) && (Sexp_nodes[node].subtype != SEXP_ATOM_CONTAINER_DATA))
+	{
+		code[index].kind = sexp_instruction_kind::LIST;
+		sexp_compile_node(code, CAR(node));
+	}
+	else
+	{
+		int op_num = get_operator_const(node);
+
+		if (op_num == OP_NOT_AN_OP)
+		{
+			code[index].kind = sexp_instruction_kind::ATOM;
 		}
+		else
+		{
+			// none of these operators take arguments, so nothing compiled is ever inside a when-argument tree,
+			// which eval_sexp() would leave out of the short-circuiting
+			auto &operators = sexp_program_operators();
+			auto op = operators.find(op_num);
 
-		if ( Sexp_nodes[cur_node].value == SEXP_NAN ) {	// if we had a nan, but now don't, reset the value
-			Sexp_nodes[cur_node].value = SEXP_UNKNOWN;
+			if (op != operators.end())
+			{
+				int num_args = 0;
+				bool compilable = true;
+
+				for (int arg = CDR(node); arg != -1 && (op->second.num_args < 0 || num_args < op->second.num_args); arg = CDR(arg))
+				{
+					compilable = compilable && sexp_program_arg_compilable(arg);
+					num_args++;
+				}
+
+				// the handlers don't check for missing arguments
+				if (num_args < ((op->second.num_args < 0) ? 1 : op->second.num_args))
+					compilable = false;
+
+				if (op_num == OP_WHEN || op_num == OP_EVERY_TIME)
+				{
+					// the handler runs the operator of the condition, so the condition can't be a plain number
+					if (num_args > 0 && Sexp_nodes[CDR(node)].first == -1)
+						compilable = false;
+
+					// with the setting on, every action gets evaluated once for every argument
+					if (True_loop_argument_sexps && special_argument_appears_in_sexp_tree(CDDR(node)))
+						compilable = false;
+				}
+
+				if (compilable)
+				{
+					code[index].kind = sexp_instruction_kind::OPERATOR;
+					code[index].op_num = op_num;
+					code[index].handler = op->second.handler;
+					code[index].num_args = num_args;
+
+					int arg = CDR(node);
+					for (int i = 0; i < num_args; i++, arg = CDR(arg))
+						sexp_compile_node(code, arg);
+				}
+			}
+		}
+	}
+
+	code[index].size = static_cast<int>(code.size() - index);
+}
+
+/**
+ * Same as eval_sexp(ins->node), for a node without logging and outside of when-argument trees
+ */
+static int sexp_program_exec(const sexp_instruction *ins)
+{
+	int node = ins->node;
+
+	if (ins->kind == sexp_instruction_kind::TREE)
+		return eval_sexp(node);
+
+	// trap known true and known false sexpressions, like eval_sexp() does
+	if (Sexp_nodes[node].value == SEXP_KNOWN_TRUE)
+		return SEXP_TRUE;
+	else if (Sexp_nodes[node].value == SEXP_KNOWN_FALSE || Sexp_nodes[node].value == SEXP_NAN_FOREVER)
+		return SEXP_FALSE;
+
+	switch (ins->kind)
+	{
+		case sexp_instruction_kind::LIST:
+		{
+			int sexp_val = sexp_program_exec(ins + 1);
+			Sexp_nodes[node].value = Sexp_nodes[(ins + 1)->node].value;	// higher level node gets node value
 			return sexp_val;
 		}
 
-		if ( sexp_val ){
-			Sexp_nodes[cur_node].value = SEXP_TRUE;
-		} else {
-			Sexp_nodes[cur_node].value = SEXP_FALSE;
+		case sexp_instruction_kind::ATOM:
+			return sexp_atoi(node);
+
+		case sexp_instruction_kind::OPERATOR:
+		{
+			Current_sexp_operator.push_back(ins->op_num);
+			int sexp_val = ins->handler(ins);
+			Current_sexp_operator.pop_back();
+
+			return eval_sexp_store_result(node, sexp_val);
 		}
 
-		return sexp_val;
+		default:
+			UNREACHABLE("Unhandled SEXP instruction kind %d!", static_cast<int>(ins->kind));
+			return SEXP_FALSE;
+	}
+}
+
+/**
+ * Throws away the instructions of a program, which are compiled again from its formula when it is next run
+ */
+static void sexp_invalidate_program(SCP_vector<sexp_instruction> &code)
+{
+	for (auto &ins : code)
+	{
+		if (Sexp_nodes != nullptr && ins.node < Num_sexp_nodes)
+			Sexp_nodes[ins.node].flags &= ~SNF_IN_SEXP_PROGRAM;
+
+		Sexp_program_formulas.erase(ins.node);
+	}
+
+	code.clear();
+}
+
+static void sexp_compile_program_code(SCP_vector<sexp_instruction> &code, int node)
+{
+	sexp_compile_node(code, node);
+
+	for (auto &ins : code)
+		Sexp_program_formulas[ins.node] = node;
+}
+
+/**
+ * Called by free_sexp() for a node that is part of a program, which then has to be compiled again
+ */
+static void sexp_program_node_freed(int node)
+{
+	// the formula itself is gone, so its program goes with it
+	auto program = Sexp_programs.find(node);
+	if (program != Sexp_programs.end())
+	{
+		sexp_invalidate_program(program->second);
+		Sexp_nodes[node].flags &= ~SNF_IN_SEXP_PROGRAM;
+		Sexp_programs.erase(program);
+		return;
+	}
+
+	auto formula = Sexp_program_formulas.find(node);
+	if (formula == Sexp_program_formulas.end())
+		return;
+
+	int root = formula->second;
+	program = Sexp_programs.find(root);
+	if (program == Sexp_programs.end())
+	{
+		Sexp_program_formulas.erase(formula);
+		return;
 	}
+
+	sexp_invalidate_program(program->second);
+
+	// keep the root flagged, so that freeing the rest of the formula still drops the program
+	Sexp_nodes[root].flags |= SNF_IN_SEXP_PROGRAM;
+}
+
+/**
+ * Compiles the formula at node into a program that eval_sexp_program() then runs in its place.
+ */
+void sexp_compile_program(int node)
+{
+	if (Fred_running || node < 0)
+		return;
+
+	auto &code = Sexp_programs[node];
+	sexp_invalidate_program(code);
+	sexp_compile_program_code(code, node);
+}
+
+/**
+ * Throws away all programs.  Their formulas go back to being evaluated by eval_sexp().
+ */
+void sexp_clear_programs()
+{
+	for (auto &program : Sexp_programs)
+		sexp_invalidate_program(program.second);
+
+	Sexp_programs.clear();
+	Sexp_program_formulas.clear();
+}
+
+/**
+ * Evaluates a formula through its program, if it has one, or eval_sexp() otherwise.  The result is the same either way.
+ */
+int eval_sexp_program(int node)
+{
+	// logging wants to see every operator, which only eval_sexp() knows how to tell it about
+	if (!Sexp_programs_enabled || Log_event || node < 0)
+		return eval_sexp(node);
+
+	auto program = Sexp_programs.find(node);
+	if (program == Sexp_programs.end())
+		return eval_sexp(node);
+
+	// some of the formula was freed since it was compiled, so it may have changed
+	if (program->second.empty())
+		sexp_compile_program_code(program->second, node);
+
+	return sexp_program_exec(program->second.data());
+}
+
+// Most event conditions only look at what has happened in the mission so far, which changes a handful of times per
+// mission rather than every frame.  Each kind of state has a generation counter that is bumped whenever some of that
+// state changes, so a formula that came out false can be skipped for as long as none of the counters for the state it
+// reads have moved.  Only operators known to read nothing else are tracked; any other operator, any delay that isn't
+// a literal zero (which makes the result depend on the mission time) and any container data (whose modifiers can
+// change the container) make a formula depend on anything.
+
+static const int Num_sexp_dependencies = 4;	// SEXP_DEP_* flags
+static uint Sexp_dependency_generations[Num_sexp_dependencies] = { 1, 1, 1, 1 };
+
+static bool sexp_is_zero_delay(int node)
+{
+	return (node >= 0) && (Sexp_nodes[node].subtype == SEXP_ATOM_NUMBER) && !(Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) && (atoi(Sexp_node_data[node].text) == 0);
+}
+
+static int sexp_get_node_dependencies(int node)
+{
+	if (node < 0)
+		return 0;
+
+	if (Sexp_nodes[node].type == SEXP_LIST)
+		return sexp_get_node_dependencies(CAR(node));
+
+	switch (Sexp_nodes[node].subtype)
+	{
+		case SEXP_ATOM_NUMBER:
+		case SEXP_ATOM_STRING:
+			return (Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) ? SEXP_DEP_VARIABLES : 0;
+
+		case SEXP_ATOM_CONTAINER_NAME:
+			return SEXP_DEP_CONTAINERS;
+
+		case SEXP_ATOM_OPERATOR:
+			break;
+
+		default:
+			return SEXP_DEP_ANYTHING;
+	}
+
+	int op_num = get_operator_const(node);
+	int dependencies;
+	int delay_arg = -1;		// the argument holding the delay, if any
+
+	switch (op_num)
+	{
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_AND:
+		case OP_OR:
+		case OP_NOT:
+		case OP_XOR:
+		case OP_EQUALS:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_THAN:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_THAN:
+		case OP_LESS_OR_EQUAL:
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_MOD:
+			dependencies = 0;
+			break;
+
+		// the actions only run once the condition is true, at which point the event is never skipped
+		case OP_WHEN:
+			return sexp_get_node_dependencies(CDR(node));
+
+		case OP_IS_DESTROYED_DELAY:
+		case OP_HAS_ARRIVED_DELAY:
+		case OP_HAS_DEPARTED_DELAY:
+		case OP_IS_DISABLED_DELAY:
+		case OP_IS_DISARMED_DELAY:
+		case OP_DESTROYED_DEPARTED_DELAY:
+			dependencies = SEXP_DEP_MISSION_LOG;
+			delay_arg = 0;
+			break;
+
+		case OP_GOAL_TRUE_DELAY:
+		case OP_GOAL_FALSE_DELAY:
+			dependencies = SEXP_DEP_MISSION_LOG;
+			delay_arg = 1;
+			break;
+
+		case OP_IS_SUBSYSTEM_DESTROYED_DELAY:
+		case OP_WAYPOINTS_DONE_DELAY:
+			dependencies = SEXP_DEP_MISSION_LOG;
+			delay_arg = 2;
+			break;
+
+		case OP_HAS_DOCKED_DELAY:
+		case OP_HAS_UNDOCKED_DELAY:
+			dependencies = SEXP_DEP_MISSION_LOG;
+			delay_arg = 3;
+			break;
+
+		case OP_GOAL_INCOMPLETE:
+		case OP_PERCENT_SHIPS_DESTROYED:
+		case OP_PERCENT_SHIPS_DEPARTED:
+		case OP_PERCENT_SHIPS_ARRIVED:
+		case OP_PERCENT_SHIPS_DISABLED:
+		case OP_PERCENT_SHIPS_DISARMED:
+		case OP_SHIP_TYPE_DESTROYED:
+			dependencies = SEXP_DEP_MISSION_LOG;
+			break;
+
+		// the delayed versions wait on a timestamp even with no delay
+		case OP_EVENT_TRUE:
+		case OP_EVENT_FALSE:
+		case OP_EVENT_INCOMPLETE:
+			dependencies = SEXP_DEP_GOALS_AND_EVENTS;
+			break;
+
+		case OP_IS_CONTAINER_EMPTY:
+		case OP_GET_CONTAINER_SIZE:
+		case OP_LIST_HAS_DATA:
+		case OP_LIST_DATA_INDEX:
+		case OP_MAP_HAS_KEY:
+		case OP_MAP_HAS_DATA_ITEM:
+			dependencies = SEXP_DEP_CONTAINERS;
+			break;
+
+		default:
+			return SEXP_DEP_ANYTHING;
+	}
+
+	int arg_num = 0;
+	for (int arg = CDR(node); arg != -1; arg = CDR(arg), arg_num++)
+	{
+		if (arg_num == delay_arg && !sexp_is_zero_delay(arg))
+			return SEXP_DEP_ANYTHING;
+
+		int arg_dependencies = sexp_get_node_dependencies(arg);
+		if (arg_dependencies == SEXP_DEP_ANYTHING)
+			return SEXP_DEP_ANYTHING;
+
+		dependencies |= arg_dependencies;
+	}
+
+	return dependencies;
+}
+
+/**
+ * Returns the SEXP_DEP_* flags of the state the formula at node reads, or SEXP_DEP_ANYTHING if it can't be told.
+ * As long as none of that state changes, a formula that came out false comes out false again without doing anything.
+ */
+int sexp_get_dependencies(int node)
+{
+	if (node < 0)
+		return SEXP_DEP_ANYTHING;
+
+	return sexp_get_node_dependencies(node);
+}
+
+/**
+ * Called whenever some of the state described by the SEXP_DEP_* flags changes.
+ */
+void sexp_dependencies_changed(int dependencies)
+{
+	for (int i = 0; i < Num_sexp_dependencies; i++)
+	{
+		if (dependencies & (1 << i))
+			Sexp_dependency_generations[i]++;
+	}
+}
+
+/**
+ * Returns a number that changes whenever some of the given state changes, or 0 for SEXP_DEP_ANYTHING.
+ */
+uint sexp_dependency_stamp(int dependencies)
+{
+	if (dependencies == SEXP_DEP_ANYTHING)
+		return 0;
+
+	uint stamp = 1;
+	for (int i = 0; i < Num_sexp_dependencies; i++)
+	{
+		if (dependencies & (1 << i))
+			stamp += Sexp_dependency_generations[i];
+	}
+
+	// 0 is reserved for formulas that can't be skipped
+	return (stamp == 0) ? 1 : stamp;
 }
 
 /**
@@ -35042,7 +35839,7 @@ void update_sexp_references(const char *old_name, const char *new_name)
 	{
 		if ((SEXP_NODE_TYPE(i) == SEXP_ATOM) && (Sexp_nodes[i].subtype == SEXP_ATOM_STRING))
 			if (!stricmp(CTEXT(i), old_name))
-				strcpy(Sexp_nodes[i].text, new_name);
+				strcpy(Sexp_node_data[i].text, new_name);
 	}
 }
 
@@ -35109,7 +35906,7 @@ void update_sexp_references(const char *old_name, const char *new_name, int form
 			if (query_operator_argument_type(op, i) == format)
 			{
 				if (!stricmp(CTEXT(n), old_name))
-					strcpy(Sexp_nodes[n].text, new_name);
+					strcpy(Sexp_node_data[n].text, new_name);
 			}
 		}
 
@@ -35751,13 +36548,13 @@ const char *CTEXT(int n)
 		if (Fred_running)
 		{
 			// CTEXT is used when writing sexps to savefiles, so don't translate the argument
-			return Sexp_nodes[n].text;
+			return Sexp_node_data[n].text;
 		}
 		else
 		{
 			// make sure we have an argument to replace it with
 			if (Sexp_replacement_arguments.empty())
-				return Sexp_nodes[n].text;
+				return Sexp_node_data[n].text;
 		}
 
 		auto current_argument = Sexp_replacement_arguments.back();
@@ -35772,14 +36569,14 @@ const char *CTEXT(int n)
 			{
 				// nodes that have an officially formatted variable will store the variable index in the token
 				if (Sexp_nodes[arg_n].type & SEXP_FLAG_VARIABLE)
-					Sexp_nodes[arg_n].cached_variable_index = atoi(text);
+					Sexp_node_data[arg_n].cached_variable_index = atoi(text);
 				else
-					Sexp_nodes[arg_n].cached_variable_index = check_sexp_node_text_for_sexp_variable(text);
+					Sexp_node_data[arg_n].cached_variable_index = check_sexp_node_text_for_sexp_variable(text);
 
 				Sexp_nodes[arg_n].flags |= SNF_CHECKED_ARG_FOR_VAR;
 			}
 
-			sexp_variable_index = Sexp_nodes[arg_n].cached_variable_index;
+			sexp_variable_index = Sexp_node_data[arg_n].cached_variable_index;
 		}
 
 		// if we have a variable, return the variable value, else return the regular argument
@@ -35794,7 +36591,7 @@ const char *CTEXT(int n)
 	{
 		if (Fred_running)
 		{
-			sexp_variable_index = get_index_sexp_variable_name(Sexp_nodes[n].text);
+			sexp_variable_index = get_index_sexp_variable_name(Sexp_node_data[n].text);
 		}
 		else
 		{
@@ -35805,7 +36602,7 @@ const char *CTEXT(int n)
 
 		// if variable not found, just return the node text
 		if (sexp_variable_index < 0)
-			return Sexp_nodes[n].text;
+			return Sexp_node_data[n].text;
 
 		Assert( !(Sexp_variables[sexp_variable_index].type & SEXP_VARIABLE_NOT_USED) );
 		Assert(Sexp_variables[sexp_variable_index].type & SEXP_VARIABLE_SET);
@@ -35823,7 +36620,7 @@ const char *CTEXT(int n)
 	}
 	else
 	{
-		return Sexp_nodes[n].text;
+		return Sexp_node_data[n].text;
 	}
 }
 
@@ -35933,6 +36730,7 @@ void sexp_modify_variable(const char *text, int index, bool sexp_callback)
 		Sexp_variables[index].text[maxCopyLen] = 0;
 	}
 	Sexp_variables[index].type |= SEXP_VARIABLE_MODIFIED;
+	sexp_dependencies_changed(SEXP_DEP_VARIABLES);
 
 	// do multi_callback_here
 	// if we're called from the sexp code send a SEXP packet (more efficient) 
@@ -35978,7 +36776,7 @@ int copy_node_to_replacement_args(int node, int container_value_index)
 	int num_args = 0;
 
 	if (Sexp_nodes[node].subtype == SEXP_ATOM_CONTAINER_NAME) {
-		const char *container_name = Sexp_nodes[node].text;
+		const char *container_name = Sexp_node_data[node].text;
 		const auto *p_container = get_sexp_container(container_name);
 
 		Assertion(p_container, "Special argument SEXP given nonexistent container %s. Please report!", container_name);
@@ -36013,7 +36811,7 @@ int copy_node_to_replacement_args(int node, int container_value_index)
 		Assertion(container_value_index == -1,
 			"Attempt to copy replacement argument string with unexpected index %d. Please report!",
 			container_value_index);
-		Sexp_replacement_arguments.emplace_back(Sexp_nodes[node].text, node);
+		Sexp_replacement_arguments.emplace_back(Sexp_node_data[node].text, node);
 		num_args = 1;
 	}
 
@@ -36047,14 +36845,14 @@ int check_dynamic_value_node_type(int node, bool is_string, bool is_number)
 			return SEXP_CHECK_INVALID_SPECIAL_ARG_TYPE;
 		}
 	} else if (Sexp_nodes[node].subtype == SEXP_ATOM_CONTAINER_DATA) {
-		const auto *p_container = get_sexp_container(Sexp_nodes[node].text);
+		const auto *p_container = get_sexp_container(Sexp_node_data[node].text);
 		if (!p_container)
 			return SEXP_CHECK_INVALID_CONTAINER;
 		if (!check_container_data_sexp_arg_type(p_container->type, is_string, is_number)) {
 			return SEXP_CHECK_WRONG_CONTAINER_DATA_TYPE;
 		}
 	} else {
-		Assertion(false, "Unhandled dynamic value node %s. Please report!", Sexp_nodes[node].text);
+		Assertion(false, "Unhandled dynamic value node %s. Please report!", Sexp_node_data[node].text);
 	}
 
 	return 0;
@@ -36077,7 +36875,7 @@ void sexp_modify_variable(int n)
 
 	if (sexp_variable_index < 0)
 	{
-		Warning(LOCATION, "modify-variable: Variable %s does not exist!", Sexp_nodes[n].text);
+		Warning(LOCATION, "modify-variable: Variable %s does not exist!", Sexp_node_data[n].text);
 	}
 	else if (Sexp_variables[sexp_variable_index].type & SEXP_VARIABLE_NUMBER)
 	{
@@ -36112,7 +36910,7 @@ bool is_sexp_node_numeric(int node)
 		return true;
 	
 	// if the node text is numeric, the node is too
-	if (can_construe_as_integer(Sexp_nodes[node].text))
+	if (can_construe_as_integer(Sexp_node_data[node].text))
 		return true;
 
 	// otherwise it's gotta be text
@@ -36256,7 +37054,7 @@ void sexp_copy_variable_from_index(int node)
 
 	if (to_index < 0)
 	{
-		Warning(LOCATION, "copy-variable-from-index: Variable %s does not exist!", Sexp_nodes[CDR(node)].text);
+		Warning(LOCATION, "copy-variable-from-index: Variable %s does not exist!", Sexp_node_data[CDR(node)].text);
 		return;
 	}
 
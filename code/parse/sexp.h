@@ -1387,8 +1387,10 @@ struct sexp_cached_data
 	}
 };
 
+// A node is split in two.  Sexp_nodes holds what every walk over a tree looks at, packed so that a cache line holds
+// two nodes; Sexp_node_data holds the token text and the caches, which are only read once a node has been reached.
+// Both arrays have Num_sexp_nodes entries and share their indexes.
 typedef struct sexp_node {
-	char	text[TOKEN_LENGTH];
 	int op_index;				// the index in the Operators array for the operator at this node (or -1 if not an operator)
 	int	type;						// atom, list, or not used
 	int	subtype;					// type of atom or list?
@@ -1396,12 +1398,16 @@ typedef struct sexp_node {
 	int	rest;						// index into Sexp_nodes of rest of parameters
 	int	value;					// known to be true, known to be false, or not known
 	int flags;					// Goober5000
+} sexp_node;
+
+typedef struct sexp_node_data {
+	char	text[TOKEN_LENGTH];
 
 	sexp_cached_data *cache;	// Goober5000
 	int cached_variable_index;	// Goober5000 - note, this can be used for special-arg nodes, not just variable nodes
 
 	int duration_index;			// Goober5000 - only used if node is the is-true-for-duration operator
-} sexp_node;
+} sexp_node_data;
 
 // Goober5000
 #define SNF_ARGUMENT_VALID			(1<<0)
@@ -1414,8 +1420,16 @@ typedef struct sexp_node {
 #define SNF_NODE_IS_OPF_POSITIVE	(1<<7)
 #define SNF_DESCENDANT_OF_WHEN_ARG_OP		(1<<8)
 #define SNF_NOT_DESCENDANT_OF_WHEN_ARG_OP	(1<<9)
+#define SNF_IN_SEXP_PROGRAM			(1<<10)
 #define SNF_DEFAULT_VALUE			SNF_ARGUMENT_VALID
 
+// the kinds of mission state a formula can depend on, see sexp_get_dependencies()
+#define SEXP_DEP_MISSION_LOG		(1<<0)		// the mission log, and the status of ships and wings
+#define SEXP_DEP_VARIABLES			(1<<1)
+#define SEXP_DEP_CONTAINERS			(1<<2)
+#define SEXP_DEP_GOALS_AND_EVENTS	(1<<3)		// the results of other events
+#define SEXP_DEP_ANYTHING			(-1)		// the mission time, object positions, or anything else that changes on its own
+
 typedef struct sexp_variable {
 	int		type;
 	char	text[TOKEN_LENGTH];
@@ -1431,6 +1445,7 @@ typedef struct sexp_variable {
 
 extern int Num_sexp_nodes;
 extern sexp_node *Sexp_nodes;
+extern sexp_node_data *Sexp_node_data;
 
 extern sexp_variable Sexp_variables[MAX_SEXP_VARIABLES];
 extern sexp_variable Block_variables[MAX_SEXP_VARIABLES];
@@ -1484,6 +1499,17 @@ extern int eval_sexp(int cur_node, int referenced_node = -1);
 extern int eval_num(int n, bool &is_nan, bool &is_nan_forever);
 extern gamesnd_id sexp_get_sound_index(int node);
 extern bool is_sexp_true(int cur_node, int referenced_node = -1);
+
+// formulas compiled into flat programs, see sexp_compile_program()
+extern bool Sexp_programs_enabled;
+extern void sexp_compile_program(int node);
+extern void sexp_clear_programs();
+extern int eval_sexp_program(int node);
+
+// dependency tracking, for skipping formulas whose inputs haven't changed
+extern int sexp_get_dependencies(int node);
+extern void sexp_dependencies_changed(int dependencies);
+extern uint sexp_dependency_stamp(int dependencies);
 extern bool map_opf_to_opr(sexp_opf_t opf_type, sexp_opr_t &opr_type);
 const char *opr_type_name(sexp_opr_t opr_type);
 extern int query_operator_return_type(int op);
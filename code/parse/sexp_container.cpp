@@ -286,6 +286,7 @@ SCP_string sexp_container::list_apply_iterator(SCP_list<SCP_string>::iterator li
 			report_container_used_in_special_arg(Remove_op_prefix + location, container_name.c_str());
 		} else {
 			list_data.erase(list_it);
+			sexp_dependencies_changed(SEXP_DEP_CONTAINERS);
 		}
 	}
 
@@ -345,9 +346,10 @@ void update_sexp_containers(SCP_vector<sexp_container> &containers,
 			auto &node = Sexp_nodes[i];
 			if (node.type == SEXP_ATOM &&
 				(node.subtype == SEXP_ATOM_CONTAINER_NAME || node.subtype == SEXP_ATOM_CONTAINER_DATA)) {
-				const auto new_name_it = renamed_containers.find(node.text);
+				auto &node_text = Sexp_node_data[i].text;
+				const auto new_name_it = renamed_containers.find(node_text);
 				if (new_name_it != renamed_containers.cend()) {
-					strcpy_s(node.text, new_name_it->second.c_str());
+					strcpy_s(node_text, new_name_it->second.c_str());
 				}
 			}
 		}
@@ -814,11 +816,11 @@ bool sexp_container_CTEXT_helper(int &node, sexp_container &container, SCP_strin
 
 const char *sexp_container_CTEXT(int node)
 {
-	auto *p_container = get_sexp_container(Sexp_nodes[node].text);
+	auto *p_container = get_sexp_container(Sexp_node_data[node].text);
 
 	if (!p_container) {
-		Warning(LOCATION, "sexp_container_CTEXT() called for %s, a container which does not exist!", Sexp_nodes[node].text);
-		log_printf(LOGFILE_EVENT_LOG, "sexp_container_CTEXT() called for %s, a container which does not exist!", Sexp_nodes[node].text);
+		Warning(LOCATION, "sexp_container_CTEXT() called for %s, a container which does not exist!", Sexp_node_data[node].text);
+		log_printf(LOGFILE_EVENT_LOG, "sexp_container_CTEXT() called for %s, a container which does not exist!", Sexp_node_data[node].text);
 		return Empty_str;
 	}
 
@@ -847,12 +849,12 @@ const char *sexp_container_CTEXT(int node)
 		}
 
 		if (result.front() != sexp_container::DELIM) {
-			if (!Sexp_nodes[node].cache) {
-				Sexp_nodes[node].cache = new sexp_cached_data(OPF_CONTAINER_NAME, result);
+			if (!Sexp_node_data[node].cache) {
+				Sexp_node_data[node].cache = new sexp_cached_data(OPF_CONTAINER_NAME, result);
 			} else {
-				Sexp_nodes[node].cache->update_container_CTEXT_result(result);
+				Sexp_node_data[node].cache->update_container_CTEXT_result(result);
 			}
-			return Sexp_nodes[node].cache->container_CTEXT_result;
+			return Sexp_node_data[node].cache->container_CTEXT_result;
 		} else {
 			// we're dealing with a multidimentional container
 			node = CDR(node);
@@ -1078,7 +1080,7 @@ int sexp_map_has_data_item(int node)
 					var_index = sexp_get_variable_index(node);
 				} else {
 					// perhaps the node text is the variable name as data
-					var_index = get_index_sexp_variable_name(Sexp_nodes[node].text);
+					var_index = get_index_sexp_variable_name(Sexp_node_data[node].text);
 				}
 
 				if (var_index >= 0) {
@@ -1096,7 +1098,7 @@ int sexp_map_has_data_item(int node)
 					}
 				} else {
 					const SCP_string msg =
-						SCP_string("Map-has-data-item given invalid optional variable ") + Sexp_nodes[node].text;
+						SCP_string("Map-has-data-item given invalid optional variable ") + Sexp_node_data[node].text;
 					Warning(LOCATION, "%s", msg.c_str());
 					log_printf(LOGFILE_EVENT_LOG, "%s", msg.c_str());
 				}
@@ -1581,6 +1583,8 @@ void sexp_apply_container_filter(int node)
 
 int sexp_container_eval_change_sexp(int op_num, int node)
 {
+	sexp_dependencies_changed(SEXP_DEP_CONTAINERS);
+
 	switch (op_num) {
 	case OP_CONTAINER_ADD_TO_LIST:
 		sexp_add_to_list(node);
@@ -1731,7 +1735,7 @@ int sexp_container_query_sexp_args_count(const int node, SCP_vector<int> &cumula
 		const int prev_index = cumulative_arg_countss.back();
 
 		if (Sexp_nodes[n].subtype == SEXP_ATOM_CONTAINER_NAME) {
-			const char *container_name = Sexp_nodes[n].text;
+			const char *container_name = Sexp_node_data[n].text;
 			const auto *p_container = get_sexp_container(container_name);
 
 			// should have been checked in get_sexp()
@@ -1763,7 +1767,7 @@ void sexp_container_set_special_arg_status(int arg_handler_node, bool status)
 			"Attempt to use Replace Container Data as special argument option, which isn't supported. Please report!");
 
 		if (Sexp_nodes[arg_node].subtype == SEXP_ATOM_CONTAINER_NAME) {
-			const char *container_name = Sexp_nodes[arg_node].text;
+			const char *container_name = Sexp_node_data[arg_node].text;
 			auto *p_container = get_sexp_container(container_name);
 
 			// should have been checked in get_sexp()
@@ -10,7 +10,28 @@
 
 namespace particle {
 	struct particle;
-	typedef std::weak_ptr<particle> WeakParticlePtr;
+
+	/**
+	 * @brief A reference to a persistent particle that knows when the particle is gone
+	 *
+	 * Persistent particles live in slots that are reused once the particle expires, so a reference remembers the
+	 * generation of the slot it was handed out for. The pointer lock() returns stays valid until the particle expires.
+	 */
+	class WeakParticlePtr {
+		uint32_t m_slot = UINT32_MAX;
+		uint32_t m_generation = 0;
+
+	public:
+		WeakParticlePtr() = default;
+		WeakParticlePtr(uint32_t slot, uint32_t generation) : m_slot(slot), m_generation(generation) {}
+
+		// The particle, or nullptr if it expired
+		particle* lock() const;
+
+		bool expired() const {
+			return lock() == nullptr;
+		}
+	};
 }
 
 namespace effects {
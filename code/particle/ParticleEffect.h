@@ -33,6 +33,10 @@ namespace anl {
 
 namespace particle {
 
+// defined in particle.cpp
+enum class particle_move_state : uint8_t;
+struct particle_render_prep;
+
 /**
  * @brief Defines a particle effect
  *
@@ -134,8 +138,12 @@ public:
 	friend class ParticleManager;
 	friend int ::parse_weapon(int, bool, const char*);
 	friend ParticleEffectHandle scripting::api::getLegacyScriptingParticleEffect(int bitmap, bool reversed);
-	friend bool move_particle(float frametime, particle* part);
-	friend bool render_particle(particle* part);
+	friend particle_move_state step_particle(float frametime, particle* part);
+	friend void finish_particle_move(float frametime, particle* part, particle_move_state state);
+	friend void prepare_particle_render(const particle* part, particle_render_prep* prep, bool on_main_thread);
+	friend bool render_particle(particle* part, particle_render_prep* prep);
+	friend bool is_simple_particle(const particle& new_particle);
+	friend void move_simple_particles(float frametime);
 
 	SCP_string m_name; //!< The name of this effect
 
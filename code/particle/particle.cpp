@@ -27,19 +27,110 @@
 #include "tracing/tracing.h"
 #include "tracing/Monitor.h"
 #include "utils/Random.h"
+#include "utils/threading.h"
 #include "nebula/neb.h"
 #include "mission/missionparse.h"
 #include "mod_table/mod_table.h"
 
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_MOTION_SSE
+#include <emmintrin.h>
+#endif
+
 using namespace particle;
 
 namespace
 {
 	SCP_vector<::particle::particle> Particles;
-	SCP_vector<ParticlePtr> Persistent_particles;
+
+	// Persistent particles stay in their slot for as long as they live, and a deque never moves its elements, so
+	// references can point right at them. The generation of a slot is odd while it holds a live particle.
+	SCP_deque<::particle::particle> Persistent_particles;
+	SCP_vector<uint32_t> Persistent_generations;
+	SCP_vector<uint32_t> Persistent_live_slots;
+	SCP_vector<uint32_t> Persistent_free_slots;
+
+	void free_persistent_slot(uint32_t slot)
+	{
+		++Persistent_generations[slot];
+		Persistent_free_slots.push_back(slot);
+	}
+
+	// Non-persistent particles that aren't attached to anything and whose effect has neither a velocity curve nor a
+	// light only ever fly on in a straight line. Their motion is kept one array per component, where it is stepped
+	// without looking at the particle or its effect at all. The rest of them stays in Simple_particles, whose pos and
+	// age are only brought up to date when they are needed, for rendering and for death effects.
+	struct particle_motion_store {
+		SCP_vector<float> pos_x, pos_y, pos_z;
+		SCP_vector<float> vel_x, vel_y, vel_z;
+		SCP_vector<float> age;
+		SCP_vector<float> max_life;
+		SCP_vector<float> expire_age;	// max_life, or infinity for a looping particle
+		SCP_vector<uint8_t> expired;	// set by the last step
+
+		size_t size() const { return age.size(); }
+
+		void push_back(const particle::particle& part)
+		{
+			pos_x.push_back(part.pos.xyz.x);
+			pos_y.push_back(part.pos.xyz.y);
+			pos_z.push_back(part.pos.xyz.z);
+			vel_x.push_back(part.velocity.xyz.x);
+			vel_y.push_back(part.velocity.xyz.y);
+			vel_z.push_back(part.velocity.xyz.z);
+			age.push_back(part.age);
+			max_life.push_back(part.max_life);
+			expire_age.push_back(part.looping ? std::numeric_limits<float>::infinity() : part.max_life);
+			expired.push_back(0);
+		}
+
+		void move(size_t to, size_t from)
+		{
+			pos_x[to] = pos_x[from];
+			pos_y[to] = pos_y[from];
+			pos_z[to] = pos_z[from];
+			vel_x[to] = vel_x[from];
+			vel_y[to] = vel_y[from];
+			vel_z[to] = vel_z[from];
+			age[to] = age[from];
+			max_life[to] = max_life[from];
+			expire_age[to] = expire_age[from];
+		}
+
+		void resize(size_t count)
+		{
+			for (auto array : { &pos_x, &pos_y, &pos_z, &vel_x, &vel_y, &vel_z, &age, &max_life, &expire_age }) {
+				array->resize(count);
+			}
+			expired.resize(count);
+		}
+
+		// brings the particle the motion at index i belongs to up to date
+		void sync(size_t i, particle::particle* part) const
+		{
+			part->pos.xyz.x = pos_x[i];
+			part->pos.xyz.y = pos_y[i];
+			part->pos.xyz.z = pos_z[i];
+			part->age = age[i];
+		}
+	};
+
+	SCP_vector<::particle::particle> Simple_particles;
+	particle_motion_store Simple_motion;
 
 	static int Particles_enabled = 1;
 
+	// If cleared, particles are moved and prepared for rendering on the main thread only
+	bool Particles_threaded = true;
+
+	// How many particles a worker steps or prepares for rendering before it looks for more work
+	const size_t PARTICLE_CHUNK_SIZE = 256;
+
+	// Stepping the motion of a simple particle is only a few instructions, so the workers get more of them at once
+	const size_t SIMPLE_PARTICLE_CHUNK_SIZE = 4096;
+
 	float get_current_alpha(vec3d* pos, float rad)
 	{
 		float dist;
@@ -75,6 +166,32 @@ namespace
 
 namespace particle
 {
+	enum class particle_move_state : uint8_t {
+		MOVED,			// all done
+		EXPIRED,		// to be removed, after spawning its death effect
+		NEEDS_CURVES	// still has to move, since its speed or its light depend on curves
+	};
+
+	struct particle_render_prep {
+		bool prepared;
+		bool back_facing;
+		bool alpha_pending;	// alpha is only worked out once the particle is known to be in view
+		ubyte codes;		// of world_pos
+		vec3d world_pos;
+		float alpha;
+
+		// what render_particle() leaves for the vertices to be written
+		batch_slice slice;
+		bool has_length;
+		vec3d end_pos;
+		float radius;
+		float angle;
+	};
+
+	// Kept between frames so they keep their storage
+	static SCP_vector<particle_move_state> Particle_move_states;
+	static SCP_vector<particle_render_prep> Particle_render_preps;
+
 	int Anim_bitmap_id_fire = -1;
 	int Anim_num_frames_fire = -1;
 
@@ -123,15 +240,27 @@ namespace particle
 		return ParticleManager::get()->getEffect(handle)[subeffect];
 	}
 
+	particle* WeakParticlePtr::lock() const {
+		if (m_slot >= Persistent_generations.size() || Persistent_generations[m_slot] != m_generation)
+			return nullptr;
+
+		return &Persistent_particles[m_slot];
+	}
+
 	// only call from game_shutdown()!!!
 	void close()
 	{
 		Persistent_particles.clear();
+		Persistent_generations.clear();
+		Persistent_live_slots.clear();
+		Persistent_free_slots.clear();
 		Particles.clear();
+		Simple_particles.clear();
+		Simple_motion.resize(0);
 	}
 
 	size_t get_particle_count() {
-		return Particles.size() + Persistent_particles.size();
+		return Particles.size() + Simple_particles.size() + Persistent_live_slots.size();
 	}
 
 	void page_in()
@@ -151,6 +280,8 @@ namespace particle
 	DCF_BOOL2(particles, Particles_enabled, "Turns particles on/off",
 			  "Usage: particles [bool]\nTurns particle system on/off.  If nothing passed, then toggles it.\n");
 
+	DCF_BOOL(particles_threaded, Particles_threaded)
+
 
 	static bool maybe_cull_particle(const particle& new_particle) {
 		if (!Particles_enabled)
@@ -176,11 +307,26 @@ namespace particle
 		return false;
 	}
 
+	// Whether a new particle can go with the simple particles, see Simple_motion
+	bool is_simple_particle(const particle& new_particle) {
+		if (!new_particle.attachment.is_not_attached())
+			return false;
+
+		const auto& source_effect = new_particle.parent_effect.getParticleEffect();
+
+		return !source_effect.m_light_source && !source_effect.m_lifetime_curves.has_curve(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT);
+	}
+
 	void create(particle&& new_particle) {
 		if (maybe_cull_particle(new_particle))
 			return;
 
-		Particles.push_back(new_particle);
+		if (is_simple_particle(new_particle)) {
+			Simple_motion.push_back(new_particle);
+			Simple_particles.push_back(std::move(new_particle));
+		} else {
+			Particles.push_back(new_particle);
+		}
 	}
 
 	// Creates a single particle. See the PARTICLE_?? defines for types.
@@ -189,11 +335,22 @@ namespace particle
 		if (maybe_cull_particle(new_particle))
 			return {};
 
-		ParticlePtr new_particle_ptr = std::make_shared<particle>(new_particle);
+		uint32_t slot;
 
-		Persistent_particles.push_back(new_particle_ptr);
+		if (Persistent_free_slots.empty()) {
+			slot = static_cast<uint32_t>(Persistent_particles.size());
+			Persistent_particles.push_back(std::move(new_particle));
+			Persistent_generations.push_back(0);
+		} else {
+			slot = Persistent_free_slots.back();
+			Persistent_free_slots.pop_back();
+			Persistent_particles[slot] = std::move(new_particle);
+		}
 
-		return {new_particle_ptr};
+		auto generation = ++Persistent_generations[slot];
+		Persistent_live_slots.push_back(slot);
+
+		return {slot, generation};
 	}
 
 	float getPixelSize(const particle& subject_particle) {
@@ -209,12 +366,16 @@ namespace particle
 	}
 
 	/**
-	 * @brief Moves a single particle
+	 * @brief Ages a particle and moves it if that doesn't need any curves
+	 *
+	 * Only touches the particle itself and reads nothing that changes while particles move, so any number of particles
+	 * can be stepped at once on the worker threads. Whatever is left is done by finish_particle_move().
+	 *
 	 * @param frametime The length of the current frame
 	 * @param part The particle to process for movement
-	 * @return @c true if the particle has expired and should be removed, @c false otherwise
+	 * @return What is left to do for the particle
 	 */
-	bool move_particle(float frametime, particle* part) {
+	particle_move_state step_particle(float frametime, particle* part) {
 		if (part->age == 0.0f)
 		{
 			part->age = 0.00001f;
@@ -242,9 +403,34 @@ namespace particle
 			remove_particle = true;
 		}
 
+		if (remove_particle)
+			return particle_move_state::EXPIRED;
+
 		const auto& source_effect = part->parent_effect.getParticleEffect();
 
-		if (remove_particle)
+		// without a velocity curve or a light the particle just flies on, which needs neither its speed nor any curve
+		if (!(Detail.lighting > 3 && source_effect.m_light_source) && !source_effect.m_lifetime_curves.has_curve(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT)) {
+			part->pos += part->velocity * frametime;
+			return particle_move_state::MOVED;
+		}
+
+		return particle_move_state::NEEDS_CURVES;
+	}
+
+	/**
+	 * @brief Does the part of moving a particle that has to happen on the main thread
+	 *
+	 * Curves may draw random numbers and lights and death effects go into lists of their own, so this runs for one
+	 * particle after the other, in the same order no matter how many threads stepped them.
+	 *
+	 * @param frametime The length of the current frame
+	 * @param part The particle to process for movement
+	 * @param state What step_particle() left to do
+	 */
+	void finish_particle_move(float frametime, particle* part, particle_move_state state) {
+		const auto& source_effect = part->parent_effect.getParticleEffect();
+
+		if (state == particle_move_state::EXPIRED)
 		{
 			if (source_effect.m_deathEffect.isValid()) {
 				vec3d world_pos = part->attachment.local_pos_to_global(part->pos);
@@ -260,7 +446,7 @@ namespace particle
 				deathSource->finishCreation();
 			}
 
-			return true;
+			return;
 		}
 
 		float part_velocity =  vm_vec_mag_quick(&part->velocity);
@@ -286,7 +472,7 @@ namespace particle
 
 			// after this point it is only lighting code, so we can early return
 			if (light_radius <= 0.0f || intensity <= 0.0f) {
-				return false;
+				return;
 			}
 
 			switch (light_source.light_source_mode) {
@@ -321,8 +507,127 @@ namespace particle
 			break;
 			}
 		}
+	}
 
-		return false;
+	/**
+	 * @brief Moves count particles, which particle_at() hands out by index
+	 * @return What was left to do for each of them, which tells the expired ones
+	 */
+	template <typename ParticleAt>
+	const SCP_vector<particle_move_state>& move_particles(float frametime, size_t count, ParticleAt&& particle_at)
+	{
+		Particle_move_states.resize(count);
+
+		auto step_chunk = [frametime, &particle_at](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				Particle_move_states[i] = step_particle(frametime, particle_at(i));
+			}
+		};
+
+		if (Particles_threaded) {
+			threading::parallel_for(count, PARTICLE_CHUNK_SIZE, step_chunk, &tracing::ParticlesMoveJob);
+		} else {
+			step_chunk(0, count);
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			if (Particle_move_states[i] != particle_move_state::MOVED) {
+				finish_particle_move(frametime, particle_at(i), Particle_move_states[i]);
+			}
+		}
+
+		return Particle_move_states;
+	}
+
+	/**
+	 * @brief What step_particle() does for the simple particles from begin to end, see Simple_motion
+	 *
+	 * Four particles at a time where SSE2 is around. Expired particles aren't moved, so that their death effect starts
+	 * where they were last seen, just like for any other particle.
+	 */
+	void step_simple_particles(float frametime, size_t begin, size_t end)
+	{
+		auto& motion = Simple_motion;
+		size_t i = begin;
+
+#ifdef PARTICLE_MOTION_SSE
+		const __m128 ft = _mm_set1_ps(frametime);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 first_age = _mm_set1_ps(0.00001f);
+
+		for (; i + 4 <= end; i += 4) {
+			__m128 age = _mm_loadu_ps(&motion.age[i]);
+			__m128 is_new = _mm_cmpeq_ps(age, zero);
+			age = _mm_or_ps(_mm_and_ps(is_new, first_age), _mm_andnot_ps(is_new, _mm_add_ps(age, ft)));
+			_mm_storeu_ps(&motion.age[i], age);
+
+			// the special case of step_particle(), a particle without a lifetime is rendered at least once
+			__m128 expired = _mm_and_ps(_mm_cmpgt_ps(age, _mm_loadu_ps(&motion.expire_age[i])),
+				_mm_or_ps(_mm_cmpgt_ps(age, ft), _mm_cmpgt_ps(_mm_loadu_ps(&motion.max_life[i]), zero)));
+
+			int mask = _mm_movemask_ps(expired);
+			motion.expired[i] = static_cast<uint8_t>(mask & 1);
+			motion.expired[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+			motion.expired[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+			motion.expired[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+
+			__m128 step = _mm_andnot_ps(expired, ft);
+			_mm_storeu_ps(&motion.pos_x[i], _mm_add_ps(_mm_loadu_ps(&motion.pos_x[i]), _mm_mul_ps(_mm_loadu_ps(&motion.vel_x[i]), step)));
+			_mm_storeu_ps(&motion.pos_y[i], _mm_add_ps(_mm_loadu_ps(&motion.pos_y[i]), _mm_mul_ps(_mm_loadu_ps(&motion.vel_y[i]), step)));
+			_mm_storeu_ps(&motion.pos_z[i], _mm_add_ps(_mm_loadu_ps(&motion.pos_z[i]), _mm_mul_ps(_mm_loadu_ps(&motion.vel_z[i]), step)));
+		}
+#endif
+
+		for (; i < end; ++i) {
+			float age = (motion.age[i] == 0.0f) ? 0.00001f : motion.age[i] + frametime;
+			motion.age[i] = age;
+
+			bool expired = age > motion.expire_age[i] && (age > frametime || motion.max_life[i] > 0.0f);
+			motion.expired[i] = expired ? 1 : 0;
+
+			if (!expired) {
+				motion.pos_x[i] += motion.vel_x[i] * frametime;
+				motion.pos_y[i] += motion.vel_y[i] * frametime;
+				motion.pos_z[i] += motion.vel_z[i] * frametime;
+			}
+		}
+	}
+
+	void move_simple_particles(float frametime)
+	{
+		const size_t count = Simple_particles.size();
+
+		if (Particles_threaded) {
+			threading::parallel_for(count, SIMPLE_PARTICLE_CHUNK_SIZE, [frametime](size_t begin, size_t end) {
+				step_simple_particles(frametime, begin, end);
+			}, &tracing::ParticlesMoveJob);
+		} else {
+			step_simple_particles(frametime, 0, count);
+		}
+
+		// expired particles are squeezed out, so the rest keep their order
+		size_t num_alive = 0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (Simple_motion.expired[i]) {
+				if (Simple_particles[i].parent_effect.getParticleEffect().m_deathEffect.isValid()) {
+					Simple_motion.sync(i, &Simple_particles[i]);
+					finish_particle_move(frametime, &Simple_particles[i], particle_move_state::EXPIRED);
+				}
+				continue;
+			}
+
+			if (num_alive != i) {
+				Simple_particles[num_alive] = std::move(Simple_particles[i]);
+				Simple_motion.move(num_alive, i);
+			}
+
+			++num_alive;
+		}
+
+		Simple_particles.erase(Simple_particles.begin() + num_alive, Simple_particles.end());
+		Simple_motion.resize(num_alive);
 	}
 
 	void move_all(float frametime)
@@ -332,49 +637,50 @@ namespace particle
 		if (!Particles_enabled)
 			return;
 
-		if (Persistent_particles.empty() && Particles.empty())
+		if (Persistent_live_slots.empty() && Particles.empty() && Simple_particles.empty())
 			return;
 
-		for (auto p = Persistent_particles.begin(); p != Persistent_particles.end();)
+		// persistent particles go first, so that particles attached to one that expires see it gone this same frame
+		const auto& persistent_states = move_particles(frametime, Persistent_live_slots.size(), [](size_t i) {
+			return &Persistent_particles[Persistent_live_slots[i]];
+		});
+
+		size_t num_alive = 0;
+
+		for (size_t i = 0; i < Persistent_live_slots.size(); ++i)
 		{
-			ParticlePtr part = *p;
-			if (move_particle(frametime, part.get()))
+			if (persistent_states[i] == particle_move_state::EXPIRED)
 			{
-				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
-				if (p + 1 == Persistent_particles.end())
-				{
-					Persistent_particles.pop_back();
-					break;
-				}
-
-				*p = Persistent_particles.back();
-				Persistent_particles.pop_back();
+				free_persistent_slot(Persistent_live_slots[i]);
 				continue;
 			}
 
-			// next particle
-			++p;
+			Persistent_live_slots[num_alive++] = Persistent_live_slots[i];
 		}
 
-		for (auto p = Particles.begin(); p != Particles.end();)
-		{
-			if (move_particle(frametime, &(*p)))
-			{
-				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
-				if (p + 1 == Particles.end())
-				{
-					Particles.pop_back();
-					break;
-				}
+		Persistent_live_slots.resize(num_alive);
 
-				*p = Particles.back();
-				Particles.pop_back();
+		const auto& states = move_particles(frametime, Particles.size(), [](size_t i) {
+			return &Particles[i];
+		});
+
+		// expired particles are squeezed out, so the rest keep their order
+		num_alive = 0;
+
+		for (size_t i = 0; i < Particles.size(); ++i)
+		{
+			if (states[i] == particle_move_state::EXPIRED)
 				continue;
-			}
 
-			// next particle
-			++p;
+			if (num_alive != i)
+				Particles[num_alive] = std::move(Particles[i]);
+
+			++num_alive;
 		}
+
+		Particles.erase(Particles.begin() + num_alive, Particles.end());
+
+		move_simple_particles(frametime);
 	}
 
 	// kill all active particles
@@ -382,24 +688,80 @@ namespace particle
 	{
 		// kill all active particles
 		Particles.clear();
-		Persistent_particles.clear();
+		Simple_particles.clear();
+		Simple_motion.resize(0);
+
+		for (auto slot : Persistent_live_slots) {
+			free_persistent_slot(slot);
+		}
+		Persistent_live_slots.clear();
+	}
+
+	/**
+	 * @brief Does the part of rendering a particle that doesn't need any curves
+	 *
+	 * Only reads the particle and the view, so any number of particles can be prepared at once on the worker threads.
+	 * Except those attached to another particle, which need the curves of their parent to find where they are.
+	 *
+	 * @param part The particle to prepare
+	 * @param prep Where the results go
+	 * @param on_main_thread If cleared, particles attached to other particles are left for the main thread
+	 */
+	void prepare_particle_render(const particle* part, particle_render_prep* prep, bool on_main_thread) {
+		prep->alpha_pending = false;
+
+		if (!on_main_thread && !part->attachment.is_not_attached() && !part->attachment.extract_object()) {
+			prep->prepared = false;
+			return;
+		}
+
+		prep->prepared = true;
+
+		// Wanderer - add support for attached particles
+		prep->world_pos = part->attachment.local_pos_to_global(part->pos);
+
+		const auto& source_effect = part->parent_effect.getParticleEffect();
+
+		// skip back-facing particles (ripped from fullneb code)
+		prep->back_facing = !source_effect.m_renderAsDecal && part->length == 0.0f && vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &prep->world_pos) <= 0.0f;
+
+		// decals aren't faded
+		if (prep->back_facing || source_effect.m_renderAsDecal) {
+			prep->alpha = 0.0f;
+			return;
+		}
+
+		// a particle with length is culled if its other end, which needs the curves, is behind the eye as well
+		if (part->length != 0.0f && vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &prep->world_pos) <= 0.0f) {
+			prep->alpha_pending = true;
+		} else {
+			prep->alpha = get_current_alpha(&prep->world_pos, part->radius);
+		}
+
+		vertex pos;
+		prep->codes = g3_rotate_vertex_uncounted(&pos, &prep->world_pos);
 	}
 
 	/**
 	 * @brief Renders a single particle
+	 *
+	 * Evaluates the curves and sets aside room in the rendering batch, in the same order no matter how many threads
+	 * prepared the particles. The vertices are written by write_particle_vertices() afterwards.
+	 *
 	 * @param part The particle to render
+	 * @param prep What prepare_particle_render() worked out for it, gets what is needed for the vertices
 	 * @return @c true if the particle has been added to the rendering batch (notably, this only includes main-render pass, alternative dispatch through decals is not true), @c false otherwise
 	 */
-	bool render_particle(particle* part) {
-		// skip back-facing particles (ripped from fullneb code)
-		// Wanderer - add support for attached particles
-		vec3d p_pos = part->attachment.local_pos_to_global(part->pos);
+	bool render_particle(particle* part, particle_render_prep* prep) {
+		prep->slice = batch_slice();
+
+		vec3d p_pos = prep->world_pos;
 
 		bool part_has_length = part->length != 0.0f;
 
 		const auto& source_effect = part->parent_effect.getParticleEffect();
 
-		if (!source_effect.m_renderAsDecal && !part_has_length && vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &p_pos) <= 0.0f)
+		if (prep->back_facing)
 		{
 			return false;
 		}
@@ -488,8 +850,11 @@ namespace particle
 			}
 		}
 
-		// calculate the alpha to draw at
-		auto alpha = get_current_alpha(&p_pos, part->radius);
+		if (prep->alpha_pending) {
+			prep->alpha = get_current_alpha(&p_pos, part->radius);
+		}
+
+		auto alpha = prep->alpha;
 
 		// if it's transparent then just skip it
 		if (alpha <= 0.0f)
@@ -497,8 +862,7 @@ namespace particle
 			return false;
 		}
 
-		vertex pos;
-		auto flags = g3_rotate_vertex(&pos, &p_pos);
+		auto flags = prep->codes;
 
 		if (flags)
 		{
@@ -513,22 +877,31 @@ namespace particle
 			}
 		}
 
-		g3_transfer_vertex(&pos, &p_pos);
-
-		float radius = part->radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
+		prep->radius = part->radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
+		prep->has_length = part_has_length;
 
 		if (part_has_length) {
-			vec3d p0 = p_pos;
-			batching_add_laser(actual_frame, &p0, radius, &p1, radius);
+			prep->end_pos = p1;
+			prep->slice = batching_allocate_laser(actual_frame);
 		}
 		else {
 			// it will subtract Physics_viewer_bank, so without the flag we counter that and make it screen-aligned again
-			batching_add_volume_bitmap_rotated(actual_frame, &pos, part->use_angle ? part->angle : Physics_viewer_bank, radius, alpha);
+			prep->angle = part->use_angle ? part->angle : Physics_viewer_bank;
+			prep->slice = batching_allocate_volume_bitmap_rotated(actual_frame, alpha);
 		}
 
 		return true;
 	}
 
+	// Writes the vertices of a particle into the room render_particle() set aside for them, from any thread
+	void write_particle_vertices(const particle_render_prep* prep) {
+		if (prep->has_length) {
+			batching_write_laser(prep->slice, &prep->world_pos, prep->radius, &prep->end_pos, prep->radius);
+		} else {
+			batching_write_volume_bitmap_rotated(prep->slice, &prep->world_pos, prep->angle, prep->radius);
+		}
+	}
+
 	void render_all()
 	{
 		GR_DEBUG_SCOPE("Render Particles");
@@ -537,16 +910,65 @@ namespace particle
 		if (!Particles_enabled)
 			return;
 
-		if (Persistent_particles.empty() && Particles.empty())
+		if (Persistent_live_slots.empty() && Particles.empty() && Simple_particles.empty())
 			return;
 
-		for (auto& part : Persistent_particles) {
-			render_particle(part.get());
+		const size_t num_persistent = Persistent_live_slots.size();
+		const size_t first_simple = num_persistent + Particles.size();
+		const size_t count = first_simple + Simple_particles.size();
+
+		auto particle_at = [num_persistent, first_simple](size_t i) {
+			if (i < num_persistent)
+				return &Persistent_particles[Persistent_live_slots[i]];
+
+			return (i < first_simple) ? &Particles[i - num_persistent] : &Simple_particles[i - first_simple];
+		};
+
+		Particle_render_preps.resize(count);
+
+		auto prepare_chunk = [&particle_at, first_simple](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				auto part = particle_at(i);
+
+				if (i >= first_simple) {
+					Simple_motion.sync(i - first_simple, part);
+				}
+
+				prepare_particle_render(part, &Particle_render_preps[i], false);
+			}
+		};
+
+		if (Particles_threaded) {
+			threading::parallel_for(count, PARTICLE_CHUNK_SIZE, prepare_chunk, &tracing::ParticlesRenderJob);
+		} else {
+			prepare_chunk(0, count);
 		}
 
-		for (auto& part : Particles) {
-			render_particle(&part);
+		// the batches are filled in order on this thread, so particles are drawn the same no matter who prepared them
+		for (size_t i = 0; i < count; ++i) {
+			auto part = particle_at(i);
+			auto prep = &Particle_render_preps[i];
+
+			if (!prep->prepared) {
+				prepare_particle_render(part, prep, true);
+			}
+
+			render_particle(part, prep);
 		}
 
+		auto write_chunk = [](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				if (Particle_render_preps[i].slice.batch != nullptr) {
+					write_particle_vertices(&Particle_render_preps[i]);
+				}
+			}
+		};
+
+		// nothing is added to the batches in the meantime, so the slices stay where they are
+		if (Particles_threaded) {
+			threading::parallel_for(count, PARTICLE_CHUNK_SIZE, write_chunk, &tracing::ParticlesRenderJob);
+		} else {
+			write_chunk(0, count);
+		}
 	}
 }
@@ -72,11 +72,6 @@ namespace particle
 	extern int Anim_bitmap_id_smoke2;
 	extern int Anim_num_frames_smoke2;
 
-	struct particle;
-
-	typedef std::weak_ptr<particle> WeakParticlePtr;
-	typedef std::shared_ptr<particle> ParticlePtr;
-
 	typedef struct particle {
 		// old style data
 		vec3d	pos;				// position
@@ -113,9 +108,9 @@ namespace particle
 	/**
 	 * @brief Creates a persistent particle
 	 *
-	 * A persistent particle is handled differently from a standard particle. It is possible to hold a weak or strong
-	 * reference to a persistent particle which allows to track where the particle is and also allows to change particle
-	 * properties after it has been created.
+	 * A persistent particle is handled differently from a standard particle. It is possible to hold a reference to a
+	 * persistent particle which allows to track where the particle is and also allows to change particle properties
+	 * after it has been created.
 	 *
 	 * @param pinfo A structure containg information about how the particle should be created
 	 * @return A weak reference to the particle
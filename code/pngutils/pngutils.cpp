@@ -2,9 +2,11 @@
 #include <cstring>
 
 #include "bmpman/bmpman.h"
+#include "bmpman/image_read_message.h"
 #include "cfile/cfile.h"
 #include "globalincs/pstypes.h"
 #include "graphics/2d.h"
+#include "parse/parselo.h"
 #include "pngutils/pngutils.h"
 #include "utils/base64.h"
 
@@ -13,6 +15,7 @@ struct png_status {
 	const char* filename = nullptr;
 	bool reading_header = false;
 	bool writing = false;
+	image_read_messages* messages = nullptr;	// where to leave messages instead of reporting them, if anywhere
 };
 
 /*
@@ -66,7 +69,11 @@ static void png_error_fn(png_structp png_ptr, png_const_charp message)
 {
 	png_status* status = reinterpret_cast<png_status*>(png_get_error_ptr(png_ptr));
 
-	if (status->writing) {
+	if (status->messages != nullptr) {
+		SCP_string text;
+		sprintf(text, "PNG error while reading %s of %s: %s\n", status->reading_header ? "header" : "pixel data", status->filename, message);
+		status->messages->push_back({image_read_message::severity::Log, nullptr, std::move(text)});
+	} else if (status->writing) {
 		mprintf(("PNG error while writing %s: %s\n", status->filename, message));
 	} else {
 		mprintf(("PNG error while reading %s of %s: %s\n", status->reading_header ? "header" : "pixel data", status->filename, message));
@@ -79,7 +86,11 @@ static void png_warning_fn(png_structp png_ptr, png_const_charp message)
 {
 	png_status* status = reinterpret_cast<png_status*>(png_get_error_ptr(png_ptr));
 
-	if (status->writing) {
+	if (status->messages != nullptr) {
+		SCP_string text;
+		sprintf(text, "PNG warning while reading %s of %s: %s\n", status->reading_header ? "header" : "pixel data", status->filename, message);
+		status->messages->push_back({image_read_message::severity::Filtered, "PNG warning", std::move(text)});
+	} else if (status->writing) {
 		nprintf(("PNG warning", "PNG warning while writing %s: %s\n", status->filename, message));
 	} else {
 		nprintf(("PNG warning", "PNG warning while reading %s of %s: %s\n", status->reading_header ? "header" : "pixel data", status->filename, message));
@@ -221,16 +232,30 @@ int png_read_header(const SCP_string& b64, int* w, int* h, int* bpp, ubyte* /*pa
 		}, []() {});
 }
 
+/*
+ * Leaves how reading a PNG failed in messages, or reports it if that isn't given
+ */
+static void png_read_bitmap_failed(image_read_messages* messages, const char* what)
+{
+	if (messages != nullptr) {
+		SCP_string text;
+		sprintf(text, "png_read_bitmap: %s\n", what);
+		messages->push_back({image_read_message::severity::Log, nullptr, std::move(text)});
+	} else
+		mprintf(("png_read_bitmap: %s\n", what));
+}
+
 /*
  * Loads a PNG image
  *
  * @param [out] image_data     allocated storage for the bitmap
  * @param [in]  bpp
  * @param [in]  dest_size
+ * @param [out] messages       where to leave messages instead of reporting them, if anywhere
  *
  * @retval true if succesful, false otherwise
  */
-static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, png_error_ptr error, png_error_ptr warning, png_rw_ptr readFunc, std::function<void()> onClose)
+static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, png_error_ptr error, png_error_ptr warning, png_rw_ptr readFunc, std::function<void()> onClose, image_read_messages *messages = nullptr)
 {
 	png_infop info_ptr;
 	png_structp png_ptr;
@@ -247,7 +272,7 @@ static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, p
 
 	if (png_ptr == nullptr)
 	{
-		mprintf(("png_read_bitmap: png_ptr went wrong\n"));
+		png_read_bitmap_failed(messages, "png_ptr went wrong");
 		onClose();
 		return PNG_ERROR_READING;
 	}
@@ -256,7 +281,7 @@ static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, p
 	info_ptr = png_create_info_struct(png_ptr);
 	if (info_ptr == nullptr)
 	{
-		mprintf(("png_read_bitmap: info_ptr went wrong\n"));
+		png_read_bitmap_failed(messages, "info_ptr went wrong");
 		onClose();
 		png_destroy_read_struct(&png_ptr, nullptr, nullptr);
 		return PNG_ERROR_READING;
@@ -264,7 +289,7 @@ static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, p
 
 	if (setjmp(png_jmpbuf(png_ptr)))
 	{
-		mprintf(("png_read_bitmap: something went wrong\n"));
+		png_read_bitmap_failed(messages, "something went wrong");
 		/* Free all of the memory associated with the png_ptr and info_ptr */
 		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 		onClose();
@@ -302,16 +327,18 @@ static int png_read_bitmap_data(ubyte *image_data, int *bpp, png_voidp status, p
  * @param [in]  bpp
  * @param [in]  dest_size
  * @param [in]  cf_type
+ * @param [out] messages       where to leave messages instead of reporting them, so that this can run on any thread
  *
  * @retval true if succesful, false otherwise
  */
-int png_read_bitmap(const char* real_filename, ubyte* image_data, int* bpp, int  /*dest_size*/, int cf_type)
+int png_read_bitmap(const char* real_filename, ubyte* image_data, int* bpp, int  /*dest_size*/, int cf_type, image_read_messages* messages)
 {
 	char filename[MAX_FILENAME_LEN];
 
 	png_status status;
 	status.reading_header = false;
 	status.filename = real_filename;
+	status.messages = messages;
 
 	strcpy_s(filename, real_filename);
 	char* p = strchr(filename, '.');
@@ -323,7 +350,7 @@ int png_read_bitmap(const char* real_filename, ubyte* image_data, int* bpp, int
 	if (status.cfp == NULL)
 		return PNG_ERROR_READING;
 
-	return png_read_bitmap_data(image_data, bpp, &status, png_error_fn, png_warning_fn, png_scp_read_data, [&status]() {cfclose(status.cfp); });
+	return png_read_bitmap_data(image_data, bpp, &status, png_error_fn, png_warning_fn, png_scp_read_data, [&status]() {cfclose(status.cfp); }, messages);
 }
 
 int png_read_bitmap(const SCP_string& b64, ubyte* image_data, int* bpp)
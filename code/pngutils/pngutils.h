@@ -6,6 +6,7 @@
 // one that FSO uses; and it is
 #define PNG_SKIP_SETJMP_CHECK
 
+#include "bmpman/image_read_message.h"
 #include "cfile/cfile.h"
 #include "globalincs/pstypes.h"
 #include "png.h"
@@ -17,7 +18,8 @@
 // reading
 extern int png_read_header(const char *real_filename, CFILE *img_cfp = NULL, int *w = nullptr, int *h = nullptr, int *bpp = nullptr, ubyte *palette = nullptr);
 extern int png_read_header(const SCP_string& b64, int* w, int* h, int* bpp, ubyte *palette = nullptr);
-extern int png_read_bitmap(const char *real_filename, ubyte *image_data, int *bpp, int dest_size, int cf_type = CF_TYPE_ANY);
+// if messages is given, errors and warnings are left there instead of being reported, so this can run on any thread
+extern int png_read_bitmap(const char *real_filename, ubyte *image_data, int *bpp, int dest_size, int cf_type = CF_TYPE_ANY, image_read_messages *messages = nullptr);
 extern int png_read_bitmap(const SCP_string& b64, ubyte* image_data, int* bpp);
 
 extern bool png_write_bitmap(const char* filename, size_t width, size_t height, bool y_flip, const uint8_t* data);
@@ -127,6 +127,12 @@ int g3_check_normal_facing(const vec3d *v, const vec3d *norm);
  */
 ubyte g3_rotate_vertex(vertex *dest, const vec3d *src);
 
+/**
+ * Same as g3_rotate_vertex(), but without counting the rotation, so it may be called from the worker threads as long
+ * as the view doesn't change
+ */
+ubyte g3_rotate_vertex_uncounted(vertex *dest, const vec3d *src);
+
 /**
  * Use this for stars, etc
  */
@@ -42,6 +42,20 @@ size_t primitive_batch::load_buffer(batch_vertex* buffer, size_t n_verts)
 	return verts_to_render;
 }
 
+size_t primitive_batch::allocate_verts(size_t n_verts)
+{
+	size_t offset = Vertices.size();
+
+	Vertices.resize(offset + n_verts);
+
+	return offset;
+}
+
+batch_vertex* primitive_batch::get_verts(size_t offset)
+{
+	return &Vertices[offset];
+}
+
 void primitive_batch::clear()
 {
 	Vertices.clear();
@@ -268,10 +282,9 @@ void batching_add_bitmap_internal(primitive_batch *batch, int texture, vertex *p
 	batch->add_triangle(&verts[2], &verts[1], &verts[0]);
 }
 
-void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, vertex *pnt, float angle, float rad, color *clr, float depth)
+// Writes the two triangles of a rotated bitmap, in the order they go into the batch
+static void batching_write_bitmap_rotated_verts(batch_vertex *verts, int array_index, const vec3d *pnt, float angle, float rad, const color *clr, float depth)
 {
-	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
-
 	float radius = rad;
 	rad *= 1.41421356f;//1/0.707, becase these are the points of a square or width and height rad
 
@@ -283,10 +296,9 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 	else if ( angle > PI2 )
 		angle -= PI2;
 
-	vec3d PNT(pnt->world);
+	vec3d PNT(*pnt);
 	vec3d p[4];
 	vec3d fvec, rvec, uvec;
-	batch_vertex verts[6];
 
 	vm_vec_sub(&fvec, &View_position, &PNT);
 	vm_vec_normalize_safe(&fvec);
@@ -328,7 +340,6 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 	verts[1].tex_coord.xyzw.x = 1.0f;	verts[1].tex_coord.xyzw.y = 1.0f;
 	verts[0].tex_coord.xyzw.x = 0.0f;	verts[0].tex_coord.xyzw.y = 1.0f;
 
-	auto array_index = texture - batch->get_render_info().texture;
 	for (int i = 0; i < 6 ; i++) {
 		verts[i].r = clr->red;
 		verts[i].g = clr->green;
@@ -339,6 +350,15 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 		verts[i].tex_coord.xyzw.z = (float)array_index;
 		verts[i].tex_coord.xyzw.w = 1.0f;
 	}
+}
+
+void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, vertex *pnt, float angle, float rad, color *clr, float depth)
+{
+	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
+
+	batch_vertex verts[6];
+
+	batching_write_bitmap_rotated_verts(verts, texture - batch->get_render_info().texture, &pnt->world, angle, rad, clr, depth);
 
 	batch->add_triangle(&verts[0], &verts[1], &verts[2]);
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
@@ -603,10 +623,9 @@ void batching_add_line_internal(primitive_batch *batch, int texture, vec3d *star
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
 }
 
-void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
+// Writes the two triangles of a laser, in the order they go into the batch
+static void batching_write_laser_verts(batch_vertex *verts, int array_index, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
 {
-	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
-
 	width1 *= 0.5f;
 	width2 *= 0.5f;
 
@@ -637,7 +656,6 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	vm_vec_scale_add(&end, p1, &fvec, width2);
 
 	vec3d vecs[4];
-	batch_vertex verts[6];
 
 	vm_vec_scale_add( &vecs[0], &end, &uvec, width2 );
 	vm_vec_scale_add( &vecs[1], &start, &uvec, width1 );
@@ -652,8 +670,6 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	verts[4].position = vecs[2];
 	verts[5].position = vecs[3];
 
-	auto array_index = texture - batch->get_render_info().texture;
-
 	float ratio = width2 / width1;
 	if (width1 <= 0.0f)
 		ratio = 999.0f;
@@ -665,12 +681,21 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	verts[4].tex_coord = vm_vec4_new(0.0f, 1.0f, (float)array_index, 1.0f);
 	verts[5].tex_coord = vm_vec4_new(1.0f, ratio, (float)array_index, ratio);
 
-	for (auto& vert : verts) {
-		vert.r = (ubyte)r;
-		vert.g = (ubyte)g;
-		vert.b = (ubyte)b;
-		vert.a = 255;
+	for (int i = 0; i < 6; i++) {
+		verts[i].r = (ubyte)r;
+		verts[i].g = (ubyte)g;
+		verts[i].b = (ubyte)b;
+		verts[i].a = 255;
 	}
+}
+
+void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
+{
+	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
+
+	batch_vertex verts[6];
+
+	batching_write_laser_verts(verts, texture - batch->get_render_info().texture, p0, width1, p1, width2, r, g, b);
 
 	batch->add_triangle(&verts[0], &verts[1], &verts[2]);
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
@@ -852,6 +877,65 @@ void batching_add_laser(int texture, const vec3d *p0, float width1, const vec3d
 	batching_add_laser_internal(batch, texture, p0, width1, p1, width2, r, g, b);
 }
 
+batch_slice batching_allocate_volume_bitmap_rotated(int texture, float alpha)
+{
+	Assertion((texture >= 0), "batching_allocate_...() attempted for invalid texture");
+
+	batch_slice slice;
+
+	if ( texture < 0 ) {
+		return slice;
+	}
+
+	if ( gr_is_capable(gr_capability::CAPABILITY_SOFT_PARTICLES) ) {
+		slice.batch = batching_find_batch(texture, batch_info::VOLUME_EMISSIVE);
+	} else {
+		slice.batch = batching_find_batch(texture, batch_info::FLAT_EMISSIVE);
+	}
+
+	slice.offset = slice.batch->allocate_verts(6);
+	slice.array_index = texture - slice.batch->get_render_info().texture;
+	batching_determine_blend_color(&slice.clr, texture, alpha);
+
+	return slice;
+}
+
+void batching_write_volume_bitmap_rotated(const batch_slice& slice, const vec3d *pnt, float angle, float rad, float depth)
+{
+	if ( slice.batch == nullptr ) {
+		return;
+	}
+
+	batching_write_bitmap_rotated_verts(slice.batch->get_verts(slice.offset), slice.array_index, pnt, angle, rad, &slice.clr, depth);
+}
+
+batch_slice batching_allocate_laser(int texture, int r, int g, int b)
+{
+	Assertion((texture >= 0), "batching_allocate_laser() attempted for invalid texture");
+
+	batch_slice slice;
+
+	if ( texture < 0 ) {
+		return slice;
+	}
+
+	slice.batch = batching_find_batch(texture, batch_info::FLAT_EMISSIVE);
+	slice.offset = slice.batch->allocate_verts(6);
+	slice.array_index = texture - slice.batch->get_render_info().texture;
+	gr_init_alphacolor(&slice.clr, r, g, b, 255);
+
+	return slice;
+}
+
+void batching_write_laser(const batch_slice& slice, const vec3d *p0, float width1, const vec3d *p1, float width2)
+{
+	if ( slice.batch == nullptr ) {
+		return;
+	}
+
+	batching_write_laser_verts(slice.batch->get_verts(slice.offset), slice.array_index, p0, width1, p1, width2, slice.clr.red, slice.clr.green, slice.clr.blue);
+}
+
 void batching_add_volume_polygon(int texture, const vec3d* pos, const matrix* orient, float width, float height, float alpha)
 {
 	Assertion((texture >= 0), "batching_add_volume_polygon() attempted for invalid texture");
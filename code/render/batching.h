@@ -87,6 +87,11 @@ public:
 
 	size_t num_verts() { return Vertices.size();  }
 
+	// Makes room for n_verts vertices that are written later, returns where they start
+	size_t allocate_verts(size_t n_verts);
+	// Only valid until the next vertices are added to this batch
+	batch_vertex* get_verts(size_t offset);
+
 	void clear();
 };
 
@@ -131,6 +136,26 @@ void batching_add_tri(int texture, vertex *verts);
 void batching_add_quad(int texture, vertex *verts, primitive_batch* batch, float trapezoidal_correction = 1.0f);
 void batching_add_tri(int texture, vertex *verts, primitive_batch* batch);
 
+/**
+ * @brief Room in a batch for one primitive, whose vertices are written later
+ *
+ * Allocating the slices on the main thread keeps the primitives in the order they were allocated in. After that, the
+ * vertices of different slices can be written from any thread, as long as nothing is added to the batches until all of
+ * them are done.
+ */
+struct batch_slice {
+	primitive_batch *batch = nullptr;	// nullptr if there's nothing to write
+	size_t offset = 0;
+	int array_index = 0;
+	color clr;
+};
+
+// These do the same as batching_add_volume_bitmap_rotated() and batching_add_laser(), split in two
+batch_slice batching_allocate_volume_bitmap_rotated(int texture, float alpha = 1.0f);
+void batching_write_volume_bitmap_rotated(const batch_slice& slice, const vec3d *pnt, float angle, float rad, float depth = 0.0f);
+batch_slice batching_allocate_laser(int texture, int r = 255, int g = 255, int b = 255);
+void batching_write_laser(const batch_slice& slice, const vec3d *p0, float width1, const vec3d *p1, float width2);
+
 void batching_render_all(bool render_distortions = false);
 
 void batching_shutdown();
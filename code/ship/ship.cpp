@@ -64,10 +64,12 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
 #include "particle/ParticleEffect.h"
 #include "particle/volumes/LegacyAACuboidVolume.h"
 #include "scripting/hook_api.h"
@@ -816,6 +818,7 @@ static void ship_obj_list_init()
 	int i;
 
 	list_init(&Ship_obj_list);
+	obj_grid_invalidate(obj_grid_type::SHIPS);
 	for ( i = 0; i < MAX_SHIP_OBJS; i++ ) {
 		ship_obj_list_reset_slot(i);
 	}
@@ -842,6 +845,7 @@ static int ship_obj_list_add(int objnum)
 	Ship_objs[i].objnum = objnum;
 	list_append(&Ship_obj_list, &Ship_objs[i]);
 	Ship_objs[i].flags |= SHIP_OBJ_USED;
+	obj_grid_invalidate(obj_grid_type::SHIPS);
 
 	return i;
 }
@@ -855,6 +859,7 @@ static void ship_obj_list_remove(int index)
 	Assert(index >= 0 && index < MAX_SHIP_OBJS);
 	list_remove( Ship_obj_list, &Ship_objs[index]);	
 	ship_obj_list_reset_slot(index);
+	obj_grid_invalidate(obj_grid_type::SHIPS);
 }
 
 ship_obj *get_ship_obj_ptr_from_index(int index)
@@ -8913,6 +8918,7 @@ void ship_cleanup(int shipnum, int cleanup_mode)
 	auto entry = &Ship_registry[entry_index];
 	entry->status = ShipStatus::EXITED;
 	entry->cleanup_mode = cleanup_mode;
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 
 	// add the information to the exited ship list
 	switch (cleanup_mode) {
@@ -10306,6 +10312,31 @@ static void lethality_decay(ai_info *aip)
 #endif
 }
 
+// whether an arriving or departing ship is far enough along to fly itself
+static bool ship_ai_in_control(const ship* shipp)
+{
+	return (!(shipp->is_arriving()) || (Ai_info[shipp->ai_index].mode == AIM_BAY_EMERGE)
+		|| ((Warp_params[shipp->warpin_params_index].warp_type == WT_IN_PLACE_ANIM) && (shipp->flags[Ship_Flags::Arriving_stage_2])))
+		&& !(shipp->flags[Ship_Flags::Depart_warp]);
+}
+
+// whether ship_evaluate_ai() is going to run the full AI of the ship this frame, for the think phase of the AI
+bool ship_will_evaluate_ai(const object* obj)
+{
+	if (MULTIPLAYER_CLIENT || obj->type != OBJ_SHIP)
+		return false;
+
+	auto shipp = &Ships[obj->instance];
+
+	if (shipp->ai_index < 0 || physics_paused || ai_paused)
+		return false;
+
+	if ((obj->flags[Object::Object_Flags::Player_ship]) && !Player_use_ai)
+		return false;
+
+	return ship_ai_in_control(shipp);
+}
+
 // moved out of ship_process_post() so it can be called from either -post() or -pre() depending on Framerate_independent_turning
 void ship_evaluate_ai(object* obj, float frametime) {
 
@@ -10498,9 +10529,7 @@ void ship_process_pre(object *obj, float frametime)
 	Assert(Ships[num].objnum == OBJ_INDEX(obj));
 	ship* shipp = &Ships[num];
 
-	if ((!(shipp->is_arriving()) || (Ai_info[shipp->ai_index].mode == AIM_BAY_EMERGE)
-		|| ((Warp_params[shipp->warpin_params_index].warp_type == WT_IN_PLACE_ANIM) && (shipp->flags[Ship_Flags::Arriving_stage_2])))
-		&& !(shipp->flags[Ship_Flags::Depart_warp]))
+	if (ship_ai_in_control(shipp))
 	{
 		ship_evaluate_ai(obj, frametime);
 	}
@@ -11444,6 +11473,7 @@ int ship_create(matrix* orient, vec3d* pos, int ship_type, const char* ship_name
 		entry->objnum = objnum;
 		entry->shipnum = shipnum;
 	}
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 	
 	// Start up stracking for this ship in multi.
 	if (Game_mode & (GM_MULTIPLAYER)) {
@@ -12321,6 +12351,9 @@ void change_ship_type(int n, int ship_type, int by_sexp)
 		// such as when a ship is created via the create-ship sexp
 		hud_wingman_status_set_index(&Wings[sp->wingnum], sp, p_objp);
 	}
+
+	// the ship now counts as its new type for ship-type-destroyed and friends
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 }
 
 /**
@@ -16866,6 +16899,7 @@ void ship_clear_ship_type_counts()
 		Ship_type_counts[i].killed = 0;
 		Ship_type_counts[i].total = 0;
 	}
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 }
 
 void ship_add_ship_type_count( int ship_info_index, int num )
@@ -16879,6 +16913,7 @@ void ship_add_ship_type_count( int ship_info_index, int num )
 
 	//Add it
 	Ship_type_counts[type].total += num;
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 }
 
 static void ship_add_ship_type_kill_count( int ship_info_index )
@@ -16892,6 +16927,7 @@ static void ship_add_ship_type_kill_count( int ship_info_index )
 
 	//Add it
 	Ship_type_counts[type].killed++;
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
 }
 
 int ship_query_general_type(int ship)
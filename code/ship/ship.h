@@ -1775,6 +1775,7 @@ extern int ship_create(matrix* orient, vec3d* pos, int ship_type, const char* sh
 extern void change_ship_type(int n, int ship_type, int by_sexp = 0);
 extern void ship_process_pre( object * objp, float frametime );
 extern void ship_process_post( object * objp, float frametime );
+extern bool ship_will_evaluate_ai(const object* objp);
 extern void ship_render( object * obj, model_draw_list * scene );
 extern bool ship_render_player_ship_casts_shadow_on_cockpit();
 extern bool ship_render_player_has_closeup_visuals();
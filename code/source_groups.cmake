@@ -79,6 +79,8 @@ add_file_folder("AI"
 	ai/aigoals.cpp
 	ai/aigoals.h
 	ai/aiinternal.h
+	ai/aithink.cpp
+	ai/aithink.h
 	ai/ailua.cpp
 	ai/ailua.h
 	ai/aiturret.cpp
@@ -109,6 +111,7 @@ add_file_folder("Bmpman"
 	bmpman/bm_internal.h
 	bmpman/bmpman.cpp
 	bmpman/bmpman.h
+	bmpman/image_read_message.h
 )
 
 # Camera files
@@ -1109,6 +1112,8 @@ add_file_folder("Object"
 	object/object.h
 	object/objectdock.cpp
 	object/objectdock.h
+	object/objectgrid.cpp
+	object/objectgrid.h
 	object/objectshield.cpp
 	object/objectshield.h
 	object/objectsnd.cpp
@@ -43,6 +43,12 @@ Category FindOverlapColliders("Find overlap colliders", false);
 Category CollidePair("Collide Pair", false);
 Category RetimeCollisionCache("Retime Collision Cache", false);
 
+Category RunJobGraph("Run job graph", false);
+Category Job("Job", false);
+
+Category AIThink("AI think", false);
+Category AIThinkJob("AI think job", false);
+
 Category WeaponPostMove("Weapon post move", false);
 Category ShipPostMove("Ship post move", false);
 Category FireballPostMove("Fireball post move", false);
@@ -78,6 +84,8 @@ Category NonrepeatingEvents("Nonrepeating events", false);
 
 Category ParticlesRenderAll("Render particles", true);
 Category ParticlesMoveAll("Move particles", false);
+Category ParticlesMoveJob("Move particles job", false);
+Category ParticlesRenderJob("Prepare particles for rendering job", false);
 
 Category EnvironmentMapping("Environment Mapping", true);
 Category BuildShadowMap("Build Shadow Map", true);
@@ -97,6 +105,8 @@ Category MainFrame("Main Frame", true);
 Category PageFlip("Page flip", true);
 
 Category Volumetrics("Volumetrics", true);
+Category RenderVolumeBitmap("Render volume bitmap", false);
+Category RenderVolumeBitmapJob("Render volume bitmap job", false);
 
 Category NanoVGFlushFrame("NanoVG flush frame", true);
 Category NanoVGDrawFill("NanoVG Draw fill", true);
@@ -138,6 +148,8 @@ Category LoadSound("Load Sound", false);
 Category LevelPageIn("Level page in", false);
 Category PageInStop("Finish page in", false);
 Category PageInSingleBitmap("Page in single bitmap", false);
+Category PageInDecode("Decode bitmaps for page in", false);
+Category PageInDecodeBitmap("Decode single bitmap", false);
 Category ShipPageIn("Ship page in", false);
 Category WeaponPageIn("Weapon page in", false);
 
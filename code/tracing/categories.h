@@ -56,6 +56,12 @@ extern Category FindOverlapColliders;
 extern Category CollidePair;
 extern Category RetimeCollisionCache;
 
+extern Category RunJobGraph;
+extern Category Job;
+
+extern Category AIThink;
+extern Category AIThinkJob;
+
 extern Category WeaponPostMove;
 extern Category ShipPostMove;
 extern Category FireballPostMove;
@@ -91,6 +97,8 @@ extern Category NonrepeatingEvents;
 
 extern Category ParticlesRenderAll;
 extern Category ParticlesMoveAll;
+extern Category ParticlesMoveJob;
+extern Category ParticlesRenderJob;
 
 extern Category EnvironmentMapping;
 extern Category BuildShadowMap;
@@ -110,6 +118,8 @@ extern Category MainFrame;
 extern Category PageFlip;
 
 extern Category Volumetrics;
+extern Category RenderVolumeBitmap;
+extern Category RenderVolumeBitmapJob;
 
 extern Category NanoVGFlushFrame;
 extern Category NanoVGDrawFill;
@@ -152,6 +162,8 @@ extern Category LoadSound;
 extern Category LevelPageIn;
 extern Category PageInStop;
 extern Category PageInSingleBitmap;
+extern Category PageInDecode;
+extern Category PageInDecodeBitmap;
 extern Category ShipPageIn;
 extern Category WeaponPageIn;
 
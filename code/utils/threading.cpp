@@ -3,6 +3,7 @@
 #include "cmdline/cmdline.h"
 #include "object/objcollide.h"
 #include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
 
 #include <atomic>
 #include <condition_variable>
@@ -34,7 +35,146 @@ namespace threading {
 
 	static SCP_vector<std::thread> worker_threads;
 
+	//Only touched by the main thread. Set while the pool is working on a task.
+	static bool task_active = false;
+
+	//The thread that started the pool, which is the only one allowed to hand it jobs
+	static std::thread::id pool_owner_thread;
+
+	//Set on threads that are currently running a job, so that nested job graphs don't try to use the pool.
+	static thread_local bool running_job = false;
+
+	//State of the job graph that is currently being run
+	struct job_ready_slot {
+		std::atomic_bool published;
+		job_id id;
+	};
+
+	struct job_run_state {
+		job_graph* graph = nullptr;
+		size_t num_jobs = 0;
+		size_t capacity = 0;
+
+		std::unique_ptr<std::atomic_int[]> remaining_dependencies;
+
+		//Every job becomes ready exactly once, so ready jobs are simply appended to a list of num_jobs slots
+		std::unique_ptr<job_ready_slot[]> ready;
+		std::atomic_size_t ready_push;
+		std::atomic_size_t ready_pop;
+
+		std::atomic_size_t completed;
+
+		//Set by the main thread once it has stopped the task, so workers know they can return
+		std::atomic_bool finished;
+
+		//Threads with nothing to do wait here until a job becomes ready or everything is done
+		std::mutex park_mutex;
+		std::condition_variable park_cv;
+		size_t park_generation = 0;
+		std::atomic_size_t num_parked;
+	};
+
+	static job_run_state job_state;
+
 	//Internal Functions
+	static void unpark_job_threads(bool all) {
+		//Pairs with the increment in park_job_thread(), so either we see the parked thread or it sees our change
+		if (job_state.num_parked.load(std::memory_order_seq_cst) == 0)
+			return;
+
+		{
+			std::scoped_lock lock(job_state.park_mutex);
+			++job_state.park_generation;
+		}
+
+		if (all)
+			job_state.park_cv.notify_all();
+		else
+			job_state.park_cv.notify_one();
+	}
+
+	static void park_job_thread(bool main_thread) {
+		std::unique_lock<std::mutex> lk(job_state.park_mutex);
+		const size_t generation = job_state.park_generation;
+
+		job_state.num_parked.fetch_add(1, std::memory_order_seq_cst);
+
+		const bool done = main_thread ? job_state.completed.load(std::memory_order_seq_cst) >= job_state.num_jobs
+		                              : job_state.finished.load(std::memory_order_seq_cst);
+		const bool has_work = job_state.ready_pop.load(std::memory_order_seq_cst) < job_state.ready_push.load(std::memory_order_seq_cst);
+
+		if (!done && !has_work)
+			job_state.park_cv.wait(lk, [generation]() { return job_state.park_generation != generation; });
+
+		job_state.num_parked.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+	static void push_ready_job(job_id id) {
+		const size_t slot = job_state.ready_push.fetch_add(1, std::memory_order_seq_cst);
+		job_state.ready[slot].id = id;
+		job_state.ready[slot].published.store(true, std::memory_order_seq_cst);
+	}
+
+	static bool take_ready_job(job_id& id_out) {
+		size_t pop = job_state.ready_pop.load(std::memory_order_acquire);
+
+		while (pop < job_state.ready_push.load(std::memory_order_acquire)) {
+			auto& slot = job_state.ready[pop];
+
+			//Claimed but not filled in yet, try again later
+			if (!slot.published.load(std::memory_order_acquire))
+				return false;
+
+			const job_id id = slot.id;
+
+			if (job_state.ready_pop.compare_exchange_weak(pop, pop + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				id_out = id;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static void execute_job(const job_graph::job& job) {
+		running_job = true;
+		{
+			tracing::complete::ScopedCompleteEvent trace_scope(job.category != nullptr ? *job.category : tracing::Job);
+			job.func();
+		}
+		running_job = false;
+	}
+
+	//Run by the main thread until every job of the current graph is done, and by the workers until the task is stopped
+	static void run_jobs(bool main_thread) {
+		auto& jobs = job_state.graph->jobs();
+
+		while (main_thread ? job_state.completed.load(std::memory_order_acquire) < job_state.num_jobs
+		                   : !job_state.finished.load(std::memory_order_acquire)) {
+			job_id id;
+
+			if (!take_ready_job(id)) {
+				park_job_thread(main_thread);
+				continue;
+			}
+
+			execute_job(jobs[id]);
+
+			size_t num_readied = 0;
+			for (auto dependent : jobs[id].dependents) {
+				if (job_state.remaining_dependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					push_ready_job(dependent);
+					num_readied++;
+				}
+			}
+
+			if (job_state.completed.fetch_add(1, std::memory_order_seq_cst) + 1 == job_state.num_jobs)
+				unpark_job_threads(true);
+			else if (num_readied > 0)
+				unpark_job_threads(num_readied > 1);
+		}
+	}
+
 	static void mp_worker_thread_main(size_t threadIdx) {
 		while(true) {
 			{
@@ -61,6 +201,9 @@ namespace threading {
 				case WorkerThreadTask::COLLISION:
 					collide_mp_worker_thread(threadIdx);
 					break;
+				case WorkerThreadTask::JOBS:
+					run_jobs(false);
+					break;
 				default:
 					UNREACHABLE("Invalid threaded worker task!");
 			}
@@ -172,6 +315,7 @@ namespace threading {
 			wait_for_spindown_tasks_counter = 0;
 			//No notify here cause we only ever lock, never unlock the wait here.
 		}
+		task_active = task != WorkerThreadTask::EXIT;
 		worker_task.store(task);
 		{
 			std::scoped_lock lock {wait_for_task_mutex};
@@ -199,6 +343,7 @@ namespace threading {
 			std::unique_lock<std::mutex> lk(wait_for_spindown_task_mutex);
 			wait_for_spindown_tasks.wait(lk, []() { return wait_for_spindown_tasks_counter >= num_threads; });
 		};
+		task_active = false;
 	}
 
 	void init_task_pool() {
@@ -212,6 +357,8 @@ namespace threading {
 			num_threads = Cmdline_multithreading - 1;
 		}
 
+		pool_owner_thread = std::this_thread::get_id();
+
 		if (!is_threading())
 			return;
 
@@ -220,6 +367,9 @@ namespace threading {
 		for (size_t i = 0; i < num_threads; i++) {
 			worker_threads.emplace_back([i](){ mp_worker_thread_main(i); });
 		}
+
+		//Every worker reports in once it is ready for its first task, which must not be mixed up with the end of one
+		spin_down_wait_complete();
 	}
 
 	void shut_down_task_pool() {
@@ -230,6 +380,14 @@ namespace threading {
 		for(auto& thread : worker_threads) {
 			thread.join();
 		}
+
+		//Leave everything as init_task_pool() expects it, so that the pool can be started again
+		worker_threads.clear();
+		num_threads = 0;
+		pool_owner_thread = std::thread::id();
+		wait_for_task_condition = false;
+		wait_for_spindown_tasks_counter = 0;
+		wait_for_spinup_tasks_counter = 0;
 	}
 
 	bool is_threading() {
@@ -239,4 +397,146 @@ namespace threading {
 	size_t get_num_workers() {
 		return worker_threads.size();
 	}
+
+	bool in_job() {
+		return running_job;
+	}
+
+	job_arena::job_arena(size_t block_size) : m_block_size(block_size) {}
+
+	void* job_arena::allocate(size_t size, size_t alignment) {
+		Assertion(alignment > 0 && (alignment & (alignment - 1)) == 0, "Arena alignment must be a power of two!");
+
+		while (true) {
+			if (m_current_block < m_blocks.size()) {
+				auto base = reinterpret_cast<uintptr_t>(m_blocks[m_current_block].get());
+				uintptr_t aligned = (base + m_used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+				if (aligned + size <= base + m_block_size) {
+					m_used = (aligned + size) - base;
+					return reinterpret_cast<void*>(aligned);
+				}
+
+				//Doesn't fit, try the next block
+				m_current_block++;
+				m_used = 0;
+				continue;
+			}
+
+			//Oversized allocations get a block of their own
+			if (size + alignment > m_block_size)
+				m_block_size = size + alignment;
+
+			m_blocks.emplace_back(new uint8_t[m_block_size]);
+			m_current_block = m_blocks.size() - 1;
+			m_used = 0;
+		}
+	}
+
+	void job_arena::reset() {
+		m_current_block = 0;
+		m_used = 0;
+	}
+
+	job_id job_graph::add_job(std::function<void()> func, const tracing::Category* category) {
+		m_jobs.push_back(job{std::move(func), category, {}, 0});
+		return m_jobs.size() - 1;
+	}
+
+	void job_graph::add_dependency(job_id job, job_id prerequisite) {
+		Assertion(job < m_jobs.size() && prerequisite < job, "Jobs can only depend on jobs that were added before them!");
+
+		m_jobs[prerequisite].dependents.push_back(job);
+		m_jobs[job].num_dependencies++;
+	}
+
+	void job_graph::clear() {
+		m_jobs.clear();
+		m_arena.reset();
+	}
+
+	void run_job_graph(job_graph& graph) {
+		if (graph.empty())
+			return;
+
+		//job_state and task_active belong to the pool owner, jobs only get here to run their nested graph serially
+		Assertion(running_job || pool_owner_thread == std::thread::id() || std::this_thread::get_id() == pool_owner_thread,
+			"Job graphs may only be run from the main thread or from inside a job!");
+
+		TRACE_SCOPE(tracing::RunJobGraph);
+
+		if (worker_threads.empty() || task_active || running_job || graph.size() == 1) {
+			//Prerequisites are always added before the jobs that depend on them, so this order is a valid one
+			for (auto& job : graph.jobs()) {
+				const bool nested = running_job;
+				execute_job(job);
+				running_job = nested;
+			}
+			return;
+		}
+
+		const size_t num_jobs = graph.size();
+
+		if (job_state.capacity < num_jobs) {
+			job_state.capacity = num_jobs;
+			job_state.remaining_dependencies = std::make_unique<std::atomic_int[]>(num_jobs);
+			job_state.ready = std::make_unique<job_ready_slot[]>(num_jobs);
+		}
+
+		job_state.graph = &graph;
+		job_state.num_jobs = num_jobs;
+		job_state.ready_push.store(0);
+		job_state.ready_pop.store(0);
+		job_state.completed.store(0);
+		job_state.finished.store(false);
+
+		for (size_t i = 0; i < num_jobs; i++)
+			job_state.ready[i].published.store(false);
+
+		for (size_t i = 0; i < num_jobs; i++) {
+			job_state.remaining_dependencies[i].store(graph.jobs()[i].num_dependencies);
+
+			if (graph.jobs()[i].num_dependencies == 0)
+				push_ready_job(i);
+		}
+
+		spin_up_threaded_task(WorkerThreadTask::JOBS);
+
+		run_jobs(true);
+
+		//Same order as for collisions: workers only return once the task was stopped, so none can pick it up again
+		spin_down_threaded_task();
+		job_state.finished.store(true, std::memory_order_seq_cst);
+		unpark_job_threads(true);
+		spin_down_wait_complete();
+
+		job_state.graph = nullptr;
+	}
+
+	void parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t begin, size_t end)>& func, const tracing::Category* category) {
+		if (count == 0)
+			return;
+
+		if (chunk_size == 0)
+			chunk_size = 1;
+
+		Assertion(running_job || pool_owner_thread == std::thread::id() || std::this_thread::get_id() == pool_owner_thread,
+			"parallel_for() may only be called from the main thread or from inside a job!");
+
+		//parallel_for from inside a job must not touch the shared graph below, which may be the one being run
+		job_graph nested_graph;
+
+		//Kept around so that the job storage doesn't have to be reallocated for every call
+		static job_graph shared_graph;
+
+		auto& graph = (running_job || task_active) ? nested_graph : shared_graph;
+		graph.clear();
+
+		for (size_t begin = 0; begin < count; begin += chunk_size) {
+			const size_t end = std::min(begin + chunk_size, count);
+			graph.add_job([&func, begin, end]() { func(begin, end); }, category);
+		}
+
+		run_job_graph(graph);
+	}
 }
@@ -1,9 +1,18 @@
 #pragma once
 
+#include "globalincs/vmallocator.h"
+
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace tracing {
+class Category;
+}
 
 namespace threading {
-	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION };
+	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION, JOBS };
 
 	//Call this to start a task on the task pool. Note that task-specific data must be set up before calling this.
 	void spin_up_threaded_task(WorkerThreadTask task);
@@ -19,4 +28,82 @@ namespace threading {
 
 	bool is_threading();
 	size_t get_num_workers();
-}
\ No newline at end of file
+
+	//True while the calling thread is running a job, whether on a worker or on the thread that started the jobs
+	bool in_job();
+
+	//Simple bump allocator for data that only needs to live as long as a set of jobs.
+	//Not thread safe, so allocate while setting up the jobs, not from inside them.
+	class job_arena {
+		SCP_vector<std::unique_ptr<uint8_t[]>> m_blocks;
+		size_t m_block_size;
+		size_t m_current_block = 0;
+		size_t m_used = 0;
+
+	  public:
+		explicit job_arena(size_t block_size = 64 * 1024);
+
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		//Only for types that don't need destructing, since the arena never runs destructors.
+		template <typename T>
+		T* allocate_array(size_t count) {
+			static_assert(std::is_trivially_destructible<T>::value, "Arena memory is released without running destructors!");
+			auto mem = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+			for (size_t i = 0; i < count; i++) {
+				new (mem + i) T();
+			}
+			return mem;
+		}
+
+		//Makes all memory available again. Keeps the allocated blocks around for reuse.
+		void reset();
+	};
+
+	using job_id = size_t;
+
+	//A set of jobs with optional dependencies between them. A job is only started once all jobs it depends on have
+	//finished. Jobs without dependencies between them may run concurrently on the task pool.
+	//Keeping a graph around and clearing it every frame also makes its arena a per-frame arena.
+	class job_graph {
+	  public:
+		struct job {
+			std::function<void()> func;
+			const tracing::Category* category;
+			SCP_vector<job_id> dependents;
+			int num_dependencies;
+		};
+
+	  private:
+		SCP_vector<job> m_jobs;
+		job_arena m_arena;
+
+	  public:
+		//If a category is given, the job is traced with it, otherwise with the generic job category.
+		job_id add_job(std::function<void()> func, const tracing::Category* category = nullptr);
+
+		//Makes job wait until prerequisite has finished. Prerequisite must have been added before job.
+		void add_dependency(job_id job, job_id prerequisite);
+
+		job_arena& arena() { return m_arena; }
+
+		const SCP_vector<job>& jobs() const { return m_jobs; }
+
+		size_t size() const { return m_jobs.size(); }
+		bool empty() const { return m_jobs.empty(); }
+
+		void clear();
+	};
+
+	//Runs all jobs of the graph and returns once they have all finished (fork/join). The calling thread takes part in
+	//running the jobs. Falls back to running them in order on the calling thread if there is no task pool, the pool
+	//is busy with another task, or this is called from inside a job.
+	//Must only be called from the thread that called init_task_pool() (the main thread) or from inside a job, since
+	//the state of the graph being run is shared.
+	void run_job_graph(job_graph& graph);
+
+	//Splits [0, count) into chunks of at most chunk_size and runs func(begin, end) for each chunk as a job.
+	//The same threads as for run_job_graph() may call this.
+	void parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t begin, size_t end)>& func,
+		const tracing::Category* category = nullptr);
+}
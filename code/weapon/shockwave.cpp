@@ -16,6 +16,7 @@
 #include "model/modelrender.h"
 #include "nebula/neb.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "options/Option.h"
 #include "render/3d.h"
 #include "render/batching.h"
@@ -321,7 +322,12 @@ void shockwave_move(object *shockwave_objp, float frametime)
 
 	// blast ships and asteroids
 	// And (some) weapons
-	for ( objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+	static SCP_vector<int> targets;
+	obj_grid_query(obj_grid_type::BLAST_TARGETS, &sw->pos, MIN(sw->radius, sw->outer_radius), OBJ_GRID_ALL_TEAMS, targets);
+
+	for ( int objnum : targets ) {
+		objp = &Objects[objnum];
+
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 		if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) && (objp->type != OBJ_WEAPON)) {
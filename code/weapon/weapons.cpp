@@ -39,6 +39,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "parse/parsehi.h"
@@ -334,6 +335,7 @@ void missile_obj_list_init()
 	int i;
 
 	list_init(&Missile_obj_list);
+	obj_grid_invalidate(obj_grid_type::MISSILES);
 	for ( i = 0; i < MAX_MISSILE_OBJS; i++ ) {
 		Missile_objs[i].flags = 0;
 	}
@@ -360,6 +362,7 @@ int missile_obj_list_add(int objnum)
 	Missile_objs[i].objnum = objnum;
 	list_append(&Missile_obj_list, &Missile_objs[i]);
 	Missile_objs[i].flags |= MISSILE_OBJ_USED;
+	obj_grid_invalidate(obj_grid_type::MISSILES);
 
 	return i;
 }
@@ -373,6 +376,7 @@ void missle_obj_list_remove(int index)
 	Assert(index >= 0 && index < MAX_MISSILE_OBJS);
 	list_remove(&Missile_obj_list, &Missile_objs[index]);	
 	Missile_objs[index].flags = 0;
+	obj_grid_invalidate(obj_grid_type::MISSILES);
 }
 
 /**
@@ -770,8 +770,8 @@ const char *VoiceActingManager::get_message_sender(const MMessage *message)
 		if (op == OP_SEND_MESSAGE)
 		{
 			// the first argument is the sender; the third is the message
-			if (!strcmp(message->name, Sexp_nodes[CDDR(n)].text))
-				return Sexp_nodes[n].text;
+			if (!strcmp(message->name, Sexp_node_data[CDDR(n)].text))
+				return Sexp_node_data[n].text;
 		}
 		else if (op == OP_SEND_MESSAGE_LIST || op == OP_SEND_MESSAGE_CHAIN)
 		{
@@ -783,8 +783,8 @@ const char *VoiceActingManager::get_message_sender(const MMessage *message)
 			while (n != -1)
 			{
 				// as before
-				if (!strcmp(message->name, Sexp_nodes[CDDR(n)].text))
-					return Sexp_nodes[n].text;
+				if (!strcmp(message->name, Sexp_node_data[CDDR(n)].text))
+					return Sexp_node_data[n].text;
 
 				// iterate along the list
 				n = CDDDDR(n);
@@ -793,13 +793,13 @@ const char *VoiceActingManager::get_message_sender(const MMessage *message)
 		else if (op == OP_SEND_RANDOM_MESSAGE)
 		{
 			// as before, sort of
-			char *sender = Sexp_nodes[n].text;
+			char *sender = Sexp_node_data[n].text;
 
 			// check the argument list
 			n = CDDR(n);
 			while (n != -1)
 			{
-				if (!strcmp(message->name, Sexp_nodes[n].text))
+				if (!strcmp(message->name, Sexp_node_data[n].text))
 					return sender;
 
 				// iterate along the list
@@ -809,7 +809,7 @@ const char *VoiceActingManager::get_message_sender(const MMessage *message)
 		else if (op == OP_TRAINING_MSG)
 		{
 			// just check the message
-			if (!strcmp(message->name, Sexp_nodes[n].text))
+			if (!strcmp(message->name, Sexp_node_data[n].text))
 				return "Training Message";
 		}
 	}
@@ -869,7 +869,7 @@ void VoiceActingManager::group_message_indexes_in_tree(int node, SCP_vector<int>
 		while (n != -1)
 		{
 			// the third argument is a message
-			char *message_name = Sexp_nodes[CDDR(n)].text;
+			char *message_name = Sexp_node_data[CDDR(n)].text;
 
 			// check source messages
 			for (size_t i = 0; i < source_list.size(); i++)
@@ -894,7 +894,7 @@ void VoiceActingManager::group_message_indexes_in_tree(int node, SCP_vector<int>
 		while (n != -1)
 		{
 			// each argument from this point on is a message
-			char *message_name = Sexp_nodes[n].text;
+			char *message_name = Sexp_node_data[n].text;
 
 			// check source messages
 			for (size_t i = 0; i < source_list.size(); i++)
@@ -7278,7 +7278,7 @@ void game_show_event_debug(float  /*frametime*/)
 			while (i--)
 				buf[i] = ' ';
 
-			strcat_s(buf, Sexp_nodes[z & 0x7fff].text);
+			strcat_s(buf, Sexp_node_data[z & 0x7fff].text);
 			switch (Sexp_nodes[z & 0x7fff].value) {
 				case SEXP_TRUE:
 					strcat_s(buf, NOX(" (True)"));
@@ -670,26 +670,26 @@ const char* VoiceActingManagerModel::getMessageSender(const MMessage* message)
 		int n = CDR(i);
 
 		if (op == OP_SEND_MESSAGE) {
-			if (!strcmp(message->name, Sexp_nodes[CDDR(n)].text))
-				return Sexp_nodes[n].text;
+			if (!strcmp(message->name, Sexp_node_data[CDDR(n)].text))
+				return Sexp_node_data[n].text;
 		} else if (op == OP_SEND_MESSAGE_LIST || op == OP_SEND_MESSAGE_CHAIN) {
 			if (op == OP_SEND_MESSAGE_CHAIN)
 				n = CDR(n);
 			while (n != -1) {
-				if (!strcmp(message->name, Sexp_nodes[CDDR(n)].text))
-					return Sexp_nodes[n].text;
+				if (!strcmp(message->name, Sexp_node_data[CDDR(n)].text))
+					return Sexp_node_data[n].text;
 				n = CDDDDR(n);
 			}
 		} else if (op == OP_SEND_RANDOM_MESSAGE) {
-			char* sender = Sexp_nodes[n].text;
+			char* sender = Sexp_node_data[n].text;
 			n = CDDR(n);
 			while (n != -1) {
-				if (!strcmp(message->name, Sexp_nodes[n].text))
+				if (!strcmp(message->name, Sexp_node_data[n].text))
 					return sender;
 				n = CDR(n);
 			}
 		} else if (op == OP_TRAINING_MSG) {
-			if (!strcmp(message->name, Sexp_nodes[n].text))
+			if (!strcmp(message->name, Sexp_node_data[n].text))
 				return "Training Message";
 		}
 	}
@@ -783,7 +783,7 @@ void VoiceActingManagerModel::groupMessageIndexesInTree(int node, SCP_vector<int
 		if (op == OP_SEND_MESSAGE_CHAIN)
 			n = CDR(n);
 		while (n != -1) {
-			char* message_name = Sexp_nodes[CDDR(n)].text;
+			char* message_name = Sexp_node_data[CDDR(n)].text;
 			for (int i = 0; i < static_cast<int>(source.size()); ++i) {
 				if (!strcmp(message_name, Messages[source[i]].name)) {
 					dest.push_back(source[i]);
@@ -796,7 +796,7 @@ void VoiceActingManagerModel::groupMessageIndexesInTree(int node, SCP_vector<int
 	} else if (op == OP_SEND_RANDOM_MESSAGE) {
 		n = CDDR(n);
 		while (n != -1) {
-			char* message_name = Sexp_nodes[n].text;
+			char* message_name = Sexp_node_data[n].text;
 			for (int i = 0; i < static_cast<int>(source.size()); ++i) {
 				if (!strcmp(message_name, Messages[source[i]].name)) {
 					dest.push_back(source[i]);
@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+
+#include "ai/ai.h"
+#include "ai/ai_profiles.h"
+#include "ai/aithink.h"
+#include "cmdline/cmdline.h"
+#include "globalincs/linklist.h"
+#include "globalincs/systemvars.h"
+#include "iff_defs/iff_defs.h"
+#include "io/timer.h"
+#include "mission/missionparse.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+#include "ship/ship.h"
+#include "utils/threading.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// A fleet that fights for a number of frames the way the game runs its AI: ai_think_all() looks for the enemies on
+// the workers, then every ship picks its target through find_enemy() in list order, flies towards it and shoots it.
+// Who a ship picks depends on who the ships before it picked and shot, so anything the think phase gets wrong about
+// the order or the state it reads shows up in where the ships end up.
+const int NUM_REPLAY_SHIPS = 300;
+const int NUM_REPLAY_FRAMES = 80;
+const float REPLAY_BATTLE_SIZE = 8000.0f;
+const float REPLAY_SHIP_SPEED = 60.0f;
+const float REPLAY_WEAPON_RANGE = 400.0f;
+const int REPLAY_MAX_ATTACKERS = 3;
+
+ship_obj Test_ship_objs[NUM_REPLAY_SHIPS];
+
+struct ship_state {
+	vec3d pos;
+	float hull;
+	int target_objnum;
+	int kills;
+};
+
+struct replay_outcome {
+	SCP_vector<uint> frame_checksums;
+	SCP_vector<ship_state> ships;
+};
+
+uint checksum(uint sum, const void* data, size_t size)
+{
+	auto bytes = static_cast<const ubyte*>(data);
+	for (size_t i = 0; i < size; i++) {
+		sum = (sum ^ bytes[i]) * 16777619u;
+	}
+	return sum;
+}
+
+}
+
+class AIThinkReplayTest : public ::testing::Test {
+  protected:
+	void SetUp() override {
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> coord(-REPLAY_BATTLE_SIZE / 2, REPLAY_BATTLE_SIZE / 2);
+		std::uniform_real_distribution<float> radius(10.0f, 50.0f);
+		std::uniform_int_distribution<int> sensor_range(1000, 4000);
+
+		// team 0 and 1 fight each other, team 2 attacks everyone but nobody attacks it
+		Iff_info.clear();
+		Iff_info.resize(3);
+		Iff_info[0].attackee_bitmask = iff_get_mask(1);
+		Iff_info[1].attackee_bitmask = iff_get_mask(0);
+		Iff_info[2].attackee_bitmask = iff_get_mask(0) | iff_get_mask(1);
+
+		Ship_types.clear();
+		Ship_types.emplace_back();
+		Ship_types[0].flags.set(Ship::Type_Info_Flags::AI_auto_attacks);
+
+		Ship_info.clear();
+		Ship_info.emplace_back();
+		Ship_info[0].class_type = 0;
+
+		for (auto& max_attackers : profile.max_attackers) {
+			max_attackers = REPLAY_MAX_ATTACKERS;
+		}
+		old_ai_profile = The_mission.ai_profile;
+		The_mission.ai_profile = &profile;
+
+		// the list order shouldn't have anything to do with the object numbers
+		SCP_vector<int> objnums;
+		for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+			objnums.push_back(i);
+		}
+		std::shuffle(objnums.begin(), objnums.end(), rng);
+
+		for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+			int objnum = objnums[i];
+			auto objp = &Objects[objnum];
+
+			objp->type = OBJ_SHIP;
+			objp->instance = i;
+			objp->radius = radius(rng);
+			vm_vec_zero(&objp->phys_info.vel);
+			vm_vec_zero(&objp->phys_info.max_vel);
+			vm_vec_zero(&objp->phys_info.afterburner_max_vel);
+			vm_vec_zero(&objp->phys_info.booster_max_vel);
+
+			start_pos.push_back(vec3d{ { { coord(rng), coord(rng), coord(rng) } } });
+
+			auto shipp = &Ships[i];
+			shipp->objnum = objnum;
+			shipp->ai_index = i;
+			shipp->team = i % 3;
+			shipp->ship_info_index = 0;
+			shipp->wingnum = -1;
+			shipp->tag_left = 0.0f;
+			shipp->level2_tag_left = 0.0f;
+			list_init(&shipp->subsys_list);
+
+			// primitive sensors make what a ship can target depend on how far away it is, without any AWACS
+			sensor_ranges.push_back(sensor_range(rng));
+
+			Test_ship_objs[i].objnum = objnum;
+		}
+
+		old_multithreading = Cmdline_multithreading;
+	}
+
+	void TearDown() override {
+		for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+			list_init(&Ships[i].subsys_list);
+			Ships[i].flags.reset();
+			Objects[Ships[i].objnum].type = OBJ_NONE;
+			Objects[Ships[i].objnum].flags.reset();
+		}
+
+		list_init(&Ship_obj_list);
+		list_init(&obj_used_list);
+		obj_grid_invalidate();
+
+		Iff_info.clear();
+		Ship_types.clear();
+		Ship_info.clear();
+		The_mission.ai_profile = old_ai_profile;
+
+		Cmdline_multithreading = old_multithreading;
+		Ai_threaded_think = true;
+	}
+
+	// Puts the fleet back where it started
+	void reset_fleet() {
+		list_init(&Ship_obj_list);
+		list_init(&obj_used_list);
+
+		for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+			auto shipp = &Ships[i];
+			auto objp = &Objects[shipp->objnum];
+
+			objp->signature = shipp->objnum + 1;
+			objp->pos = start_pos[i];
+			objp->hull_strength = 100.0f;
+			objp->flags.reset();
+			objp->flags.set(Object::Object_Flags::Collides);
+
+			shipp->flags.reset();
+			shipp->flags.set(Ship::Ship_Flags::Primitive_sensors);
+			shipp->primitive_sensor_range = sensor_ranges[i];
+
+			auto aip = &Ai_info[i];
+			aip->shipnum = i;
+			aip->mode = AIM_NONE;
+			aip->target_objnum = -1;
+			aip->target_signature = -1;
+			aip->targeted_subsys = nullptr;
+			aip->enemy_wing = -1;
+			aip->danger_weapon_objnum = -1;
+			aip->ignore_objnum = UNUSED_OBJNUM;
+			for (int j = 0; j < MAX_IGNORE_NEW_OBJECTS; j++) {
+				aip->ignore_new_objnums[j] = UNUSED_OBJNUM;
+			}
+			aip->choose_enemy_timestamp = timestamp(0);
+
+			list_append(&Ship_obj_list, &Test_ship_objs[i]);
+			list_append(&obj_used_list, objp);
+		}
+
+		obj_grid_invalidate();
+	}
+
+	replay_outcome replay(bool threaded) {
+		replay_outcome outcome;
+
+		reset_fleet();
+		SCP_vector<int> kills(NUM_REPLAY_SHIPS, 0);
+
+		Ai_threaded_think = threaded;
+
+		for (int frame = 0; frame < NUM_REPLAY_FRAMES; frame++) {
+			uint sum = 2166136261u;
+
+			Framecount++;
+			obj_grid_invalidate();
+
+			ai_think_all();
+
+			for (auto so : list_range(&Ship_obj_list)) {
+				auto objp = &Objects[so->objnum];
+				if (objp->flags[Object::Object_Flags::Should_be_dead])
+					continue;
+
+				int shipnum = objp->instance;
+				auto aip = &Ai_info[Ships[shipnum].ai_index];
+
+				int target_objnum = find_enemy(so->objnum, MAX_ENEMY_DISTANCE, REPLAY_MAX_ATTACKERS);
+				aip->target_objnum = target_objnum;
+				aip->target_signature = (target_objnum >= 0) ? Objects[target_objnum].signature : -1;
+
+				// look again next frame, like a ship that has just lost its target would
+				aip->choose_enemy_timestamp = timestamp(0);
+
+				sum = checksum(sum, &so->objnum, sizeof(so->objnum));
+				sum = checksum(sum, &target_objnum, sizeof(target_objnum));
+
+				if (target_objnum < 0)
+					continue;
+
+				auto target_objp = &Objects[target_objnum];
+
+				float dist = vm_vec_dist(&objp->pos, &target_objp->pos);
+				if (dist > REPLAY_WEAPON_RANGE) {
+					vec3d dir;
+					vm_vec_normalized_dir(&dir, &target_objp->pos, &objp->pos);
+					vm_vec_scale_add2(&objp->pos, &dir, std::min(REPLAY_SHIP_SPEED, dist - REPLAY_WEAPON_RANGE / 2));
+				} else {
+					target_objp->hull_strength -= 7.0f + (shipnum % 5);
+
+					// what deleting the object would do as far as the AI is concerned
+					if (target_objp->hull_strength <= 0.0f) {
+						target_objp->flags.set(Object::Object_Flags::Should_be_dead);
+						target_objp->signature = -target_objp->signature;
+						kills[shipnum]++;
+					}
+				}
+
+				sum = checksum(sum, &objp->pos, sizeof(objp->pos));
+				sum = checksum(sum, &target_objp->hull_strength, sizeof(target_objp->hull_strength));
+			}
+
+			outcome.frame_checksums.push_back(sum);
+		}
+
+		for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+			auto objp = &Objects[Ships[i].objnum];
+			outcome.ships.push_back(ship_state{ objp->pos, objp->hull_strength, Ai_info[i].target_objnum, kills[i] });
+		}
+
+		return outcome;
+	}
+
+	ai_profile_t profile;
+	ai_profile_t* old_ai_profile = nullptr;
+	SCP_vector<vec3d> start_pos;
+	SCP_vector<int> sensor_ranges;
+	int old_multithreading = 0;
+};
+
+TEST_F(AIThinkReplayTest, threaded_replay_matches_single_threaded) {
+	auto single_threaded = replay(false);
+
+	Cmdline_multithreading = 5;
+	threading::init_task_pool();
+
+	auto multi_threaded = replay(true);
+
+	threading::shut_down_task_pool();
+
+	ASSERT_EQ(single_threaded.frame_checksums.size(), multi_threaded.frame_checksums.size());
+	for (size_t frame = 0; frame < single_threaded.frame_checksums.size(); frame++) {
+		ASSERT_EQ(single_threaded.frame_checksums[frame], multi_threaded.frame_checksums[frame]) << "frame " << frame;
+	}
+
+	int num_targets = 0;
+	int num_alive = 0;
+	int num_kills = 0;
+	for (int i = 0; i < NUM_REPLAY_SHIPS; i++) {
+		auto& a = single_threaded.ships[i];
+		auto& b = multi_threaded.ships[i];
+
+		ASSERT_EQ(a.pos.xyz.x, b.pos.xyz.x) << "ship " << i;
+		ASSERT_EQ(a.pos.xyz.y, b.pos.xyz.y) << "ship " << i;
+		ASSERT_EQ(a.pos.xyz.z, b.pos.xyz.z) << "ship " << i;
+		ASSERT_EQ(a.hull, b.hull) << "ship " << i;
+		ASSERT_EQ(a.target_objnum, b.target_objnum) << "ship " << i;
+		ASSERT_EQ(a.kills, b.kills) << "ship " << i;
+
+		if (a.target_objnum >= 0) {
+			num_targets++;
+		}
+		if (a.hull > 0.0f) {
+			num_alive++;
+		}
+		num_kills += a.kills;
+	}
+
+	// make sure the battle actually went somewhere
+	ASSERT_GT(num_targets, 0);
+	ASSERT_GT(num_kills, NUM_REPLAY_SHIPS / 10);
+	ASSERT_GT(num_alive, 0);
+}
@@ -3,6 +3,10 @@
 #include <graphics/font.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
 #include "util/FSTestFixture.h"
 
 class CFileInitTest : public test::FSTestFixture {
@@ -212,3 +216,196 @@ TEST_F(CFileTest, subfolder_list)
 	ASSERT_EQ(2, cf_get_file_list(table_files, CF_TYPE_TABLES, "*\\*.tbl", CF_SORT_NAME));
 	ASSERT_TRUE(table_files.back().substr(0, 6) == "folder");
 }
+
+class CFileIndexTest : public test::FSTestFixture {
+ public:
+	CFileIndexTest() : CFileIndexTest(NUM_SYNTHETIC_FILES) {
+	}
+
+ protected:
+	static const int NUM_SYNTHETIC_FILES = 2000;
+	static const int NUM_LOOKUPS = 1000;
+
+	explicit CFileIndexTest(int num_files) : test::FSTestFixture(INIT_NONE), _num_files(num_files) {
+		pushModDir("cfile");
+	}
+
+	int _num_files;
+	SCP_string _vp_path;
+
+	static void write_vp_entry(FILE *fp, int offset, int size, const char *name) {
+		char filename[32] = {};
+		int write_time = 0;
+
+		strcpy_s(filename, name);
+
+		fwrite(&offset, sizeof(offset), 1, fp);
+		fwrite(&size, sizeof(size), 1, fp);
+		fwrite(filename, sizeof(filename), 1, fp);
+		fwrite(&write_time, sizeof(write_time), 1, fp);
+	}
+
+	// writes a pack file with _num_files tables in it, all pointing at the same data
+	void write_synthetic_vp() {
+		FILE *fp = fopen(_vp_path.c_str(), "wb");
+		ASSERT_TRUE(fp != nullptr);
+
+		const int data_offset = 16;
+		const int data_size = 4;
+		const int num_entries = _num_files + 4;
+		const int index_offset = data_offset + data_size;
+		const int version = 2;
+
+		fwrite("VPVP", 4, 1, fp);
+		fwrite(&version, sizeof(version), 1, fp);
+		fwrite(&index_offset, sizeof(index_offset), 1, fp);
+		fwrite(&num_entries, sizeof(num_entries), 1, fp);
+		fwrite("#End", data_size, 1, fp);
+
+		write_vp_entry(fp, index_offset, 0, "data");
+		write_vp_entry(fp, index_offset, 0, "tables");
+
+		char name[32];
+		for (int i = 0; i < _num_files; ++i) {
+			sprintf(name, "synthetic_%06d.tbl", i);
+			write_vp_entry(fp, data_offset, data_size, name);
+		}
+
+		write_vp_entry(fp, index_offset, 0, "..");
+		write_vp_entry(fp, index_offset, 0, "..");
+
+		fclose(fp);
+	}
+
+	// mix of hits with varying case, subfolder misses and plain misses; every name with (i % 4) < 2 is a hit
+	SCP_vector<SCP_string> lookup_names() const {
+		SCP_vector<SCP_string> names;
+		char name[32];
+
+		for (int i = 0; i < NUM_LOOKUPS; ++i) {
+			switch (i % 4) {
+			case 0:
+				sprintf(name, "synthetic_%06d.tbl", (i * 7919) % _num_files);
+				break;
+			case 1:
+				sprintf(name, "SYNTHETIC_%06d.TBL", (i * 104729) % _num_files);
+				break;
+			case 2:
+				sprintf(name, "sub/synthetic_%06d.tbl", i);
+				break;
+			default:
+				sprintf(name, "missing_%06d.tbl", i);
+				break;
+			}
+
+			names.emplace_back(name);
+		}
+
+		return names;
+	}
+
+	static double run_lookups(const SCP_vector<SCP_string> &names, SCP_vector<CFileLocation> &results) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (auto &filename : names) {
+			results.push_back(cf_find_file_location(filename.c_str(), CF_TYPE_ANY));
+		}
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		_vp_path = TEST_DATA_PATH;
+		_vp_path += DIR_SEPARATOR_STR "cfile" DIR_SEPARATOR_STR "file_index_lookup" DIR_SEPARATOR_STR "generated.vp";
+
+		write_synthetic_vp();
+
+		SCP_string cfile_dir(TEST_DATA_PATH);
+		cfile_dir += DIR_SEPARATOR_CHAR;
+		cfile_dir += "test"; // Cfile expects something after the path
+
+		ASSERT_FALSE(cfile_init(cfile_dir.c_str()));
+	}
+	void TearDown() override {
+		extern bool Cf_disable_file_index;
+		Cf_disable_file_index = false;
+
+		test::FSTestFixture::TearDown();
+
+		cfile_close();
+
+		remove(_vp_path.c_str());
+	}
+};
+
+// A pack file the size of a large mod
+class CFileIndexBenchmarkTest : public CFileIndexTest {
+ public:
+	CFileIndexBenchmarkTest() : CFileIndexTest(100000) {
+	}
+};
+
+TEST_F(CFileIndexTest, file_index_lookup) {
+	extern bool Cf_disable_file_index;
+
+	auto names = lookup_names();
+
+	ASSERT_TRUE(cf_find_file_location("real.tbl", CF_TYPE_ANY).found);
+
+	SCP_vector<CFileLocation> linear_results, indexed_results;
+
+	Cf_disable_file_index = true;
+	run_lookups(names, linear_results);
+
+	Cf_disable_file_index = false;
+	run_lookups(names, indexed_results);
+
+	ASSERT_EQ(linear_results.size(), indexed_results.size());
+
+	for (size_t i = 0; i < names.size(); ++i) {
+		ASSERT_EQ(linear_results[i].found, indexed_results[i].found) << names[i];
+		ASSERT_EQ(linear_results[i].found, (i % 4) < 2) << names[i];
+
+		if (indexed_results[i].found) {
+			ASSERT_EQ(linear_results[i].name_ext, indexed_results[i].name_ext);
+			ASSERT_EQ(linear_results[i].full_name, indexed_results[i].full_name);
+			ASSERT_EQ(linear_results[i].offset, indexed_results[i].offset);
+		}
+	}
+
+	// the extension search should agree as well
+	const char *exts[] = { ".tbm", ".tbl" };
+
+	Cf_disable_file_index = true;
+	auto linear_ext = cf_find_file_location_ext("synthetic_001234", 2, exts, CF_TYPE_ANY);
+
+	Cf_disable_file_index = false;
+	auto indexed_ext = cf_find_file_location_ext("synthetic_001234", 2, exts, CF_TYPE_ANY);
+
+	ASSERT_TRUE(linear_ext.found);
+	ASSERT_TRUE(indexed_ext.found);
+	ASSERT_EQ(linear_ext.extension_index, indexed_ext.extension_index);
+	ASSERT_EQ(linear_ext.name_ext, indexed_ext.name_ext);
+}
+
+TEST_F(CFileIndexBenchmarkTest, DISABLED_file_index_lookup_benchmark) {
+	extern bool Cf_disable_file_index;
+
+	auto names = lookup_names();
+
+	SCP_vector<CFileLocation> linear_results, indexed_results;
+
+	Cf_disable_file_index = true;
+	auto linear_time = run_lookups(names, linear_results);
+
+	Cf_disable_file_index = false;
+	auto indexed_time = run_lookups(names, indexed_results);
+
+	ASSERT_EQ(linear_results.size(), indexed_results.size());
+
+	std::cout << "cf_find_file_location() over " << _num_files << " files: "
+		<< names.size() / linear_time << " lookups/sec linear, "
+		<< names.size() / indexed_time << " lookups/sec indexed" << std::endl;
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "lighting/lighting.h"
+#include "math/vecmat.h"
+
+#include <random>
+
+namespace {
+
+// Lights spread over a battle the size of a large mission, most of them small weapon lights with a few explosions
+// and beams mixed in, so that the grid has unbinned lights to deal with as well
+const int NUM_LIGHTS = 2000;
+const int NUM_SPHERES = 500;
+const float BATTLE_SIZE = 20000.0f;
+
+light make_light(std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> coord(-BATTLE_SIZE / 2, BATTLE_SIZE / 2);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	light l = {};
+	l.vec = vec3d{ { { coord(rng), coord(rng), coord(rng) } } };
+	l.intensity = 1.0f;
+	l.r = l.g = l.b = 1.0f;
+	l.sun_index = -1;
+
+	float kind = unit(rng);
+	if (kind < 0.05f) {
+		l.type = Light_Type::Tube;
+		vm_vec_scale_add(&l.vec2, &l.vec, &vmd_z_vector, 3000.0f * unit(rng) + 100.0f);
+		l.radb = 50.0f + 100.0f * unit(rng);
+	} else if (kind < 0.15f) {
+		l.type = Light_Type::Point;
+		l.radb = 400.0f + 1200.0f * unit(rng);
+	} else if (kind < 0.16f) {
+		l.type = Light_Type::Directional;
+	} else {
+		l.type = Light_Type::Point;
+		l.radb = 20.0f + 200.0f * unit(rng);
+	}
+
+	l.rada = l.radb / 2;
+	l.rada_squared = l.rada * l.rada;
+	l.radb_squared = l.radb * l.radb;
+
+	return l;
+}
+
+}
+
+TEST(LightingTests, light_grid_filters_like_testing_every_light)
+{
+	std::mt19937 rng(4321);
+	std::uniform_real_distribution<float> coord(-BATTLE_SIZE / 2, BATTLE_SIZE / 2);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	scene_lights lights;
+	for (int i = 0; i < NUM_LIGHTS; i++) {
+		auto l = make_light(rng);
+		lights.addLight(&l);
+	}
+
+	auto old_enabled = Light_grid_enabled;
+	size_t total_filtered = 0;
+
+	for (int i = 0; i < NUM_SPHERES; i++) {
+		vec3d pos{ { { coord(rng), coord(rng), coord(rng) } } };
+		// fighters mostly, with the odd capital ship
+		float rad = (i % 10 == 0) ? 500.0f + 2000.0f * unit(rng) : 10.0f + 40.0f * unit(rng);
+
+		Light_grid_enabled = false;
+		lights.setLightFilter(&pos, rad);
+		auto expected = lights.getFilteredLights();
+
+		Light_grid_enabled = true;
+		lights.setLightFilter(&pos, rad);
+
+		ASSERT_EQ(expected, lights.getFilteredLights()) << "sphere " << i;
+		total_filtered += expected.size();
+	}
+
+	Light_grid_enabled = old_enabled;
+
+	// make sure the spheres actually met some lights
+	ASSERT_GT(total_filtered, (size_t)NUM_SPHERES / 2);
+}
+
+TEST(LightingTests, identical_light_sets_are_buffered_once)
+{
+	std::mt19937 rng(1234);
+
+	scene_lights lights;
+	for (int i = 0; i < 100; i++) {
+		auto l = make_light(rng);
+		l.type = Light_Type::Point;
+		l.vec = vec3d{ { { 10.0f * i, 0.0f, 0.0f } } };
+		l.radb = 50.0f;
+		lights.addLight(&l);
+	}
+
+	vec3d pos_a{ { { 0.0f, 0.0f, 0.0f } } };
+	vec3d pos_b{ { { 500.0f, 0.0f, 0.0f } } };
+
+	lights.setLightFilter(&pos_a, 10.0f);
+	auto first = lights.bufferLights();
+	ASSERT_GT(first.num_lights, (size_t)0);
+
+	lights.setLightFilter(&pos_b, 10.0f);
+	auto second = lights.bufferLights();
+	ASSERT_GT(second.num_lights, (size_t)0);
+	ASSERT_NE(first.index_start, second.index_start);
+
+	// back to the first set, which is already buffered
+	lights.setLightFilter(&pos_a, 10.0f);
+	auto third = lights.bufferLights();
+	ASSERT_EQ(first.index_start, third.index_start);
+	ASSERT_EQ(first.num_lights, third.num_lights);
+}
@@ -6,6 +6,8 @@
 
 #include "util/FSTestFixture.h"
 
+#include <chrono>
+
 using Random = util::Random;
 
 // "Correct" answers for matrix functions provided by Wolfram Mathematica 11
@@ -17,6 +19,10 @@ const matrix input2 = {{{{{{0.7703f, 0.8180f, 0.8535f}}}, {{{0.6409f, 0.0125f, 0
 const matrix input3 = {{{{{{0.5118f, 27.86f, 1.0f}}}, {{{0.0f, 777.2f, 0.0596f}}}, {{{2.5f, 67.95f, 0.0058f}}}}}};
 
 #define EXPECT_MATRIX_NEAR(out,matrix) EXPECT_NEAR(error(&out,matrix), 0.0f, 0.001f);
+#define ASSERT_VEC_NEAR(expected,actual,tolerance) \
+	ASSERT_NEAR((expected).xyz.x, (actual).xyz.x, tolerance); \
+	ASSERT_NEAR((expected).xyz.y, (actual).xyz.y, tolerance); \
+	ASSERT_NEAR((expected).xyz.z, (actual).xyz.z, tolerance);
 
 matrix make_matrix(float a, float b, float c, float d, float e, float f, float g, float h, float i) {
 	matrix out = { {{{{{a, b, c}}}, {{{d, e, f}}}, {{{g, h, i}}}}} };
@@ -719,3 +725,144 @@ TEST_F(VecmatTest, orthogonalize_matrix) {
 	}
 }
 
+
+TEST_F(VecmatTest, test_vm_vec_rotate_unrotate) {
+	for (int i = 0; i < 1000; i++) {
+		angles a = { frand_range(-PI, PI), frand_range(-PI, PI), frand_range(-PI, PI) };
+		matrix m, mt;
+		vm_angles_2_matrix(&m, &a);
+		vm_copy_transpose(&mt, &m);
+
+		vec3d v;
+		vm_vec_make(&v, frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f));
+
+		vec3d rotated, unrotated, rotated_by_transpose;
+		vm_vec_rotate(&rotated, &v, &m);
+		vm_vec_unrotate(&unrotated, &rotated, &m);
+		vm_vec_rotate(&rotated_by_transpose, &rotated, &mt);
+
+		// unrotating is rotating by the transpose; the compiler may fuse the multiplies and adds differently in each
+		ASSERT_VEC_NEAR(rotated_by_transpose, unrotated, 0.001f);
+		ASSERT_VEC_NEAR(v, unrotated, 0.01f);
+
+		// the destination may be the source
+		vec3d in_place = v;
+		vm_vec_rotate(&in_place, &in_place, &m);
+		ASSERT_VEC_NEAR(rotated, in_place, 0.001f);
+
+		vm_vec_unrotate(&in_place, &in_place, &m);
+		ASSERT_VEC_NEAR(unrotated, in_place, 0.001f);
+	}
+}
+
+TEST_F(VecmatTest, test_batch_transforms) {
+	const size_t NUM_POINTS = 257;	// odd, so the vectorised loops have a remainder to deal with
+
+	angles a = { frand_range(-PI, PI), frand_range(-PI, PI), frand_range(-PI, PI) };
+	matrix m;
+	vm_angles_2_matrix(&m, &a);
+
+	vec3d offset;
+	vm_vec_make(&offset, frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f));
+
+	SCP_vector<vec3d> points(NUM_POINTS);
+	for (auto& point : points) {
+		vm_vec_make(&point, frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f));
+	}
+
+	auto expect_same = [&](const SCP_vector<vec3d>& batch, auto&& single) {
+		for (size_t i = 0; i < NUM_POINTS; i++) {
+			vec3d expected;
+			single(&expected, &points[i]);
+
+			SCOPED_TRACE("point " + std::to_string(i));
+			ASSERT_VEC_NEAR(expected, batch[i], 0.01f);
+		}
+	};
+
+	SCP_vector<vec3d> batch(NUM_POINTS);
+
+	vm_vec_unrotate_n(batch.data(), points.data(), NUM_POINTS, &m);
+	expect_same(batch, [&](vec3d* dest, const vec3d* src) { vm_vec_unrotate(dest, src, &m); });
+
+	auto unrotate_add = [&](vec3d* dest, const vec3d* src) {
+		vm_vec_unrotate(dest, src, &m);
+		vm_vec_add2(dest, &offset);
+	};
+
+	// in place
+	batch = points;
+	vm_vec_unrotate_n(batch.data(), batch.data(), NUM_POINTS, &m, &offset);
+	expect_same(batch, unrotate_add);
+
+}
+
+TEST_F(VecmatTest, DISABLED_throughput) {
+	const int NUM_ITEMS = 4096;
+	const int NUM_PASSES = 500;
+
+	SCP_vector<matrix> matrices(NUM_ITEMS);
+	SCP_vector<vec3d> vecs(NUM_ITEMS);
+	SCP_vector<vec3d> vec_results(NUM_ITEMS);
+	SCP_vector<matrix> matrix_results(NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		angles a = { frand_range(-PI, PI), frand_range(-PI, PI), frand_range(-PI, PI) };
+		vm_angles_2_matrix(&matrices[i], &a);
+		vm_vec_make(&vecs[i], frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f), frand_range(-1000.0f, 1000.0f));
+	}
+
+	auto measure = [&](const char* name, auto&& op) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int pass = 0; pass < NUM_PASSES; pass++) {
+			for (int i = 0; i < NUM_ITEMS; i++) {
+				op(i);
+			}
+		}
+
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << name << ": " << (static_cast<double>(NUM_ITEMS) * NUM_PASSES) / seconds << " ops/sec" << std::endl;
+	};
+
+	measure("vm_vec_rotate", [&](int i) { vm_vec_rotate(&vec_results[i], &vecs[i], &matrices[i]); });
+	measure("vm_vec_unrotate", [&](int i) { vm_vec_unrotate(&vec_results[i], &vecs[i], &matrices[i]); });
+	measure("vm_matrix_x_matrix", [&](int i) { vm_matrix_x_matrix(&matrix_results[i], &matrices[i], &matrices[(i + 1) % NUM_ITEMS]); });
+	measure("vm_vec_scale_add", [&](int i) { vm_vec_scale_add(&vec_results[i], &vec_results[i], &vecs[i], 0.5f); });
+	measure("vm_vec_dist_squared", [&](int i) { vec_results[i].xyz.x = vm_vec_dist_squared(&vecs[i], &vecs[(i + 1) % NUM_ITEMS]); });
+
+	// the batch forms, on points that all go through the same matrix the way the vertices of a model do
+	auto measure_batch = [&](const char* name, auto&& op) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int pass = 0; pass < NUM_PASSES; pass++) {
+			op();
+		}
+
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << name << ": " << (static_cast<double>(NUM_ITEMS) * NUM_PASSES) / seconds << " points/sec" << std::endl;
+	};
+
+	const matrix& m = matrices[0];
+	const vec3d& offset = vecs[0];
+
+	measure_batch("vm_vec_unrotate + vm_vec_add2 per point", [&]() {
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			vm_vec_unrotate(&vec_results[i], &vecs[i], &m);
+			vm_vec_add2(&vec_results[i], &offset);
+		}
+	});
+	measure_batch("vm_vec_unrotate_n", [&]() { vm_vec_unrotate_n(vec_results.data(), vecs.data(), NUM_ITEMS, &m, &offset); });
+
+	// rotations preserve lengths, which also keeps the work above from being thrown away
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		matrix identity;
+		matrix mt;
+		vm_copy_transpose(&mt, &matrices[i]);
+		vm_matrix_x_matrix(&identity, &mt, &matrices[i]);
+		EXPECT_MATRIX_NEAR(identity, vmd_identity_matrix);
+
+		vm_vec_rotate(&vec_results[i], &vecs[i], &matrices[i]);
+		EXPECT_NEAR(vm_vec_mag(&vecs[i]), vm_vec_mag(&vec_results[i]), 0.01f);
+	}
+}
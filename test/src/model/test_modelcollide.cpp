@@ -0,0 +1,483 @@
+#include <gtest/gtest.h>
+
+#define MODEL_LIB
+
+#include <model/model.h>
+#include <model/modelsinc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+namespace {
+
+// Untextured triangles of a bumpy sphere, which is roughly what the hull of a big ship looks like to a ray
+const int SPHERE_RINGS = 96;
+const int SPHERE_SEGMENTS = 192;
+const float SPHERE_RADIUS = 100.0f;
+
+const int CHECK_RAYS = 20000;
+const int BENCHMARK_RAYS = 1000000;
+
+struct test_poly {
+	int verts[3];
+	vec3d norm;
+	vec3d center;
+};
+
+void put_int(SCP_vector<ubyte>& data, size_t offset, int value)
+{
+	memcpy(&data[offset], &value, sizeof(value));
+}
+
+void put_vec(SCP_vector<ubyte>& data, size_t offset, const vec3d& value)
+{
+	memcpy(&data[offset], &value, sizeof(value));
+}
+
+size_t add_chunk(SCP_vector<ubyte>& data, int type, size_t size)
+{
+	size_t offset = data.size();
+	data.resize(offset + size, 0);
+	put_int(data, offset, type);
+	put_int(data, offset + 4, (int)size);
+	return offset;
+}
+
+void get_bounds(const SCP_vector<vec3d>& points, const SCP_vector<test_poly>& polys, size_t begin, size_t end, vec3d* min, vec3d* max)
+{
+	*min = points[polys[begin].verts[0]];
+	*max = *min;
+
+	for (size_t i = begin; i < end; ++i) {
+		for (int vert : polys[i].verts) {
+			for (int k = 0; k < 3; ++k) {
+				min->a1d[k] = MIN(min->a1d[k], points[vert].a1d[k]);
+				max->a1d[k] = MAX(max->a1d[k], points[vert].a1d[k]);
+			}
+		}
+	}
+}
+
+// Writes a BSP in the same chunk format the POF files use, splitting the polygons at the median of the longest axis
+void write_bsp_node(SCP_vector<ubyte>& data, const SCP_vector<vec3d>& points, SCP_vector<test_poly>& polys, size_t begin, size_t end)
+{
+	vec3d min, max;
+	get_bounds(points, polys, begin, end, &min, &max);
+
+	if (end - begin <= 6) {
+		size_t box = add_chunk(data, OP_BOUNDBOX, 32);
+		put_vec(data, box + 8, min);
+		put_vec(data, box + 20, max);
+
+		for (size_t i = begin; i < end; ++i) {
+			size_t poly = add_chunk(data, OP_FLATPOLY, 44 + 3 * 4);
+			put_vec(data, poly + 8, polys[i].norm);
+			put_vec(data, poly + 20, polys[i].center);
+			put_int(data, poly + 36, 3);
+
+			for (int j = 0; j < 3; ++j) {
+				short vert[2] = { (short)polys[i].verts[j], 0 };
+				memcpy(&data[poly + 44 + j * 4], vert, sizeof(vert));
+			}
+		}
+
+		add_chunk(data, OP_EOF, 8);
+		return;
+	}
+
+	int axis = 0;
+	for (int k = 1; k < 3; ++k) {
+		if (max.a1d[k] - min.a1d[k] > max.a1d[axis] - min.a1d[axis]) {
+			axis = k;
+		}
+	}
+
+	size_t mid = (begin + end) / 2;
+	std::nth_element(polys.begin() + begin, polys.begin() + mid, polys.begin() + end,
+		[axis](const test_poly& a, const test_poly& b) { return a.center.a1d[axis] < b.center.a1d[axis]; });
+
+	size_t node = add_chunk(data, OP_SORTNORM2, 40);
+	put_vec(data, node + 16, min);
+	put_vec(data, node + 28, max);
+
+	put_int(data, node + 12, (int)(data.size() - node));
+	write_bsp_node(data, points, polys, begin, mid);
+
+	put_int(data, node + 8, (int)(data.size() - node));
+	write_bsp_node(data, points, polys, mid, end);
+}
+
+SCP_vector<ubyte> make_test_bsp()
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> bump(0.97f, 1.03f);
+
+	SCP_vector<vec3d> points;
+	for (int ring = 0; ring <= SPHERE_RINGS; ++ring) {
+		float pitch = PI * ring / SPHERE_RINGS;
+
+		for (int seg = 0; seg < SPHERE_SEGMENTS; ++seg) {
+			float heading = PI2 * seg / SPHERE_SEGMENTS;
+			float radius = SPHERE_RADIUS * bump(rng);
+
+			points.push_back(vec3d{ { { radius * sinf(pitch) * cosf(heading), radius * cosf(pitch), radius * sinf(pitch) * sinf(heading) } } });
+		}
+	}
+
+	SCP_vector<test_poly> polys;
+	for (int ring = 0; ring < SPHERE_RINGS; ++ring) {
+		for (int seg = 0; seg < SPHERE_SEGMENTS; ++seg) {
+			int next = (seg + 1) % SPHERE_SEGMENTS;
+
+			int quad[4] = { ring * SPHERE_SEGMENTS + seg, ring * SPHERE_SEGMENTS + next,
+				(ring + 1) * SPHERE_SEGMENTS + next, (ring + 1) * SPHERE_SEGMENTS + seg };
+
+			for (int half = 0; half < 2; ++half) {
+				test_poly poly;
+				poly.verts[0] = quad[0];
+				poly.verts[1] = quad[1 + half];
+				poly.verts[2] = quad[2 + half];
+
+				// the triangles at the poles collapse to a line
+				vm_vec_perp(&poly.norm, &points[poly.verts[0]], &points[poly.verts[1]], &points[poly.verts[2]]);
+				if (vm_vec_mag_squared(&poly.norm) <= 0.0f) {
+					continue;
+				}
+				vm_vec_normalize(&poly.norm);
+
+				poly.center = (points[poly.verts[0]] + points[poly.verts[1]] + points[poly.verts[2]]) / 3.0f;
+
+				// face outwards, like a hull would
+				if (vm_vec_dot(&poly.norm, &poly.center) < 0.0f) {
+					std::swap(poly.verts[1], poly.verts[2]);
+					vm_vec_negate(&poly.norm);
+				}
+
+				polys.push_back(poly);
+			}
+		}
+	}
+
+	SCP_vector<ubyte> data;
+
+	size_t defpoints = add_chunk(data, OP_DEFPOINTS, 20 + points.size() + points.size() * sizeof(vec3d));
+	put_int(data, defpoints + 8, (int)points.size());
+	put_int(data, defpoints + 16, (int)(20 + points.size()));
+	memcpy(&data[defpoints + 20 + points.size()], points.data(), points.size() * sizeof(vec3d));
+
+	write_bsp_node(data, points, polys, 0, polys.size());
+
+	// the parser looks at the chunk after the last one
+	add_chunk(data, OP_EOF, 8);
+
+	return data;
+}
+
+// Returns the time it took, the hit distance of every ray or -1 if it missed goes to hit_dists
+double fire_rays(bsp_collision_tree* tree, const SCP_vector<vec3d>& starts, const SCP_vector<vec3d>& ends, bool flat_layout, SCP_vector<float>& hit_dists)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < starts.size(); ++i) {
+		mc_info mc;
+		mc.p0 = &starts[i];
+		mc.p1 = &ends[i];
+		mc.flags = MC_CHECK_MODEL;
+
+		hit_dists.push_back(model_collide_tree(tree, &mc, flat_layout) ? mc.hit_dist : -1.0f);
+	}
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The parts of a POF subobject header the benchmark needs
+struct pof_submodel {
+	SCP_string name;
+	float radius;
+	vec3d center;
+	vec3d min;
+	vec3d max;
+	SCP_vector<ubyte> bsp_data;
+};
+
+// Reads the subobjects of a POF, only the versions that store the BSP data aligned (2200 and later) are supported
+bool read_pof_submodels(const char* filename, int* version, SCP_vector<pof_submodel>& submodels)
+{
+	std::ifstream file(filename, std::ios::binary);
+	SCP_vector<ubyte> pof((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	size_t pos = 0;
+	auto read = [&](void* out, size_t size) {
+		if (pos + size > pof.size()) {
+			return false;
+		}
+		memcpy(out, &pof[pos], size);
+		pos += size;
+		return true;
+	};
+	auto read_int = [&]() {
+		int value = 0;
+		read(&value, sizeof(value));
+		return value;
+	};
+	auto read_string = [&]() {
+		int len = read_int();
+		SCP_string value;
+		if (len > 0 && pos + len <= pof.size()) {
+			value.assign(reinterpret_cast<const char*>(&pof[pos]), len);
+			pos += len;
+		}
+		return value;
+	};
+
+	if (read_int() != POF_HEADER_ID) {
+		return false;
+	}
+	*version = read_int();
+	if (*version < 2200) {
+		return false;
+	}
+
+	while (pos + 8 <= pof.size()) {
+		int id = read_int();
+		int len = read_int();
+		size_t next = pos + len;
+
+		if (id == ID_OBJ2) {
+			pof_submodel sm;
+
+			read_int();		// number
+			read(&sm.radius, sizeof(float));
+			read_int();		// parent
+			pos += sizeof(vec3d);	// offset
+			read(&sm.center, sizeof(vec3d));
+			read(&sm.min, sizeof(vec3d));
+			read(&sm.max, sizeof(vec3d));
+			sm.name = read_string();
+			read_string();	// properties
+			pos += 2 * sizeof(int);	// rotation type and axis
+			if (*version >= 2301) {
+				pos += 2 * sizeof(int);	// translation type and axis
+			}
+			read_int();		// chunks
+
+			int bsp_size = read_int();
+			if (bsp_size > 0 && pos + bsp_size <= pof.size()) {
+				sm.bsp_data.assign(pof.begin() + pos, pof.begin() + pos + bsp_size);
+			}
+
+			submodels.push_back(std::move(sm));
+		}
+
+		pos = next;
+	}
+
+	return !submodels.empty();
+}
+
+}
+
+class BspCollisionTest : public ::testing::Test {
+  protected:
+	void SetUp() override {
+		bsp_data = make_test_bsp();
+
+		tree = bsp_collision_tree{};
+
+		Macro_ubyte_bounds = bsp_data.data() + bsp_data.size();
+		model_collide_parse_bsp(&tree, bsp_data.data(), 2117);
+		Macro_ubyte_bounds = nullptr;
+	}
+
+	void TearDown() override {
+		vm_free(tree.node_list);
+		vm_free(tree.leaf_list);
+		vm_free(tree.point_list);
+		vm_free(tree.vert_list);
+		vm_free(tree.tri_blocks);
+	}
+
+	// Rays from well outside the sphere to a point inside of it
+	static void make_rays(int count, SCP_vector<vec3d>& starts, SCP_vector<vec3d>& ends) {
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		auto random_point = [&](float scale) {
+			vec3d p{ { { dist(rng), dist(rng), dist(rng) } } };
+			vm_vec_normalize_safe(&p);
+			return p * scale;
+		};
+
+		for (int i = 0; i < count; ++i) {
+			starts.push_back(random_point(SPHERE_RADIUS * 3.0f));
+			ends.push_back(random_point(SPHERE_RADIUS * 0.5f));
+		}
+	}
+
+	double fire_rays(const SCP_vector<vec3d>& starts, const SCP_vector<vec3d>& ends, bool flat_layout, SCP_vector<float>& hit_dists) {
+		return ::fire_rays(&tree, starts, ends, flat_layout, hit_dists);
+	}
+
+	SCP_vector<ubyte> bsp_data;
+	bsp_collision_tree tree;
+};
+
+TEST_F(BspCollisionTest, flat_layout_matches_node_list) {
+	ASSERT_GT(tree.n_nodes, 0);
+	ASSERT_FALSE(tree.flat_nodes.empty());
+	ASSERT_EQ((uintptr_t)0, reinterpret_cast<uintptr_t>(tree.flat_nodes.data()) % 32);
+
+	SCP_vector<vec3d> starts, ends;
+	make_rays(CHECK_RAYS, starts, ends);
+
+	SCP_vector<float> old_hits, flat_hits;
+	fire_rays(starts, ends, false, old_hits);
+	fire_rays(starts, ends, true, flat_hits);
+
+	int num_hits = 0;
+	for (int i = 0; i < CHECK_RAYS; ++i) {
+		ASSERT_EQ(old_hits[i], flat_hits[i]) << "ray " << i;
+
+		if (flat_hits[i] >= 0.0f) {
+			++num_hits;
+		}
+	}
+
+	// every ray ends inside the sphere, only the odd one can slip through between two triangles
+	ASSERT_GT(num_hits, CHECK_RAYS * 99 / 100);
+}
+
+// Not a correctness test, run it with --gtest_also_run_disabled_tests to compare the speed of the two layouts
+TEST_F(BspCollisionTest, DISABLED_flat_layout_benchmark) {
+	SCP_vector<vec3d> starts, ends;
+	make_rays(BENCHMARK_RAYS, starts, ends);
+
+	SCP_vector<float> old_hits, flat_hits;
+	auto old_time = fire_rays(starts, ends, false, old_hits);
+	auto flat_time = fire_rays(starts, ends, true, flat_hits);
+
+	std::cout << BENCHMARK_RAYS << " rays against " << tree.n_leaves << " polygons: "
+		<< BENCHMARK_RAYS / old_time << " rays/sec with node_list, "
+		<< BENCHMARK_RAYS / flat_time << " rays/sec with flat_nodes" << std::endl;
+}
+
+TEST_F(BspCollisionTest, batch_checks_match_exact_checks) {
+	ASSERT_NE(nullptr, tree.tri_blocks);
+
+	std::mt19937 rng(2);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> radius_dist(0.5f, 10.0f);
+
+	auto random_point = [&](float scale) {
+		vec3d p{ { { dist(rng), dist(rng), dist(rng) } } };
+		vm_vec_normalize_safe(&p);
+		return p * scale;
+	};
+
+	const int NUM_CHECKS = 5000;
+
+	// segments that end inside the hull, segments that stop short of it, infinite rays and swept spheres
+	const int check_flags[] = { MC_CHECK_MODEL, MC_CHECK_MODEL, MC_CHECK_MODEL | MC_CHECK_RAY, MC_CHECK_MODEL | MC_CHECK_SPHERELINE };
+	const float end_scale[] = { 0.5f, 1.2f, 0.5f, 0.5f };
+
+	for (int type = 0; type < (int)(sizeof(check_flags) / sizeof(check_flags[0])); ++type) {
+		int num_hits = 0;
+
+		for (int i = 0; i < NUM_CHECKS; ++i) {
+			vec3d p0 = random_point(SPHERE_RADIUS * 3.0f);
+			vec3d p1 = random_point(SPHERE_RADIUS * end_scale[type]);
+			float radius = radius_dist(rng);
+
+			mc_info results[2];
+			for (int batch = 0; batch < 2; ++batch) {
+				Model_collide_batch_tris = (batch != 0);
+
+				results[batch].p0 = &p0;
+				results[batch].p1 = &p1;
+				results[batch].flags = check_flags[type];
+				results[batch].radius = radius;
+
+				model_collide_tree(&tree, &results[batch], true);
+			}
+			Model_collide_batch_tris = true;
+
+			ASSERT_EQ(results[0].num_hits, results[1].num_hits) << "check " << i << " of type " << type;
+
+			if (results[0].num_hits > 0) {
+				ASSERT_EQ(results[0].hit_dist, results[1].hit_dist) << "check " << i << " of type " << type;
+				ASSERT_EQ(results[0].hit_point, results[1].hit_point) << "check " << i << " of type " << type;
+				ASSERT_EQ(results[0].edge_hit, results[1].edge_hit) << "check " << i << " of type " << type;
+
+				++num_hits;
+			}
+		}
+
+		// make sure the checks actually hit something, or the comparison above doesn't say much
+		if (end_scale[type] < 1.0f) {
+			ASSERT_GT(num_hits, NUM_CHECKS / 2) << "type " << type;
+		}
+	}
+}
+
+// Not a correctness test, the same comparison as above against the biggest subobject of a real model. Point
+// FSO_BENCHMARK_POF at a POF file and run it with --gtest_also_run_disabled_tests.
+TEST(BspCollisionPofTest, DISABLED_flat_layout_benchmark) {
+	auto filename = getenv("FSO_BENCHMARK_POF");
+	if (filename == nullptr) {
+		GTEST_SKIP() << "FSO_BENCHMARK_POF is not set";
+	}
+
+	int version = 0;
+	SCP_vector<pof_submodel> submodels;
+	ASSERT_TRUE(read_pof_submodels(filename, &version, submodels)) << filename << " is not a POF of version 2200 or later";
+
+	auto sm = std::max_element(submodels.begin(), submodels.end(),
+		[](const pof_submodel& a, const pof_submodel& b) { return a.bsp_data.size() < b.bsp_data.size(); });
+	ASSERT_FALSE(sm->bsp_data.empty());
+
+	bsp_collision_tree tree{};
+	Macro_ubyte_bounds = sm->bsp_data.data() + sm->bsp_data.size();
+	model_collide_parse_bsp(&tree, sm->bsp_data.data(), version);
+	Macro_ubyte_bounds = nullptr;
+
+	// rays from around the subobject to points in its bounding box
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> box(0.0f, 1.0f);
+
+	SCP_vector<vec3d> starts, ends;
+	for (int i = 0; i < BENCHMARK_RAYS; ++i) {
+		vec3d dir{ { { dist(rng), dist(rng), dist(rng) } } };
+		vm_vec_normalize_safe(&dir);
+		starts.push_back(sm->center + dir * (sm->radius * 3.0f));
+
+		vec3d end;
+		for (int k = 0; k < 3; ++k) {
+			end.a1d[k] = sm->min.a1d[k] + (sm->max.a1d[k] - sm->min.a1d[k]) * box(rng);
+		}
+		ends.push_back(end);
+	}
+
+	SCP_vector<float> old_hits, flat_hits;
+	auto old_time = fire_rays(&tree, starts, ends, false, old_hits);
+	auto flat_time = fire_rays(&tree, starts, ends, true, flat_hits);
+
+	int num_hits = (int)std::count_if(flat_hits.begin(), flat_hits.end(), [](float dist) { return dist >= 0.0f; });
+
+	std::cout << BENCHMARK_RAYS << " rays against " << tree.n_leaves << " polygons of " << sm->name << " (" << num_hits << " hits): "
+		<< BENCHMARK_RAYS / old_time << " rays/sec with node_list, "
+		<< BENCHMARK_RAYS / flat_time << " rays/sec with flat_nodes" << std::endl;
+
+	EXPECT_EQ(old_hits, flat_hits);
+
+	vm_free(tree.node_list);
+	vm_free(tree.leaf_list);
+	vm_free(tree.point_list);
+	vm_free(tree.vert_list);
+	vm_free(tree.tri_blocks);
+}
@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include "globalincs/linklist.h"
+#include "iff_defs/iff_defs.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+#include "ship/ship.h"
+#include "weapon/weapon.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+const int NUM_TEST_SHIPS = MAX_SHIPS;
+const int NUM_TEST_QUERIES = 2000;
+const float TEST_SPACE_SIZE = 20000.0f;
+
+// A big asteroid field battle: lots of shockwaves going off among lots of objects each frame
+const int NUM_BLAST_OBJECTS = 4000;
+const int NUM_BLAST_SHOCKWAVES = 100;
+const int NUM_BLAST_FRAMES = 50;
+const int NUM_BLAST_CHECK_FRAMES = 5;
+
+ship_obj Test_ship_objs[NUM_TEST_SHIPS];
+
+}
+
+class ObjectGridTest : public ::testing::Test {
+  protected:
+	void SetUp() override {
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<float> coord(-TEST_SPACE_SIZE / 2, TEST_SPACE_SIZE / 2);
+		std::uniform_real_distribution<float> radius(5.0f, 100.0f);
+		std::uniform_int_distribution<int> team(0, 3);
+
+		// the list order shouldn't have anything to do with the object numbers
+		SCP_vector<int> objnums;
+		for (int i = 0; i < NUM_TEST_SHIPS * 2; i++) {
+			objnums.push_back(i);
+		}
+		std::shuffle(objnums.begin(), objnums.end(), rng);
+
+		list_init(&Ship_obj_list);
+		list_init(&Missile_obj_list);
+
+		for (int i = 0; i < NUM_TEST_SHIPS; i++) {
+			int objnum = objnums[i];
+			auto objp = &Objects[objnum];
+
+			objp->pos = vec3d{ { { coord(rng), coord(rng), coord(rng) } } };
+			objp->radius = radius(rng);
+			objp->instance = i;
+			vm_vec_zero(&objp->phys_info.vel);
+			vm_vec_zero(&objp->phys_info.max_vel);
+			vm_vec_zero(&objp->phys_info.afterburner_max_vel);
+			vm_vec_zero(&objp->phys_info.booster_max_vel);
+
+			// a few capital ships, which are too big for a grid cell
+			if (i % 50 == 0) {
+				objp->radius = 2000.0f;
+			}
+
+			Ships[i].team = team(rng);
+
+			Test_ship_objs[i].objnum = objnum;
+			list_append(&Ship_obj_list, &Test_ship_objs[i]);
+		}
+
+		obj_grid_invalidate();
+	}
+
+	void TearDown() override {
+		list_init(&Ship_obj_list);
+		list_init(&obj_used_list);
+		obj_grid_invalidate();
+	}
+
+	// Fills obj_used_list with the test ships, some debris which a shockwave doesn't push around, and the
+	// asteroids of the field, then sets off num_blasts shockwaves where the objects are
+	static void make_blast_field(int num_blasts, SCP_vector<vec3d>& blast_pos, SCP_vector<float>& blast_radius) {
+		std::mt19937 rng(13);
+		std::uniform_real_distribution<float> coord(-TEST_SPACE_SIZE / 2, TEST_SPACE_SIZE / 2);
+		std::uniform_real_distribution<float> radius(5.0f, 50.0f);
+		std::uniform_real_distribution<float> range(50.0f, 600.0f);
+
+		for (int i = 0; i < NUM_TEST_SHIPS; i++) {
+			Objects[Test_ship_objs[i].objnum].type = OBJ_SHIP;
+		}
+
+		SCP_vector<int> objnums;
+		for (int i = 0; i < NUM_BLAST_OBJECTS; i++) {
+			auto objp = &Objects[i];
+
+			if (objp->type != OBJ_SHIP) {
+				objp->type = (i < NUM_TEST_SHIPS * 2) ? OBJ_DEBRIS : OBJ_ASTEROID;
+				objp->pos = vec3d{ { { coord(rng), coord(rng), coord(rng) } } };
+				objp->radius = radius(rng);
+				vm_vec_zero(&objp->phys_info.vel);
+				vm_vec_zero(&objp->phys_info.max_vel);
+				vm_vec_zero(&objp->phys_info.afterburner_max_vel);
+				vm_vec_zero(&objp->phys_info.booster_max_vel);
+			}
+
+			objnums.push_back(i);
+		}
+		std::shuffle(objnums.begin(), objnums.end(), rng);
+
+		list_init(&obj_used_list);
+		for (int objnum : objnums) {
+			list_append(&obj_used_list, &Objects[objnum]);
+		}
+
+		std::uniform_int_distribution<int> source(0, NUM_BLAST_OBJECTS - 1);
+
+		for (int i = 0; i < num_blasts; i++) {
+			blast_pos.push_back(Objects[source(rng)].pos);
+			blast_radius.push_back(range(rng));
+		}
+	}
+
+	// What shockwave_move() does with each object once it got past the type checks
+	static bool blast_hits(const vec3d& pos, float range, const object* objp) {
+		return vm_vec_dist(&pos, &objp->pos) - objp->radius <= range;
+	}
+
+	// The hits of every shockwave, each followed by a -1
+	static void walk_blasts(const SCP_vector<vec3d>& blast_pos, const SCP_vector<float>& blast_radius, SCP_vector<int>& hits) {
+		for (size_t blast = 0; blast < blast_pos.size(); blast++) {
+			for (auto objp : list_range(&obj_used_list)) {
+				if (objp->type != OBJ_SHIP && objp->type != OBJ_ASTEROID)
+					continue;
+
+				if (blast_hits(blast_pos[blast], blast_radius[blast], objp)) {
+					hits.push_back(OBJ_INDEX(objp));
+				}
+			}
+			hits.push_back(-1);
+		}
+	}
+
+	static void query_blasts(const SCP_vector<vec3d>& blast_pos, const SCP_vector<float>& blast_radius, SCP_vector<int>& hits) {
+		SCP_vector<int> found;
+
+		for (size_t blast = 0; blast < blast_pos.size(); blast++) {
+			// the grid is rebuilt every frame in the game too
+			if (blast % NUM_BLAST_SHOCKWAVES == 0) {
+				obj_grid_invalidate();
+			}
+
+			obj_grid_query(obj_grid_type::BLAST_TARGETS, &blast_pos[blast], blast_radius[blast], OBJ_GRID_ALL_TEAMS, found);
+
+			for (int objnum : found) {
+				if (blast_hits(blast_pos[blast], blast_radius[blast], &Objects[objnum])) {
+					hits.push_back(objnum);
+				}
+			}
+			hits.push_back(-1);
+		}
+	}
+};
+
+TEST_F(ObjectGridTest, query_matches_list_walk) {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> coord(-TEST_SPACE_SIZE / 2, TEST_SPACE_SIZE / 2);
+	std::uniform_real_distribution<float> range(0.0f, 6000.0f);
+	std::uniform_int_distribution<int> mask(1, 15);
+
+	SCP_vector<int> found;
+	size_t num_found = 0;
+
+	for (int q = 0; q < NUM_TEST_QUERIES; q++) {
+		vec3d pos{ { { coord(rng), coord(rng), coord(rng) } } };
+		float radius = range(rng);
+		int team_mask = mask(rng);
+
+		obj_grid_query(obj_grid_type::SHIPS, &pos, radius, team_mask, found);
+		num_found += found.size();
+
+		// everything in range has to be there, in list order
+		auto next = found.begin();
+		for (auto so : list_range(&Ship_obj_list)) {
+			auto objp = &Objects[so->objnum];
+
+			bool listed = (next != found.end()) && (*next == so->objnum);
+			if (listed) {
+				++next;
+			}
+
+			if (!iff_matches_mask(Ships[objp->instance].team, team_mask)) {
+				ASSERT_FALSE(listed) << "object " << so->objnum << " of another team in query " << q;
+				continue;
+			}
+
+			if (vm_vec_dist(&pos, &objp->pos) - objp->radius * 1.5f < radius) {
+				ASSERT_TRUE(listed) << "object " << so->objnum << " missing from query " << q;
+			}
+		}
+
+		ASSERT_TRUE(next == found.end()) << "query " << q << " is out of list order";
+	}
+
+	// the grid should actually narrow things down
+	ASSERT_LT(num_found, (size_t)NUM_TEST_QUERIES * NUM_TEST_SHIPS / 20);
+}
+
+TEST_F(ObjectGridTest, invalidate_picks_up_new_positions) {
+	auto objp = &Objects[Test_ship_objs[0].objnum];
+	vec3d far_away{ { { 1000000.0f, 0.0f, 0.0f } } };
+
+	SCP_vector<int> found;
+	obj_grid_query(obj_grid_type::SHIPS, &far_away, 100.0f, OBJ_GRID_ALL_TEAMS, found);
+	ASSERT_TRUE(found.empty());
+
+	objp->pos = far_away;
+	obj_grid_invalidate();
+
+	obj_grid_query(obj_grid_type::SHIPS, &far_away, 100.0f, OBJ_GRID_ALL_TEAMS, found);
+	ASSERT_EQ(1, (int)found.size());
+	ASSERT_EQ(Test_ship_objs[0].objnum, found[0]);
+}
+
+TEST_F(ObjectGridTest, blast_targets_match_used_list_walk) {
+	SCP_vector<vec3d> blast_pos;
+	SCP_vector<float> blast_radius;
+	make_blast_field(NUM_BLAST_CHECK_FRAMES * NUM_BLAST_SHOCKWAVES, blast_pos, blast_radius);
+
+	SCP_vector<int> walk_hits, grid_hits;
+	walk_blasts(blast_pos, blast_radius, walk_hits);
+	query_blasts(blast_pos, blast_radius, grid_hits);
+
+	// same objects, in the same order
+	ASSERT_EQ(walk_hits, grid_hits);
+
+	// and enough of them for that to mean something, the -1s only separate the shockwaves
+	ASSERT_GT(walk_hits.size(), blast_pos.size() * 3 / 2);
+}
+
+// Not a correctness test, run it with --gtest_also_run_disabled_tests to compare the grid with the list walk
+TEST_F(ObjectGridTest, DISABLED_blast_targets_benchmark) {
+	SCP_vector<vec3d> blast_pos;
+	SCP_vector<float> blast_radius;
+	make_blast_field(NUM_BLAST_FRAMES * NUM_BLAST_SHOCKWAVES, blast_pos, blast_radius);
+
+	SCP_vector<int> walk_hits, grid_hits;
+
+	auto start = std::chrono::steady_clock::now();
+	walk_blasts(blast_pos, blast_radius, walk_hits);
+	auto walk_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	query_blasts(blast_pos, blast_radius, grid_hits);
+	auto grid_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << NUM_BLAST_SHOCKWAVES << " shockwaves x " << NUM_BLAST_OBJECTS << " objects: "
+		<< walk_time * 1000000.0 / NUM_BLAST_FRAMES << " us/frame walking obj_used_list, "
+		<< grid_time * 1000000.0 / NUM_BLAST_FRAMES << " us/frame through the grid" << std::endl;
+}
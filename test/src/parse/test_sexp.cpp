@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+
+#include <globalincs/systemvars.h>
+#include <mission/missiongoals.h>
+#include <parse/parselo.h>
+#include <parse/sexp.h>
+#include <ship/ship.h>
+
+#include "util/FSTestFixture.h"
+
+#include <chrono>
+
+namespace {
+
+// All the formulas of a very large mission
+const int BENCHMARK_NODES = 50000;
+const int BENCHMARK_PASSES = 20;
+
+// Each formula is 27 nodes of plain arithmetic and logic, so evaluating it only walks the tree
+const int NODES_PER_FORMULA = 27;
+const int NUM_FORMULAS = (BENCHMARK_NODES + NODES_PER_FORMULA - 1) / NODES_PER_FORMULA;
+
+// enough for every combination of arguments
+const int NUM_CHECK_FORMULAS = 35;
+
+SCP_string formula_text(int a, int b)
+{
+	SCP_string text;
+	sprintf(text, "( and ( < %d 10 ) ( or ( = %d %d ) ( > ( + %d %d ) 6 ) ) ( not ( = ( * %d 2 ) 4 ) ) )", a, a, b, a, b, a);
+	return text;
+}
+
+bool formula_value(int a, int b)
+{
+	return (a < 10) && ((a == b) || (a + b > 6)) && !(a * 2 == 4);
+}
+
+// "Gone" has left the mission, so distances to it are NaN forever; "Nobody" doesn't exist, so distances to it are NaN
+const char *Program_formulas[] = {
+	"( true )",
+	"( false )",
+	"( and ( true ) ( has-time-elapsed 3 ) )",
+	"( and ( has-time-elapsed 2 ) ( false ) ( has-time-elapsed 1 ) )",
+	"( or ( false ) ( has-time-elapsed 4 ) ( < ( mission-time ) 2 ) )",
+	"( or ( < ( mission-time ) 3 ) ( > ( mission-time-msecs ) 5500 ) )",
+	"( not ( has-time-elapsed 3 ) )",
+	"( not ( not ( false ) ) )",
+	"( and ( < 1 2 3 ) ( >= ( mission-time ) 2 ) ( != ( mission-time ) 5 ) )",
+	"( has-time-elapsed-msecs ( * ( mission-time ) 500 ) )",
+	"( < ( distance \"Nobody\" \"Nobody Else\" ) 100 )",
+	"( not ( = ( distance \"Nobody\" \"Nobody Else\" ) 0 ) )",
+	"( > 10 ( + 1 ( distance \"Nobody\" \"Nobody Else\" ) ) )",
+	"( has-time-elapsed ( distance \"Nobody\" \"Nobody Else\" ) )",
+	"( <= ( distance \"Gone\" \"Nobody\" ) 100 )",
+	"( not ( < ( distance \"Gone\" \"Nobody\" ) 100 ) )",
+	"( or ( has-time-elapsed ( distance \"Gone\" \"Nobody\" ) ) ( has-time-elapsed 4 ) )",
+	"( when ( has-time-elapsed 3 ) ( do-nothing ) )",
+	"( when ( and ( true ) ( < ( mission-time ) 4 ) ) ( do-nothing ) )",
+	"( every-time ( > ( mission-time ) 2 ) ( do-nothing ) )",
+	"( every-time ( or ( false ) ( < ( distance \"Gone\" \"Nobody\" ) 5 ) ) ( do-nothing ) )",
+	"( is-event-true-delay \"First\" 0 )",
+	"( is-event-false-delay \"First\" 0 )",
+	"( is-event-true-msecs-delay \"Second\" 0 )",
+	"( is-event-false-msecs-delay \"Second\" 0 )",
+	"( and ( is-event-incomplete \"First\" ) ( is-event-incomplete \"Second\" ) )",
+	"( or ( is-event-true-delay \"Second\" 0 ) ( is-event-true-delay \"First\" 0 ) )",
+	"( when ( is-event-true-delay \"First\" 0 ) ( do-nothing ) )",
+};
+const int PROGRAM_STEPS = 8;
+
+// Checks that the two copies of a formula left the same value in every node
+void expect_same_node_values(int tree_node, int program_node, const char *formula, int step)
+{
+	if (tree_node < 0 || program_node < 0)
+	{
+		EXPECT_EQ(tree_node < 0, program_node < 0) << formula;
+		return;
+	}
+
+	EXPECT_EQ(Sexp_nodes[tree_node].value, Sexp_nodes[program_node].value)
+		<< formula << " at second " << step << ", node " << Sexp_node_data[tree_node].text;
+
+	expect_same_node_values(CAR(tree_node), CAR(program_node), formula, step);
+	expect_same_node_values(CDR(tree_node), CDR(program_node), formula, step);
+}
+
+}
+
+class SexpTest : public test::FSTestFixture {
+ public:
+	SexpTest() : test::FSTestFixture(INIT_CFILE) {
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		init_sexp();
+	}
+	void TearDown() override {
+		for (int formula : formulas) {
+			free_sexp2(formula);
+		}
+		formulas.clear();
+
+		Mission_goals.clear();
+		Mission_events.clear();
+		Ship_registry.clear();
+		Ship_registry_map.clear();
+		Ship_type_counts.clear();
+		Ship_info.clear();
+		Ship_types.clear();
+		Missiontime = 0;
+
+		sexp_clear_programs();
+		sexp_shutdown();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	int add_formula(const SCP_string& text) {
+		char buf[256];
+		strcpy_s(buf, text.c_str());
+
+		auto old_mp = Mp;
+		Mp = buf;
+		int formula = get_sexp_main();
+		Mp = old_mp;
+
+		formulas.push_back(formula);
+		return formula;
+	}
+
+	// Adds count arithmetic formulas, and returns what each of them should come out as
+	SCP_vector<int> add_arithmetic_formulas(int count) {
+		SCP_vector<int> expected;
+
+		for (int i = 0; i < count; i++) {
+			int a = i % 7, b = i % 5;
+
+			add_formula(formula_text(a, b));
+			expected.push_back(formula_value(a, b) ? SEXP_TRUE : SEXP_FALSE);
+		}
+
+		return expected;
+	}
+
+	SCP_vector<int> formulas;
+};
+
+TEST_F(SexpTest, hot_node_fields_fit_half_a_cache_line) {
+	ASSERT_LE(sizeof(sexp_node), (size_t)32);
+}
+
+TEST_F(SexpTest, programs_match_tree_evaluation) {
+	Ship_registry.emplace_back("Gone");
+	Ship_registry[0].status = ShipStatus::EXITED;
+	Ship_registry_map["Gone"] = 0;
+
+	Mission_events.resize(2);
+	Mission_events[0].name = "First";
+	Mission_events[1].name = "Second";
+
+	// each formula twice, once for eval_sexp() and once compiled into a program
+	SCP_vector<std::pair<int, int>> copies;
+	for (auto formula : Program_formulas) {
+		int tree = add_formula(formula);
+		int program = add_formula(formula);
+		ASSERT_GE(tree, 0) << formula;
+		ASSERT_GE(program, 0) << formula;
+
+		sexp_compile_program(program);
+		copies.emplace_back(tree, program);
+	}
+
+	for (int step = 0; step < PROGRAM_STEPS; step++) {
+		Missiontime = i2f(step) + F1_0 / 2;
+
+		// the first event comes true, and later the second one fails
+		if (step == 3) {
+			Mission_events[0].flags |= MEF_EVENT_IS_DONE;
+			Mission_events[0].result = 1;
+		}
+		if (step == 5) {
+			Mission_events[1].flags |= MEF_EVENT_IS_DONE;
+			Mission_events[1].result = 0;
+		}
+
+		for (size_t i = 0; i < copies.size(); i++) {
+			int tree_result = eval_sexp(copies[i].first);
+			int program_result = eval_sexp_program(copies[i].second);
+
+			EXPECT_EQ(tree_result, program_result) << Program_formulas[i] << " at second " << step;
+			expect_same_node_values(copies[i].first, copies[i].second, Program_formulas[i], step);
+		}
+	}
+}
+
+TEST_F(SexpTest, freeing_part_of_a_formula_only_recompiles_its_program) {
+	int changed = add_formula("( and ( true ) ( false ) ( true ) )");
+	int kept = add_formula("( or ( false ) ( true ) )");
+	int changed_tree = add_formula("( and ( true ) ( true ) )");
+	int kept_tree = add_formula("( or ( false ) ( true ) )");
+
+	sexp_compile_program(changed);
+	sexp_compile_program(kept);
+	ASSERT_TRUE(Sexp_nodes[CDR(changed)].flags & SNF_IN_SEXP_PROGRAM);
+	ASSERT_TRUE(Sexp_nodes[CDR(kept)].flags & SNF_IN_SEXP_PROGRAM);
+
+	// drop the ( false ) from the middle of the first formula
+	free_sexp(CDDR(changed), CDR(changed));
+
+	EXPECT_FALSE(Sexp_nodes[CDR(changed)].flags & SNF_IN_SEXP_PROGRAM);
+	EXPECT_TRUE(Sexp_nodes[CDR(kept)].flags & SNF_IN_SEXP_PROGRAM);
+
+	EXPECT_EQ(eval_sexp(changed_tree), eval_sexp_program(changed));
+	EXPECT_EQ(eval_sexp(kept_tree), eval_sexp_program(kept));
+
+	// running it compiled it again
+	EXPECT_TRUE(Sexp_nodes[CDR(changed)].flags & SNF_IN_SEXP_PROGRAM);
+}
+
+TEST_F(SexpTest, unchanged_goal_is_skipped_until_its_state_changes) {
+	Ship_types.emplace_back();
+	strcpy_s(Ship_types[0].name, "fighter");
+	Ship_info.emplace_back();
+	Ship_info[0].class_type = 0;
+
+	ship_clear_ship_type_counts();
+	ship_add_ship_type_count(0, 4);
+
+	mission_goal goal;
+	goal.formula = add_formula("( ship-type-destroyed 50 \"fighter\" )");
+	ASSERT_GE(goal.formula, 0);
+	goal.dependencies = sexp_get_dependencies(goal.formula);
+	ASSERT_EQ(SEXP_DEP_MISSION_LOG, goal.dependencies);
+	Mission_goals.push_back(goal);
+
+	// runs one goal tick, and returns whether it evaluated the goal
+	auto goal_evaluated = []() {
+		Sexp_nodes[Mission_goals[0].formula].value = SEXP_UNKNOWN;
+		Mission_goal_timestamp = TIMESTAMP::immediate();
+		mission_eval_goals();
+		return Sexp_nodes[Mission_goals[0].formula].value != SEXP_UNKNOWN;
+	};
+
+	ASSERT_TRUE(goal_evaluated());
+	ASSERT_FALSE(goal_evaluated());
+
+	// state the goal doesn't read
+	sexp_dependencies_changed(SEXP_DEP_VARIABLES | SEXP_DEP_GOALS_AND_EVENTS);
+	ASSERT_FALSE(goal_evaluated());
+
+	// more fighters arriving changes the counts the goal reads
+	ship_add_ship_type_count(0, 2);
+	ASSERT_TRUE(goal_evaluated());
+	ASSERT_FALSE(goal_evaluated());
+
+	// as does anything else that changes the mission log generation, such as a ship changing class
+	sexp_dependencies_changed(SEXP_DEP_MISSION_LOG);
+	ASSERT_TRUE(goal_evaluated());
+	ASSERT_EQ(GOAL_INCOMPLETE, Mission_goals[0].satisfied);
+}
+
+TEST_F(SexpTest, arithmetic_programs_give_expected_values) {
+	auto expected = add_arithmetic_formulas(NUM_CHECK_FORMULAS);
+
+	for (int i = 0; i < NUM_CHECK_FORMULAS; i++) {
+		ASSERT_GE(formulas[i], 0);
+		ASSERT_EQ(expected[i], eval_sexp(formulas[i])) << formula_text(i % 7, i % 5);
+	}
+
+	for (int formula : formulas) {
+		sexp_compile_program(formula);
+	}
+
+	// twice, so that the second pass runs over values left by the first
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < NUM_CHECK_FORMULAS; i++) {
+			ASSERT_EQ(expected[i], eval_sexp_program(formulas[i])) << formula_text(i % 7, i % 5);
+		}
+	}
+}
+
+TEST_F(SexpTest, DISABLED_eval_throughput) {
+	auto expected = add_arithmetic_formulas(NUM_FORMULAS);
+
+	ASSERT_GE(Num_sexp_nodes - count_free_sexp_nodes(), BENCHMARK_NODES);
+
+	auto run_passes = [&](bool programs) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int pass = 0; pass < BENCHMARK_PASSES; pass++) {
+			for (int i = 0; i < NUM_FORMULAS; i++) {
+				int result = programs ? eval_sexp_program(formulas[i]) : eval_sexp(formulas[i]);
+				EXPECT_EQ(expected[i], result) << "formula " << i;
+			}
+		}
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	auto tree_time = run_passes(false);
+
+	for (int formula : formulas) {
+		sexp_compile_program(formula);
+	}
+	auto program_time = run_passes(true);
+
+	double nodes = static_cast<double>(NUM_FORMULAS) * NODES_PER_FORMULA * BENCHMARK_PASSES;
+
+	std::cout << NUM_FORMULAS << " formulas of " << NODES_PER_FORMULA << " nodes: "
+		<< nodes / tree_time << " nodes/sec through eval_sexp, "
+		<< nodes / program_time << " nodes/sec through programs" << std::endl;
+}
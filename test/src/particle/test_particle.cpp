@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "particle/particle.h"
+#include "render/3d.h"
+
+namespace {
+
+class ParticleHandleTest : public ::testing::Test {
+ protected:
+	void TearDown() override {
+		particle::close();
+	}
+
+	static particle::particle make_particle() {
+		particle::particle part{};
+		part.pos = Eye_position;
+		part.velocity = vmd_zero_vector;
+		part.max_life = 1.0f;
+		part.radius = 1.0f;
+		part.bitmap = -1;
+		part.nframes = -1;
+
+		return part;
+	}
+};
+
+}
+
+TEST_F(ParticleHandleTest, reused_slot_expires_old_handle) {
+	auto first = particle::createPersistent(make_particle());
+	auto first_particle = first.lock();
+	ASSERT_NE(first_particle, nullptr);
+
+	particle::kill_all();
+	ASSERT_TRUE(first.expired());
+
+	auto second = particle::createPersistent(make_particle());
+
+	// the slot of the first particle is handed out again, but not to the old handle
+	ASSERT_EQ(second.lock(), first_particle);
+	ASSERT_TRUE(first.expired());
+	ASSERT_FALSE(second.expired());
+}
+
+TEST_F(ParticleHandleTest, kill_all_expires_every_handle) {
+	SCP_vector<particle::WeakParticlePtr> handles;
+
+	for (int i = 0; i < 100; ++i) {
+		handles.push_back(particle::createPersistent(make_particle()));
+		ASSERT_FALSE(handles.back().expired());
+	}
+
+	ASSERT_EQ(particle::get_particle_count(), handles.size());
+
+	particle::kill_all();
+
+	for (const auto& handle : handles) {
+		ASSERT_TRUE(handle.expired());
+	}
+
+	ASSERT_EQ(particle::get_particle_count(), 0u);
+}
@@ -6,6 +6,10 @@ add_file_folder(""
     test_stubs.cpp
 )
 
+add_file_folder("AI"
+    ai/test_aithink.cpp
+)
+
 add_file_folder("Actions"
 )
 
@@ -33,6 +37,10 @@ if (FSO_BUILD_WITH_VULKAN)
 	)
 endif()
 
+add_file_folder("Lighting"
+    lighting/test_lighting.cpp
+)
+
 add_file_folder("Math"
     math/test_vecmat.cpp
 )
@@ -46,12 +54,22 @@ add_file_folder("mod"
 )
 
 add_file_folder("model"
+    model/test_modelcollide.cpp
     model/test_modelread.cpp
 )
 
+add_file_folder("Object"
+    object/test_objectgrid.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
     parse/test_replace.cpp
+    parse/test_sexp.cpp
+)
+
+add_file_folder("Particle"
+    particle/test_particle.cpp
 )
 
 add_file_folder("Pilotfile"
@@ -95,6 +113,7 @@ add_file_folder("Test Util"
 
 add_file_folder("Utils"
     utils/HeapAllocatorTest.cpp
+    utils/test_threading.cpp
 )
 
 add_file_folder("Weapon"
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "cmdline/cmdline.h"
+#include "utils/threading.h"
+
+using namespace threading;
+
+class JobGraphTests : public ::testing::Test {
+ protected:
+	void SetUp() override {
+		// run the jobs on real workers, not inline on this thread
+		old_multithreading = Cmdline_multithreading;
+		Cmdline_multithreading = 5;
+		init_task_pool();
+
+		ASSERT_TRUE(is_threading());
+	}
+	void TearDown() override {
+		shut_down_task_pool();
+		Cmdline_multithreading = old_multithreading;
+	}
+
+	int old_multithreading = 0;
+};
+
+TEST_F(JobGraphTests, dependenciesRunFirst) {
+	job_graph graph;
+	SCP_vector<int> order;
+
+	auto a = graph.add_job([&order]() { order.push_back(0); });
+	auto b = graph.add_job([&order]() { order.push_back(1); });
+	auto c = graph.add_job([&order]() { order.push_back(2); });
+
+	graph.add_dependency(b, a);
+	graph.add_dependency(c, a);
+	graph.add_dependency(c, b);
+
+	run_job_graph(graph);
+
+	ASSERT_EQ((size_t)3, order.size());
+	ASSERT_EQ(0, order[0]);
+	ASSERT_EQ(1, order[1]);
+	ASSERT_EQ(2, order[2]);
+}
+
+TEST_F(JobGraphTests, parallelForCoversRange) {
+	SCP_vector<int> visited(1000, 0);
+
+	parallel_for(visited.size(), 64, [&visited](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			visited[i]++;
+		}
+	});
+
+	for (auto count : visited) {
+		ASSERT_EQ(1, count);
+	}
+}
+
+TEST_F(JobGraphTests, nestedParallelFor) {
+	SCP_vector<int> visited(16 * 16, 0);
+
+	parallel_for(16, 1, [&visited](size_t outer_begin, size_t outer_end) {
+		for (size_t i = outer_begin; i < outer_end; ++i) {
+			parallel_for(16, 4, [&visited, i](size_t begin, size_t end) {
+				for (size_t j = begin; j < end; ++j) {
+					visited[i * 16 + j]++;
+				}
+			});
+		}
+	});
+
+	for (auto count : visited) {
+		ASSERT_EQ(1, count);
+	}
+}
+
+TEST(JobArenaTests, alignedAllocations) {
+	job_arena arena(256);
+
+	for (int i = 0; i < 100; ++i) {
+		auto mem = arena.allocate(24, 16);
+		ASSERT_EQ((uintptr_t)0, reinterpret_cast<uintptr_t>(mem) % 16);
+	}
+
+	// larger than a block
+	auto big = arena.allocate_array<float>(1024);
+	big[1023] = 1.0f;
+	ASSERT_EQ(0.0f, big[0]);
+
+	arena.reset();
+
+	auto reused = arena.allocate_array<int>(4);
+	ASSERT_EQ(0, reused[3]);
+}